@@ -327,6 +327,21 @@ if(ADIOS2_USE_SST AND NOT MSVC)
       set(ADIOS2_SST_HAVE_CRAY_DRC TRUE)
     endif()
   endif()
+  if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    include(CheckFunctionExists)
+    include(CMakePushCheckState)
+    CHECK_FUNCTION_EXISTS(shm_open ADIOS2_SST_HAVE_SHM_OPEN)
+    if(NOT ADIOS2_SST_HAVE_SHM_OPEN)
+      cmake_push_check_state()
+      set(CMAKE_REQUIRED_LIBRARIES rt)
+      CHECK_FUNCTION_EXISTS(shm_open ADIOS2_SST_HAVE_SHM_OPEN_RT)
+      cmake_pop_check_state()
+      set(ADIOS2_SST_SHM_NEEDS_RT ${ADIOS2_SST_HAVE_SHM_OPEN_RT})
+    endif()
+    if(ADIOS2_SST_HAVE_SHM_OPEN OR ADIOS2_SST_HAVE_SHM_OPEN_RT)
+      set(ADIOS2_SST_HAVE_SHM TRUE)
+    endif()
+  endif()
 endif()
 
 #SysV IPC
@@ -342,6 +357,57 @@ else()
   set(ADIOS2_HAVE_SysVShMem OFF)
 endif()
 
+# io_uring
+if(ADIOS2_USE_IOUring AND CMAKE_SYSTEM_NAME STREQUAL "Linux")
+  include(CheckSymbolExists)
+  CHECK_SYMBOL_EXISTS(__NR_io_uring_setup "sys/syscall.h" HAVE_io_uring_setup)
+  CHECK_SYMBOL_EXISTS(IORING_FEAT_SINGLE_MMAP "linux/io_uring.h" HAVE_io_uring_h)
+  if(HAVE_io_uring_setup AND HAVE_io_uring_h)
+    set(ADIOS2_HAVE_IOUring ON)
+  endif()
+endif()
+if(ADIOS2_USE_IOUring AND NOT ADIOS2_USE_IOUring STREQUAL AUTO AND
+   NOT ADIOS2_HAVE_IOUring)
+  message(FATAL_ERROR "io_uring is not available on this system.")
+endif()
+
+# SIMD kernels, written with the GCC/Clang vector extensions, and the x86
+# instruction sets selected at run time
+if(ADIOS2_USE_SIMD)
+  include(CheckCXXSourceCompiles)
+  check_cxx_source_compiles("
+template <class T>
+T Min(const T *values)
+{
+  typedef T Vector __attribute__((vector_size(16)));
+  Vector a, b;
+  __builtin_memcpy(&a, values, sizeof(Vector));
+  __builtin_memcpy(&b, values + 16 / sizeof(T), sizeof(Vector));
+  a = b < a ? b : a;
+  return a[0];
+}
+int main() { const float v[8] = {}; return static_cast<int>(Min(v)); }"
+    HAVE_vector_extensions)
+  if(HAVE_vector_extensions)
+    set(ADIOS2_HAVE_SIMD ON)
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i.86)$")
+      include(CheckCXXCompilerFlag)
+      check_cxx_compiler_flag("-mavx2" HAVE_mavx2)
+      check_cxx_compiler_flag("-mavx512f -mavx512bw" HAVE_mavx512)
+      if(HAVE_mavx2)
+        set(ADIOS2_SIMD_AVX2_FLAGS -mavx2)
+      endif()
+      if(HAVE_mavx512)
+        set(ADIOS2_SIMD_AVX512_FLAGS -mavx512f -mavx512bw)
+      endif()
+    endif()
+  endif()
+endif()
+if(ADIOS2_USE_SIMD AND NOT ADIOS2_USE_SIMD STREQUAL AUTO AND
+   NOT ADIOS2_HAVE_SIMD)
+  message(FATAL_ERROR "The compiler does not support vector extensions.")
+endif()
+
 #Profiling
 if(ADIOS2_USE_Profiling STREQUAL AUTO)
   if(BUILD_SHARED_LIBS)
@@ -213,6 +213,16 @@ using Steps = size_t;
 template <class T>
 using Box = std::pair<T, T>;
 
+namespace core
+{
+/** memory address and size of one buffer in a vectored (gather) write */
+struct iovec
+{
+    const void *iov_base;
+    size_t iov_len;
+};
+}
+
 /**
  * TypeInfo
  * used to map from primitive types to stdint-based types
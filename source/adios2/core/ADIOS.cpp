@@ -13,10 +13,12 @@
 #include <algorithm> // std::transform
 #include <fstream>
 #include <ios> //std::ios_base::failure
+#include <thread> //std::thread::hardware_concurrency
 
 #include "adios2/core/IO.h"
 #include "adios2/helper/adiosCommDummy.h"
 #include "adios2/helper/adiosFunctions.h" //InquireKey, BroadcastFile
+#include "adios2/helper/adiosThreadPool.h"
 #include <adios2sys/SystemTools.hxx>
 
 // OPERATORS
@@ -64,6 +66,7 @@ ADIOS::ADIOS(const std::string configFile, helper::Comm comm,
 : m_ConfigFile(configFile), m_HostLanguage(hostLanguage),
   m_Comm(std::move(comm))
 {
+    Params parameters;
     if (!configFile.empty())
     {
         if (!adios2sys::SystemTools::FileExists(configFile))
@@ -73,14 +76,15 @@ ADIOS::ADIOS(const std::string configFile, helper::Comm comm,
         }
         if (helper::EndsWith(configFile, ".xml"))
         {
-            XMLInit(configFile);
+            XMLInit(configFile, parameters);
         }
         else if (helper::EndsWith(configFile, ".yaml") ||
                  helper::EndsWith(configFile, ".yml"))
         {
-            YAMLInit(configFile);
+            YAMLInit(configFile, parameters);
         }
     }
+    InitThreadPool(parameters);
 }
 
 ADIOS::ADIOS(const std::string configFile, const std::string hostLanguage)
@@ -323,14 +327,33 @@ void ADIOS::CheckOperator(const std::string name) const
     }
 }
 
-void ADIOS::XMLInit(const std::string &configFileXML)
+void ADIOS::XMLInit(const std::string &configFileXML, Params &parameters)
 {
-    helper::ParseConfigXML(*this, configFileXML, m_IOs, m_Operators);
+    helper::ParseConfigXML(*this, configFileXML, m_IOs, m_Operators,
+                           parameters);
 }
 
-void ADIOS::YAMLInit(const std::string &configFileYAML)
+void ADIOS::YAMLInit(const std::string &configFileYAML, Params &parameters)
 {
-    helper::ParseConfigYAML(*this, configFileYAML, m_IOs, m_Operators);
+    helper::ParseConfigYAML(*this, configFileYAML, m_IOs, m_Operators,
+                            parameters);
+}
+
+void ADIOS::InitThreadPool(const Params &parameters)
+{
+    // default to one thread per core, engines still decide how many of them
+    // a loop uses with their own Threads parameter
+    unsigned int threads = std::thread::hardware_concurrency();
+    auto itSize = parameters.find("ThreadPoolSize");
+    if (itSize != parameters.end())
+    {
+        threads = helper::StringTo<unsigned int>(
+            itSize->second, " in parameter ThreadPoolSize of config file " +
+                                m_ConfigFile + ", in ADIOS constructor");
+    }
+
+    // the first ADIOS object of the process sizes the pool
+    m_ThreadPool = helper::ThreadPool::Acquire(threads);
 }
 
 } // end namespace core
@@ -25,6 +25,10 @@
 
 namespace adios2
 {
+namespace helper
+{
+class ThreadPool;
+}
 namespace core
 {
 
@@ -172,6 +176,13 @@ private:
     /** XML File to be read containing configuration information */
     const std::string m_ConfigFile;
 
+    /**
+     * process pool used by helper::ParallelFor, shared with other ADIOS
+     * objects, outlives the engines of this object. Sized by the
+     * ThreadPoolSize config file parameter.
+     */
+    std::shared_ptr<helper::ThreadPool> m_ThreadPool;
+
     /**
      * @brief List of IO class objects defined from either ADIOS
      * configuration file (XML) or the DeclareIO function explicitly.
@@ -188,9 +199,11 @@ private:
 
     void CheckOperator(const std::string name) const;
 
-    void XMLInit(const std::string &configFileXML);
+    void XMLInit(const std::string &configFileXML, Params &parameters);
+
+    void YAMLInit(const std::string &configFileYAML, Params &parameters);
 
-    void YAMLInit(const std::string &configFileYAML);
+    void InitThreadPool(const Params &parameters);
 };
 
 } // end namespace core
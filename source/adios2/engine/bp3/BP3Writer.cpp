@@ -118,12 +118,7 @@ void BP3Writer::Flush(const int transportIndex)
 void BP3Writer::Init()
 {
     InitParameters();
-    if (m_BP3Serializer.m_Parameters.NumAggregators <
-        static_cast<unsigned int>(m_BP3Serializer.m_SizeMPI))
-    {
-        m_BP3Serializer.m_Aggregator.Init(
-            m_BP3Serializer.m_Parameters.NumAggregators, m_Comm);
-    }
+    m_BP3Serializer.InitAggregator(m_Name);
     InitTransports();
     InitBPBuffer();
 }
@@ -174,7 +169,7 @@ void BP3Writer::InitTransports()
     // only consumers will interact with transport managers
     std::vector<std::string> bpSubStreamNames;
 
-    if (m_BP3Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP3Serializer.m_Aggregator->m_IsConsumer)
     {
         // Names passed to IO AddTransport option with key "Name"
         const std::vector<std::string> transportsNames =
@@ -191,7 +186,7 @@ void BP3Writer::InitTransports()
                                     m_BP3Serializer.m_Parameters.NodeLocal);
     m_BP3Serializer.m_Profiler.Stop("mkdir");
 
-    if (m_BP3Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP3Serializer.m_Aggregator->m_IsConsumer)
     {
         if (m_BP3Serializer.m_Parameters.AsyncTasks)
         {
@@ -225,7 +220,7 @@ void BP3Writer::InitBPBuffer()
 
 void BP3Writer::DoFlush(const bool isFinal, const int transportIndex)
 {
-    if (m_BP3Serializer.m_Aggregator.m_IsActive)
+    if (m_BP3Serializer.m_Aggregator->m_IsActive)
     {
         AggregateWriteData(isFinal, transportIndex);
     }
@@ -245,7 +240,7 @@ void BP3Writer::DoClose(const int transportIndex)
 
     DoFlush(true, transportIndex);
 
-    if (m_BP3Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP3Serializer.m_Aggregator->m_IsConsumer)
     {
         m_FileDataManager.CloseFiles(transportIndex);
     }
@@ -385,20 +380,20 @@ void BP3Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
     m_BP3Serializer.CloseStream(m_IO, false);
 
     // async?
-    for (int r = 0; r < m_BP3Serializer.m_Aggregator.m_Size; ++r)
+    for (int r = 0; r < m_BP3Serializer.m_Aggregator->ExchangeSteps(); ++r)
     {
         aggregator::MPIAggregator::ExchangeRequests dataRequests =
-            m_BP3Serializer.m_Aggregator.IExchange(m_BP3Serializer.m_Data, r);
+            m_BP3Serializer.m_Aggregator->IExchange(m_BP3Serializer.m_Data, r);
 
         aggregator::MPIAggregator::ExchangeAbsolutePositionRequests
             absolutePositionRequests =
-                m_BP3Serializer.m_Aggregator.IExchangeAbsolutePosition(
+                m_BP3Serializer.m_Aggregator->IExchangeAbsolutePosition(
                     m_BP3Serializer.m_Data, r);
 
-        if (m_BP3Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP3Serializer.m_Aggregator->m_IsConsumer)
         {
             const format::Buffer &bufferSTL =
-                m_BP3Serializer.m_Aggregator.GetConsumerBuffer(
+                m_BP3Serializer.m_Aggregator->GetConsumerBuffer(
                     m_BP3Serializer.m_Data);
 
             m_FileDataManager.WriteFiles(bufferSTL.Data(), bufferSTL.m_Position,
@@ -407,11 +402,11 @@ void BP3Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
             m_FileDataManager.FlushFiles(transportIndex);
         }
 
-        m_BP3Serializer.m_Aggregator.WaitAbsolutePosition(
+        m_BP3Serializer.m_Aggregator->WaitAbsolutePosition(
             absolutePositionRequests, r);
 
-        m_BP3Serializer.m_Aggregator.Wait(dataRequests, r);
-        m_BP3Serializer.m_Aggregator.SwapBuffers(r);
+        m_BP3Serializer.m_Aggregator->Wait(dataRequests, r);
+        m_BP3Serializer.m_Aggregator->SwapBuffers(r);
     }
 
     m_BP3Serializer.UpdateOffsetsInMetadata();
@@ -422,9 +417,9 @@ void BP3Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
         m_BP3Serializer.ResetBuffer(bufferSTL, false, false);
 
         m_BP3Serializer.AggregateCollectiveMetadata(
-            m_BP3Serializer.m_Aggregator.m_Comm, bufferSTL, false);
+            m_BP3Serializer.m_Aggregator->m_Comm, bufferSTL, false);
 
-        if (m_BP3Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP3Serializer.m_Aggregator->m_IsConsumer)
         {
             m_FileDataManager.WriteFiles(bufferSTL.m_Buffer.data(),
                                          bufferSTL.m_Position, transportIndex);
@@ -432,10 +427,10 @@ void BP3Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
             m_FileDataManager.FlushFiles(transportIndex);
         }
 
-        m_BP3Serializer.m_Aggregator.Close();
+        m_BP3Serializer.m_Aggregator->Close();
     }
 
-    m_BP3Serializer.m_Aggregator.ResetBuffers();
+    m_BP3Serializer.m_Aggregator->ResetBuffers();
 }
 
 #define declare_type(T, L)                                                     \
@@ -13,8 +13,10 @@
 
 #include "adios2/toolkit/profiling/taustubs/tautimer.hpp"
 
+#include <algorithm> //std::sort
 #include <chrono>
 #include <errno.h>
+#include <future> //std::async
 
 namespace adios2
 {
@@ -27,7 +29,8 @@ BP4Reader::BP4Reader(IO &io, const std::string &name, const Mode mode,
                      helper::Comm comm)
 : Engine("BP4Reader", io, name, mode, std::move(comm)),
   m_BP4Deserializer(m_Comm), m_MDFileManager(m_Comm), m_DataFileManager(m_Comm),
-  m_MDIndexFileManager(m_Comm), m_ActiveFlagFileManager(m_Comm)
+  m_MDIndexFileManager(m_Comm), m_ActiveFlagFileManager(m_Comm),
+  m_PrefetchFileManager(m_Comm)
 {
     TAU_SCOPED_TIMER("BP4Reader::Open");
     Init();
@@ -84,6 +87,15 @@ StepStatus BP4Reader::BeginStep(StepMode mode, const float timeoutSeconds)
             ++m_CurrentStep;
         }
 
+        if (m_BP4Deserializer.m_Parameters.LazyMetadata &&
+            !m_LazyStepsSelected &&
+            m_MDIndexTableAbsolute.count(m_CurrentStep + 1) == 1)
+        {
+            // only the metadata of the current step is kept in memory
+            m_IO.RemoveAllVariables();
+            LoadStepsMetadata({m_CurrentStep + 1});
+        }
+
         m_IO.m_EngineStep = m_CurrentStep;
         m_IO.ResetVariablesStepSelection(false,
                                          "in call to BP4 Reader BeginStep");
@@ -103,6 +115,8 @@ void BP4Reader::EndStep()
 {
     TAU_SCOPED_TIMER("BP4Reader::EndStep");
     PerformGets();
+    StartPrefetch(std::move(m_PrefetchNext));
+    m_PrefetchNext.clear();
 }
 
 void BP4Reader::PerformGets()
@@ -113,6 +127,7 @@ void BP4Reader::PerformGets()
         return;
     }
 
+    std::vector<BlockRead> reads;
     for (const std::string &name : m_BP4Deserializer.m_DeferredVariables)
     {
         const DataType type = m_IO.InquireVariableType(name);
@@ -129,7 +144,33 @@ void BP4Reader::PerformGets()
         {                                                                      \
             m_BP4Deserializer.SetVariableBlockInfo(variable, blockInfo);       \
         }                                                                      \
-        ReadVariableBlocks(variable);                                          \
+        PlanVariableBlocks(variable, reads);                                   \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+
+    // reads of all variables are merged and performed together
+    PerformBlockReads(reads);
+
+    const bool predict = m_IO.m_ReadStreaming &&
+                         m_BP4Deserializer.m_Parameters.PrefetchBufferSize > 0;
+    for (const std::string &name : m_BP4Deserializer.m_DeferredVariables)
+    {
+        const DataType type = m_IO.InquireVariableType(name);
+
+        if (type == DataType::Compound)
+        {
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        Variable<T> &variable =                                                \
+            FindVariable<T>(name, "in call to PerformGets, EndStep or Close"); \
+        if (predict)                                                           \
+        {                                                                      \
+            PredictVariableBlocks(variable, m_PrefetchNext);                   \
+        }                                                                      \
         variable.m_BlocksInfo.clear();                                         \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -139,6 +180,273 @@ void BP4Reader::PerformGets()
     m_BP4Deserializer.m_DeferredVariables.clear();
 }
 
+void BP4Reader::PerformBlockReads(std::vector<BlockRead> &reads)
+{
+    if (reads.empty())
+    {
+        return;
+    }
+
+    WaitPrefetch();
+
+    std::sort(reads.begin(), reads.end(),
+              [](const BlockRead &a, const BlockRead &b) {
+                  return a.SubStreamID < b.SubStreamID ||
+                         (a.SubStreamID == b.SubStreamID &&
+                          a.Offset < b.Offset);
+              });
+
+    // merged reads [begin, end) of reads, and the first merged read of
+    // each data file
+    struct MergedRead
+    {
+        size_t Begin;
+        size_t End;
+        size_t Offset;
+        size_t Size;
+    };
+    std::vector<MergedRead> merged;
+    std::vector<size_t> files;
+
+    const size_t gap = m_BP4Deserializer.m_Parameters.ReadGapSize;
+    for (size_t i = 0; i < reads.size(); ++i)
+    {
+        const BlockRead &read = reads[i];
+        if (!merged.empty() &&
+            reads[merged.back().Begin].SubStreamID == read.SubStreamID)
+        {
+            MergedRead &last = merged.back();
+            const size_t lastEnd = last.Offset + last.Size;
+            const size_t end = std::max(lastEnd, read.Offset + read.Size);
+            if (read.Offset <= lastEnd + gap &&
+                end - last.Offset <= MaxMergedReadSize)
+            {
+                last.End = i + 1;
+                last.Size = end - last.Offset;
+                continue;
+            }
+        }
+        else
+        {
+            files.push_back(merged.size());
+        }
+        merged.push_back({i, i + 1, read.Offset, read.Size});
+    }
+    files.push_back(merged.size());
+
+    // served from the previous step's prefetch if predicted right
+    std::vector<const char *> prefetched(merged.size(), nullptr);
+    if (m_BP4Deserializer.m_Parameters.PrefetchBufferSize > 0)
+    {
+        size_t hits = 0, misses = 0;
+        for (size_t m = 0; m < merged.size(); ++m)
+        {
+            prefetched[m] =
+                FindPrefetched(reads[merged[m].Begin].SubStreamID,
+                               merged[m].Offset, merged[m].Size);
+            (prefetched[m] != nullptr ? hits : misses) += merged[m].Size;
+        }
+
+        if (m_BP4Deserializer.m_Profiler.m_IsActive)
+        {
+            m_BP4Deserializer.m_Profiler.m_Bytes["prefetch_hits"] += hits;
+            m_BP4Deserializer.m_Profiler.m_Bytes["prefetch_misses"] += misses;
+        }
+    }
+
+    const unsigned int clipThreads = m_BP4Deserializer.m_Parameters.Threads;
+
+    // each thread reads whole data files, transports are not thread-safe
+    auto lf_ReadFiles = [&](const size_t firstFile, const size_t stride) {
+        std::vector<char> buffer;
+        for (size_t f = firstFile; f + 1 < files.size(); f += stride)
+        {
+            for (size_t m = files[f]; m < files[f + 1]; ++m)
+            {
+                const MergedRead &mergedRead = merged[m];
+                const size_t subStreamID = reads[mergedRead.Begin].SubStreamID;
+
+                // mapped transports clip straight from the page cache
+                const char *payload =
+                    prefetched[m] != nullptr
+                        ? prefetched[m]
+                        : m_DataFileManager.ViewFile(
+                              mergedRead.Size, mergedRead.Offset, subStreamID);
+                if (payload == nullptr)
+                {
+                    buffer.resize(mergedRead.Size);
+                    m_DataFileManager.ReadFile(buffer.data(), mergedRead.Size,
+                                               mergedRead.Offset, subStreamID);
+                    payload = buffer.data();
+                }
+
+                // blocks go to distinct user memory, clipped concurrently
+                helper::ParallelFor(
+                    mergedRead.End - mergedRead.Begin, clipThreads,
+                    [&](const size_t, const size_t begin, const size_t end) {
+                        for (size_t r = mergedRead.Begin + begin;
+                             r < mergedRead.Begin + end; ++r)
+                        {
+                            reads[r].Clip(payload + reads[r].Offset -
+                                          mergedRead.Offset);
+                        }
+                    });
+            }
+        }
+    };
+
+    const size_t threads = std::max(
+        std::min(static_cast<size_t>(m_BP4Deserializer.m_Parameters.Threads),
+                 files.size() - 1),
+        static_cast<size_t>(1));
+
+    std::vector<std::future<void>> asyncs;
+    asyncs.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t)
+    {
+        asyncs.push_back(std::async(std::launch::async, lf_ReadFiles, t,
+                                    threads));
+    }
+    lf_ReadFiles(0, threads);
+
+    for (auto &async : asyncs)
+    {
+        async.get();
+    }
+}
+
+void BP4Reader::StartPrefetch(std::vector<PrefetchRange> ranges)
+{
+    WaitPrefetch();
+    m_PrefetchRanges.clear();
+    if (ranges.empty())
+    {
+        return;
+    }
+
+    std::sort(ranges.begin(), ranges.end(),
+              [](const PrefetchRange &a, const PrefetchRange &b) {
+                  return a.SubStreamID < b.SubStreamID ||
+                         (a.SubStreamID == b.SubStreamID &&
+                          a.Offset < b.Offset);
+              });
+
+    // merge like PerformBlockReads so that its merged reads fall inside
+    const size_t gap = m_BP4Deserializer.m_Parameters.ReadGapSize;
+    size_t bufferSize = 0;
+    for (PrefetchRange &range : ranges)
+    {
+        if (!m_PrefetchRanges.empty())
+        {
+            PrefetchRange &last = m_PrefetchRanges.back();
+            const size_t lastEnd = last.Offset + last.Size;
+            const size_t end = std::max(lastEnd, range.Offset + range.Size);
+            if (last.SubStreamID == range.SubStreamID &&
+                range.Offset <= lastEnd + gap &&
+                end - last.Offset <= MaxMergedReadSize)
+            {
+                if (bufferSize + end - lastEnd >
+                    m_BP4Deserializer.m_Parameters.PrefetchBufferSize)
+                {
+                    break;
+                }
+                bufferSize += end - lastEnd;
+                last.Size = end - last.Offset;
+                continue;
+            }
+        }
+
+        if (bufferSize + range.Size >
+            m_BP4Deserializer.m_Parameters.PrefetchBufferSize)
+        {
+            break;
+        }
+        bufferSize += range.Size;
+        m_PrefetchRanges.push_back(std::move(range));
+    }
+
+    // data files not opened yet by the prefetch thread
+    std::map<size_t, std::string> subFileNames;
+    for (const PrefetchRange &range : m_PrefetchRanges)
+    {
+        if (m_PrefetchFileManager.m_Transports.count(range.SubStreamID) == 0)
+        {
+            subFileNames[range.SubStreamID] =
+                m_BP4Deserializer.GetBPSubFileName(
+                    m_Name, range.SubStreamID,
+                    m_BP4Deserializer.m_Minifooter.HasSubFiles, true);
+        }
+    }
+
+    auto lf_Prefetch = [this](const std::map<size_t, std::string> names) {
+        for (const auto &name : names)
+        {
+            try
+            {
+                m_PrefetchFileManager.OpenFileID(
+                    name.second, name.first, Mode::Read,
+                    m_IO.m_TransportsParameters.front(), false);
+            }
+            catch (std::exception &)
+            {
+                // its ranges fail to read below
+            }
+        }
+
+        for (PrefetchRange &range : m_PrefetchRanges)
+        {
+            try
+            {
+                range.Data.resize(range.Size);
+                m_PrefetchFileManager.ReadFile(range.Data.data(), range.Size,
+                                               range.Offset, range.SubStreamID);
+            }
+            catch (std::exception &)
+            {
+                // a wrong prediction is only a miss
+                range.Data.clear();
+            }
+        }
+    };
+
+    m_PrefetchFuture =
+        std::async(std::launch::async, lf_Prefetch, std::move(subFileNames));
+}
+
+void BP4Reader::WaitPrefetch()
+{
+    if (m_PrefetchFuture.valid())
+    {
+        m_PrefetchFuture.get();
+    }
+}
+
+const char *BP4Reader::FindPrefetched(const size_t subStreamID,
+                                      const size_t offset,
+                                      const size_t size) const noexcept
+{
+    auto itRange = std::upper_bound(
+        m_PrefetchRanges.begin(), m_PrefetchRanges.end(),
+        std::make_pair(subStreamID, offset),
+        [](const std::pair<size_t, size_t> &key, const PrefetchRange &range) {
+            return key.first < range.SubStreamID ||
+                   (key.first == range.SubStreamID &&
+                    key.second < range.Offset);
+        });
+    if (itRange == m_PrefetchRanges.begin())
+    {
+        return nullptr;
+    }
+
+    const PrefetchRange &range = *std::prev(itRange);
+    if (range.SubStreamID != subStreamID || range.Data.empty() ||
+        offset + size > range.Offset + range.Size)
+    {
+        return nullptr;
+    }
+    return range.Data.data() + offset - range.Offset;
+}
+
 // PRIVATE
 void BP4Reader::Init()
 {
@@ -171,7 +479,14 @@ void BP4Reader::Init()
     if (!m_BP4Deserializer.m_Parameters.StreamReader)
     {
         /* non-stream reader gets as much steps as available now */
-        InitBuffer(timeoutInstant, pollSeconds / 10, timeoutSeconds);
+        if (m_BP4Deserializer.m_Parameters.LazyMetadata)
+        {
+            InitBufferLazy(timeoutInstant, pollSeconds / 10, timeoutSeconds);
+        }
+        else
+        {
+            InitBuffer(timeoutInstant, pollSeconds / 10, timeoutSeconds);
+        }
     }
 }
 
@@ -504,6 +819,161 @@ void BP4Reader::InitBuffer(const TimePoint &timeoutInstant,
     }
 }
 
+void BP4Reader::InitBufferLazy(const TimePoint &timeoutInstant,
+                               const Seconds &pollSeconds,
+                               const Seconds &timeoutSeconds)
+{
+    // newIdxSize, expected metadata file size
+    std::vector<size_t> sizes(2, 0);
+    if (m_BP4Deserializer.m_RankMPI == 0)
+    {
+        /* Read metadata index table into memory */
+        const size_t metadataIndexFileSize =
+            m_MDIndexFileManager.GetFileSize(0);
+        if (metadataIndexFileSize > 0)
+        {
+            m_BP4Deserializer.m_MetadataIndex.Resize(
+                metadataIndexFileSize, "allocating metadata index buffer, "
+                                       "in call to BPFileReader Open");
+            m_MDIndexFileManager.ReadFile(
+                m_BP4Deserializer.m_MetadataIndex.m_Buffer.data(),
+                metadataIndexFileSize);
+
+            /* Metadata is read per step later, but first make sure
+             * the metadata file has the content that the index table refers
+             * to */
+            const uint64_t expectedMinFileSize =
+                MetadataExpectedMinFileSize(m_BP4Deserializer, m_Name, true);
+            size_t fileSize = 0;
+            do
+            {
+                fileSize = m_MDFileManager.GetFileSize(0);
+                if (fileSize >= expectedMinFileSize)
+                {
+                    break;
+                }
+            } while (SleepOrQuit(timeoutInstant, pollSeconds));
+
+            if (fileSize < expectedMinFileSize)
+            {
+                throw std::ios_base::failure(
+                    "ERROR: File " + m_Name +
+                    " was found with an index file but md.0 "
+                    "has not contained enough data within "
+                    "the specified timeout of " +
+                    std::to_string(timeoutSeconds.count()) +
+                    " seconds. index size = " +
+                    std::to_string(metadataIndexFileSize) +
+                    " metadata size = " + std::to_string(fileSize) +
+                    " expected size = " + std::to_string(expectedMinFileSize));
+            }
+
+            m_MDIndexFileAlreadyReadSize = metadataIndexFileSize;
+            sizes[0] = metadataIndexFileSize;
+            sizes[1] = expectedMinFileSize;
+        }
+    }
+
+    m_Comm.BroadcastVector(sizes, 0);
+
+    /* Steps found later in streaming mode are read after the steps in the
+     * index table read now */
+    m_MDFileAlreadyReadSize = sizes[1];
+    m_MDFileProcessedSize = sizes[1];
+    m_MDFileAbsolutePos = sizes[1];
+
+    if (sizes[0] == 0)
+    {
+        return;
+    }
+
+    // broadcast metadata index buffer to all ranks from zero
+    m_Comm.BroadcastVector(m_BP4Deserializer.m_MetadataIndex.m_Buffer);
+
+    /* Parse metadata index table, positions are absolute in metadata file */
+    m_BP4Deserializer.ParseMetadataIndex(m_BP4Deserializer.m_MetadataIndex, 0,
+                                         true, false);
+    m_IdxHeaderParsed = true;
+
+    m_MDIndexTableAbsolute = m_BP4Deserializer.m_MetadataIndexTable[0];
+    const size_t stepsCount = m_MDIndexTableAbsolute.size();
+    m_BP4Deserializer.m_MetadataSet.StepsCount = stepsCount;
+    m_BP4Deserializer.m_MetadataSet.CurrentStep = stepsCount - 1;
+
+    std::vector<size_t> steps;
+    for (const size_t step : m_BP4Deserializer.GetSelectedSteps(*this))
+    {
+        if (step < stepsCount)
+        {
+            steps.push_back(step + 1);
+        }
+    }
+
+    if (!steps.empty())
+    {
+        std::sort(steps.begin(), steps.end());
+        m_LazyStepsSelected = true;
+        LoadStepsMetadata(steps);
+    }
+}
+
+void BP4Reader::LoadStepsMetadata(const std::vector<size_t> &steps)
+{
+    format::BufferSTL &metadata = m_BP4Deserializer.m_Metadata;
+
+    /* The metadata of a step is contiguous in the metadata file, from the
+     * start of its PG index to the end of its attributes index */
+    size_t metadataSize = 0;
+    for (const size_t step : steps)
+    {
+        const std::vector<uint64_t> &ptrs = m_MDIndexTableAbsolute.at(step);
+        metadataSize += static_cast<size_t>(ptrs[3] - ptrs[0]);
+    }
+
+    metadata.Reset(true, false);
+    metadata.Resize(metadataSize, "allocating metadata buffer for " +
+                                      std::to_string(steps.size()) +
+                                      " steps, in call to BP4Reader");
+
+    if (m_BP4Deserializer.m_RankMPI == 0)
+    {
+        size_t offset = 0;
+        for (const size_t step : steps)
+        {
+            const std::vector<uint64_t> &ptrs = m_MDIndexTableAbsolute.at(step);
+            const size_t stepSize = static_cast<size_t>(ptrs[3] - ptrs[0]);
+            if (stepSize > 0)
+            {
+                m_MDFileManager.ReadFile(metadata.m_Buffer.data() + offset,
+                                         stepSize,
+                                         static_cast<size_t>(ptrs[0]));
+            }
+            offset += stepSize;
+        }
+    }
+
+    // broadcast buffer to all ranks from zero
+    m_Comm.BroadcastVector(metadata.m_Buffer);
+
+    /* point index table entries of the loaded steps into the buffer */
+    auto &indexTable = m_BP4Deserializer.m_MetadataIndexTable[0];
+    size_t offset = 0;
+    for (const size_t step : steps)
+    {
+        const std::vector<uint64_t> &ptrs = m_MDIndexTableAbsolute.at(step);
+        std::vector<uint64_t> &relative = indexTable[step];
+        relative = ptrs;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            relative[i] = ptrs[i] - ptrs[0] + offset;
+        }
+        offset += static_cast<size_t>(ptrs[3] - ptrs[0]);
+    }
+
+    // fills IO with Variables and Attributes of the loaded steps
+    m_BP4Deserializer.ParseMetadataSteps(metadata, *this, steps);
+}
+
 size_t BP4Reader::UpdateBuffer(const TimePoint &timeoutInstant,
                                const Seconds &pollSeconds)
 {
@@ -761,6 +1231,10 @@ void BP4Reader::DoClose(const int transportIndex)
 {
     TAU_SCOPED_TIMER("BP4Reader::Close");
     PerformGets();
+    WaitPrefetch();
+    m_PrefetchNext.clear();
+    m_PrefetchRanges.clear();
+    m_PrefetchFileManager.CloseFiles();
     m_DataFileManager.CloseFiles();
     m_MDFileManager.CloseFiles();
 }
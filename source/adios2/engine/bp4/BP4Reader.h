@@ -18,6 +18,9 @@
 #include "adios2/toolkit/transportman/TransportMan.h"
 
 #include <chrono>
+#include <functional>
+#include <future>
+#include <unordered_map>
 
 namespace adios2
 {
@@ -86,11 +89,21 @@ private:
     transportman::TransportMan m_ActiveFlagFileManager;
     bool m_WriterIsActive = true;
 
+    /* PrefetchBufferSize: data files opened by the prefetch thread only */
+    transportman::TransportMan m_PrefetchFileManager;
+
     /** used for per-step reads, TODO: to be moved to BP4Deserializer */
     size_t m_CurrentStep = 0;
     bool m_FirstStep = true;
     bool m_IdxHeaderParsed = false; // true after first index parsing
 
+    /* LazyMetadata: absolute positions in the metadata file from the index
+     * table read in Open, key: step starting from 1 */
+    std::unordered_map<uint64_t, std::vector<uint64_t>> m_MDIndexTableAbsolute;
+    /* LazyMetadata: true if steps were selected at Open, BeginStep then does
+     * not replace their metadata */
+    bool m_LazyStepsSelected = false;
+
     void Init();
     void InitTransports();
 
@@ -118,6 +131,18 @@ private:
     void InitBuffer(const TimePoint &timeoutInstant, const Seconds &pollSeconds,
                     const Seconds &timeoutSeconds);
 
+    /** LazyMetadata: reads the metadata index table only, and the metadata of
+     * the selected steps if any */
+    void InitBufferLazy(const TimePoint &timeoutInstant,
+                        const Seconds &pollSeconds,
+                        const Seconds &timeoutSeconds);
+
+    /** LazyMetadata: reads the metadata of the given steps from the metadata
+     * file into the metadata buffer (replacing its contents) and parses it.
+     *  @param steps: steps starting from 1, in increasing order
+     */
+    void LoadStepsMetadata(const std::vector<size_t> &steps);
+
     /** Read in more metadata if exist (throwing away old).
      *  For streaming only.
      *  @return size of new content from Index Table
@@ -165,9 +190,83 @@ private:
     template <class T>
     void GetDeferredCommon(Variable<T> &variable, T *data);
 
+    /** payload of a block in a data file, clipped into user memory */
+    struct BlockRead
+    {
+        size_t SubStreamID;
+        size_t Offset;
+        size_t Size;
+        /** clips the payload into the user memory of the block */
+        std::function<void(const char *)> Clip;
+    };
+
+    /** merged reads are not grown beyond this size, bounds the memory of
+     * the read buffers */
+    static constexpr size_t MaxMergedReadSize = 64 * 1024 * 1024;
+
+    /** range of a data file read ahead for the next step */
+    struct PrefetchRange
+    {
+        size_t SubStreamID;
+        size_t Offset;
+        size_t Size;
+        /** filled by the prefetch thread, empty if the read failed */
+        std::vector<char> Data;
+    };
+
+    /** ranges predicted for the next step by the PerformGets of this step,
+     * prefetched at EndStep */
+    std::vector<PrefetchRange> m_PrefetchNext;
+    /** ranges of the current step, sorted by data file and offset, owned by
+     * the prefetch thread until WaitPrefetch */
+    std::vector<PrefetchRange> m_PrefetchRanges;
+    /** declared last, its destructor waits for the prefetch thread */
+    std::future<void> m_PrefetchFuture;
+
     template <class T>
     void ReadVariableBlocks(Variable<T> &variable);
 
+    /**
+     * Opens the data files of the blocks in variable.m_BlocksInfo and adds
+     * their reads to reads. Blocks with operations are read and decoded here.
+     * @param variable reads refer to its m_BlocksInfo, which must stay
+     * unchanged until PerformBlockReads
+     * @param reads output, appended
+     */
+    template <class T>
+    void PlanVariableBlocks(Variable<T> &variable,
+                            std::vector<BlockRead> &reads);
+
+    /**
+     * Merges reads of the same data file separated by at most ReadGapSize
+     * bytes and performs them. With Threads > 1 data files are read in
+     * parallel, each by one thread, and blocks are clipped while other
+     * threads read. The blocks of a merged read are clipped in parallel.
+     * @param reads sorted by data file and offset on return
+     */
+    void PerformBlockReads(std::vector<BlockRead> &reads);
+
+    /**
+     * Predicts the ranges read by the next step with the same selections
+     * in variable.m_BlocksInfo, if its metadata is already in memory
+     * @param ranges output, appended
+     */
+    template <class T>
+    void PredictVariableBlocks(Variable<T> &variable,
+                               std::vector<PrefetchRange> &ranges);
+
+    /** merges ranges up to PrefetchBufferSize and reads them in a
+     * background thread, replacing the previous step's cache */
+    void StartPrefetch(std::vector<PrefetchRange> ranges);
+
+    /** waits for the prefetch thread, m_PrefetchRanges is ready after */
+    void WaitPrefetch();
+
+    /** @return pointer to prefetched [offset, offset + size) of a data file,
+     * nullptr if not prefetched */
+    const char *FindPrefetched(const size_t subStreamID, const size_t offset,
+                               const size_t size) const noexcept;
+
 #define declare_type(T)                                                        \
     std::map<size_t, std::vector<typename Variable<T>::BPInfo>>                \
     DoAllStepsBlocksInfo(const Variable<T> &variable) const final;             \
@@ -62,6 +62,15 @@ void BP4Reader::GetDeferredCommon(Variable<T> &variable, T *data)
 
 template <class T>
 void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
+{
+    std::vector<BlockRead> reads;
+    PlanVariableBlocks(variable, reads);
+    PerformBlockReads(reads);
+}
+
+template <class T>
+void BP4Reader::PlanVariableBlocks(Variable<T> &variable,
+                                   std::vector<BlockRead> &reads)
 {
     const bool profile = m_BP4Deserializer.m_Profiler.m_IsActive;
 
@@ -90,9 +99,28 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
 
                     m_DataFileManager.OpenFileID(
                         subFileName, subStreamBoxInfo.SubStreamID, Mode::Read,
-                        {{"transport", "File"}}, profile);
+                        m_IO.m_TransportsParameters.front(), profile);
                 }
 
+                if (subStreamBoxInfo.OperationsInfo.empty())
+                {
+                    // clipped later, blockInfo.Data moves with the step
+                    T *data = blockInfo.Data;
+                    reads.push_back(
+                        {subStreamBoxInfo.SubStreamID,
+                         subStreamBoxInfo.Seeks.first,
+                         subStreamBoxInfo.Seeks.second -
+                             subStreamBoxInfo.Seeks.first,
+                         [this, &variable, &blockInfo, &subStreamBoxInfo,
+                          data](const char *payload) {
+                             m_BP4Deserializer.ClipBlock(variable, blockInfo,
+                                                         subStreamBoxInfo, data,
+                                                         payload);
+                         }});
+                    continue;
+                }
+
+                // operations decode in the deserializer's thread buffers
                 char *buffer = nullptr;
                 size_t payloadSize = 0, payloadStart = 0;
 
@@ -100,12 +128,23 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
                                               subStreamBoxInfo, buffer,
                                               payloadSize, payloadStart, 0);
 
-                m_DataFileManager.ReadFile(buffer, payloadSize, payloadStart,
-                                           subStreamBoxInfo.SubStreamID);
+                // identity operations read straight into user memory
+                const char *payload =
+                    buffer == reinterpret_cast<char *>(blockInfo.Data)
+                        ? nullptr
+                        : m_DataFileManager.ViewFile(
+                              payloadSize, payloadStart,
+                              subStreamBoxInfo.SubStreamID);
+                if (payload == nullptr)
+                {
+                    m_DataFileManager.ReadFile(buffer, payloadSize,
+                                               payloadStart,
+                                               subStreamBoxInfo.SubStreamID);
+                }
 
                 m_BP4Deserializer.PostDataRead(
                     variable, blockInfo, subStreamBoxInfo,
-                    helper::IsRowMajor(m_IO.m_HostLanguage), 0);
+                    helper::IsRowMajor(m_IO.m_HostLanguage), 0, payload);
             } // substreams loop
             // advance pointer to next step
             blockInfo.Data += helper::GetTotalSize(blockInfo.Count);
@@ -114,6 +153,66 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
     } // deferred blocks loop
 }
 
+template <class T>
+void BP4Reader::PredictVariableBlocks(Variable<T> &variable,
+                                      std::vector<PrefetchRange> &ranges)
+{
+    const std::map<size_t, std::vector<size_t>> &indices =
+        variable.m_AvailableStepBlockIndexOffsets;
+
+    for (const typename Variable<T>::BPInfo &blockInfo : variable.m_BlocksInfo)
+    {
+        // next step must be in the metadata read so far
+        const size_t nextStep = blockInfo.StepsStart + blockInfo.StepsCount;
+        if (nextStep >= indices.size())
+        {
+            continue;
+        }
+
+        if (variable.m_ShapeID == ShapeID::LocalArray &&
+            blockInfo.BlockID >=
+                std::next(indices.begin(), nextStep)->second.size())
+        {
+            continue;
+        }
+
+        typename Variable<T>::BPInfo nextBlockInfo = blockInfo;
+        nextBlockInfo.StepBlockSubStreamsInfo.clear();
+        nextBlockInfo.StepsStart = nextStep;
+        nextBlockInfo.StepsCount = 1;
+
+        try
+        {
+            m_BP4Deserializer.SetVariableBlockInfo(variable, nextBlockInfo);
+        }
+        catch (std::invalid_argument &)
+        {
+            // selection no longer valid, Get will report it next step
+            continue;
+        }
+
+        for (const auto &stepPair : nextBlockInfo.StepBlockSubStreamsInfo)
+        {
+            for (const helper::SubStreamBoxInfo &subStreamBoxInfo :
+                 stepPair.second)
+            {
+                // operations read their payload in PlanVariableBlocks
+                if (subStreamBoxInfo.ZeroBlock ||
+                    !subStreamBoxInfo.OperationsInfo.empty())
+                {
+                    continue;
+                }
+
+                ranges.push_back({subStreamBoxInfo.SubStreamID,
+                                  subStreamBoxInfo.Seeks.first,
+                                  subStreamBoxInfo.Seeks.second -
+                                      subStreamBoxInfo.Seeks.first,
+                                  {}});
+            }
+        }
+    }
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
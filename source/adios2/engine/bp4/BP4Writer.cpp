@@ -17,6 +17,8 @@
 #include "adios2/toolkit/profiling/taustubs/tautimer.hpp"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 
+#include <algorithm> //std::max
+#include <numeric>   //std::accumulate
 #include <ctime>
 #include <iostream>
 
@@ -57,13 +59,61 @@ size_t BP4Writer::CurrentStep() const
 void BP4Writer::PerformPuts()
 {
     TAU_SCOPED_TIMER("BP4Writer::PerformPuts");
+    PerformDeferredPuts(false);
+}
+
+void BP4Writer::EndStep()
+{
+    TAU_SCOPED_TIMER("BP4Writer::EndStep");
+    const size_t flushStepsCount = m_BP4Serializer.m_Parameters.FlushStepsCount;
+    // the step is flushed below, before Put data can be reused
+    const bool isFlushStep = (CurrentStep() + 1) % flushStepsCount == 0;
+
+    if (m_BP4Serializer.m_DeferredVariables.size() > 0)
+    {
+        // aggregators send the data buffer, async writes outlive EndStep
+        const bool zeroCopy =
+            isFlushStep && m_BP4Serializer.m_Parameters.ZeroCopyThreshold > 0 &&
+            !m_AsyncWrite && !m_BP4Serializer.m_Aggregator->m_IsActive;
+        PerformDeferredPuts(zeroCopy);
+    }
+
+    // true: advances step
+    m_BP4Serializer.SerializeData(m_IO, true);
+
+    if (isFlushStep)
+    {
+        Flush();
+    }
+}
+
+void BP4Writer::PerformDeferredPuts(const bool zeroCopy)
+{
     if (m_BP4Serializer.m_DeferredVariables.empty())
     {
         return;
     }
 
-    m_BP4Serializer.ResizeBuffer(m_BP4Serializer.m_DeferredVariablesDataSize,
-                                 "in call to PerformPuts");
+    const size_t dataSize = m_BP4Serializer.m_DeferredVariablesDataSize;
+    const format::BP4Serializer::ResizeResult resizeResult =
+        m_BP4Serializer.ResizeBuffer(dataSize, "in call to PerformPuts");
+
+    if (resizeResult == format::BP4Serializer::ResizeResult::NewChunk)
+    {
+        NewDataChunk();
+        m_BP4Serializer.ResizeBuffer(dataSize, "in call to PerformPuts");
+    }
+    else if (resizeResult == format::BP4Serializer::ResizeResult::Flush &&
+             m_BP4Serializer.m_DataChunkSize > 0)
+    {
+        // chunks are not resized to MaxBufferSize before a flush
+        DoFlush(false);
+        m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Data, false, false);
+        m_BP4Serializer.PutProcessGroupIndex(
+            m_IO.m_Name, m_IO.m_HostLanguage,
+            m_FileDataManager.GetTransportsTypes());
+        m_BP4Serializer.ResizeBuffer(dataSize, "in call to PerformPuts");
+    }
 
     for (const std::string &variableName : m_BP4Serializer.m_DeferredVariables)
     {
@@ -77,7 +127,7 @@ void BP4Writer::PerformPuts()
     {                                                                          \
         Variable<T> &variable = FindVariable<T>(                               \
             variableName, "in call to PerformPuts, EndStep or Close");         \
-        PerformPutCommon(variable);                                            \
+        PerformPutCommon(variable, zeroCopy);                                  \
     }
 
         ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
@@ -87,26 +137,6 @@ void BP4Writer::PerformPuts()
     m_BP4Serializer.m_DeferredVariablesDataSize = 0;
 }
 
-void BP4Writer::EndStep()
-{
-    TAU_SCOPED_TIMER("BP4Writer::EndStep");
-    if (m_BP4Serializer.m_DeferredVariables.size() > 0)
-    {
-        PerformPuts();
-    }
-
-    // true: advances step
-    m_BP4Serializer.SerializeData(m_IO, true);
-
-    const size_t currentStep = CurrentStep();
-    const size_t flushStepsCount = m_BP4Serializer.m_Parameters.FlushStepsCount;
-
-    if (currentStep % flushStepsCount == 0)
-    {
-        Flush();
-    }
-}
-
 void BP4Writer::Flush(const int transportIndex)
 {
     TAU_SCOPED_TIMER("BP4Writer::Flush");
@@ -123,11 +153,28 @@ void BP4Writer::Flush(const int transportIndex)
 void BP4Writer::Init()
 {
     InitParameters();
-    if (m_BP4Serializer.m_Parameters.NumAggregators <
-        static_cast<unsigned int>(m_BP4Serializer.m_SizeMPI))
+    m_BP4Serializer.InitAggregator(m_Name);
+    // aggregated data is written by the aggregators in AggregateWriteData
+    m_AsyncWrite = m_BP4Serializer.m_Parameters.AsyncWrite &&
+                   !m_BP4Serializer.m_Aggregator->m_IsActive;
+    // aggregators exchange a single contiguous data buffer
+    if (!m_BP4Serializer.m_Aggregator->m_IsActive)
+    {
+        m_BP4Serializer.m_DataChunkSize =
+            m_BP4Serializer.m_Parameters.BufferChunkSize;
+    }
+    if (m_AsyncWrite && m_BP4Serializer.m_Profiler.m_IsActive)
     {
-        m_BP4Serializer.m_Aggregator.Init(
-            m_BP4Serializer.m_Parameters.NumAggregators, m_Comm);
+        const TimeUnit timeUnit = m_BP4Serializer.m_Parameters.ProfileUnit;
+        auto &timers = m_BP4Serializer.m_Profiler.m_Timers;
+        // async_write: background writes, async_write_wait: time blocked on
+        // them, async_write_overlap: write time hidden behind computation
+        timers.emplace("async_write",
+                       profiling::Timer("async_write", timeUnit));
+        timers.emplace("async_write_wait",
+                       profiling::Timer("async_write_wait", timeUnit));
+        timers.emplace("async_write_overlap",
+                       profiling::Timer("async_write_overlap", timeUnit));
     }
     InitTransports();
     InitBPBuffer();
@@ -184,7 +231,7 @@ void BP4Writer::InitTransports()
                    PathSeparator + m_Name;
     }
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         // Names passed to IO AddTransport option with key "Name"
         const std::vector<std::string> transportsNames =
@@ -222,7 +269,7 @@ void BP4Writer::InitTransports()
     }
     m_BP4Serializer.m_Profiler.Stop("mkdir");
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         if (m_BP4Serializer.m_Parameters.AsyncTasks)
         {
@@ -251,18 +298,31 @@ void BP4Writer::InitTransports()
             m_FileMetadataManager.GetFilesBaseNames(
                 m_BBName, m_IO.m_TransportsParameters);
 
+        // small metadata writes stay in the page cache
+        std::vector<Params> metadataTransportsParameters =
+            m_IO.m_TransportsParameters;
+        for (auto &parameters : metadataTransportsParameters)
+        {
+            for (auto it = parameters.begin(); it != parameters.end();)
+            {
+                it = helper::LowerCase(it->first) == "directio"
+                         ? parameters.erase(it)
+                         : std::next(it);
+            }
+        }
+
         m_MetadataFileNames =
             m_BP4Serializer.GetBPMetadataFileNames(transportsNames);
 
         m_FileMetadataManager.OpenFiles(m_MetadataFileNames, m_OpenMode,
-                                        m_IO.m_TransportsParameters,
+                                        metadataTransportsParameters,
                                         m_BP4Serializer.m_Profiler.m_IsActive);
 
         m_MetadataIndexFileNames =
             m_BP4Serializer.GetBPMetadataIndexFileNames(transportsNames);
 
         m_FileMetadataIndexManager.OpenFiles(
-            m_MetadataIndexFileNames, m_OpenMode, m_IO.m_TransportsParameters,
+            m_MetadataIndexFileNames, m_OpenMode, metadataTransportsParameters,
             m_BP4Serializer.m_Profiler.m_IsActive);
 
         if (m_DrainBB)
@@ -333,7 +393,7 @@ void BP4Writer::InitBPBuffer()
                 static_cast<uint32_t>(lastStep);
             m_BP4Serializer.m_MetadataSet.CurrentStep += lastStep;
 
-            if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+            if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
             {
                 m_BP4Serializer.m_PreDataFileLength =
                     m_FileDataManager.GetFileSize(0);
@@ -361,7 +421,7 @@ void BP4Writer::InitBPBuffer()
             m_BP4Serializer.MakeHeader(m_BP4Serializer.m_MetadataIndex,
                                        "Index Table", true);
         }
-        if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
         {
             m_BP4Serializer.MakeHeader(m_BP4Serializer.m_Data, "Data", false);
         }
@@ -383,7 +443,7 @@ void BP4Writer::InitBPBuffer()
 
 void BP4Writer::DoFlush(const bool isFinal, const int transportIndex)
 {
-    if (m_BP4Serializer.m_Aggregator.m_IsActive)
+    if (m_BP4Serializer.m_Aggregator->m_IsActive)
     {
         AggregateWriteData(isFinal, transportIndex);
     }
@@ -403,7 +463,16 @@ void BP4Writer::DoClose(const int transportIndex)
 
     DoFlush(true, transportIndex);
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_AsyncWrite && m_BP4Serializer.m_Profiler.m_IsActive)
+    {
+        auto &timers = m_BP4Serializer.m_Profiler.m_Timers;
+        const int64_t overlap = timers.at("async_write").m_ProcessTime -
+                                timers.at("async_write_wait").m_ProcessTime;
+        timers.at("async_write_overlap").m_ProcessTime =
+            std::max(overlap, static_cast<int64_t>(0));
+    }
+
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         m_FileDataManager.CloseFiles(transportIndex);
         // Delete files from temporary storage if draining was on
@@ -428,9 +497,9 @@ void BP4Writer::DoClose(const int transportIndex)
         // std::cout << "write profiling file!" << std::endl;
         WriteProfilingJSONFile();
     }
-    if (m_BP4Serializer.m_Aggregator.m_IsActive)
+    if (m_BP4Serializer.m_Aggregator->m_IsActive)
     {
-        m_BP4Serializer.m_Aggregator.Close();
+        m_BP4Serializer.m_Aggregator->Close();
     }
 
     if (m_BP4Serializer.m_RankMPI == 0)
@@ -465,7 +534,7 @@ void BP4Writer::DoClose(const int transportIndex)
         }
     }
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer && m_DrainBB)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer && m_DrainBB)
     {
         /* Signal the BB thread that no more work is coming */
         m_FileDrainer.Finish();
@@ -595,6 +664,12 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
     {
         // If data pg count is zero, it means all metadata
         // has already been written, don't need to write it again.
+        if (m_BP4Serializer.m_RankMPI == 0 && !m_AsyncMetadataIndex.empty())
+        {
+            WriteMetadataIndexFile(m_AsyncMetadataIndex.data(),
+                                   m_AsyncMetadataIndex.size());
+            m_AsyncMetadataIndex.clear();
+        }
         return;
     }
     m_BP4Serializer.AggregateCollectiveMetadata(
@@ -663,24 +738,41 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
                 currentTimeStamp);
         }
 
-        m_FileMetadataIndexManager.WriteFiles(
-            m_BP4Serializer.m_MetadataIndex.m_Buffer.data(),
-            m_BP4Serializer.m_MetadataIndex.m_Position);
-        m_FileMetadataIndexManager.FlushFiles();
+        const char *indexBuffer =
+            m_BP4Serializer.m_MetadataIndex.m_Buffer.data();
+        const size_t indexSize = m_BP4Serializer.m_MetadataIndex.m_Position;
 
-        m_BP4Serializer.m_MetadataSet.MetadataFileLength +=
-            m_BP4Serializer.m_Metadata.m_Position;
-
-        if (m_DrainBB)
+        if (m_AsyncWrite)
         {
-            for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
+            /* Every rank waited for its previous data write before the
+             * metadata aggregation, so the held back steps are complete.
+             * The steps of this flush are published with the next one, as
+             * their data may still be in flight. */
+            const size_t rowsSize = timeSteps.size() * 64;
+            m_AsyncMetadataIndex.insert(m_AsyncMetadataIndex.begin(),
+                                        indexBuffer,
+                                        indexBuffer + indexSize - rowsSize);
+            if (!m_AsyncMetadataIndex.empty())
             {
-                m_FileDrainer.AddOperationWrite(
-                    m_DrainMetadataIndexFileNames[i],
-                    m_BP4Serializer.m_MetadataIndex.m_Position,
-                    m_BP4Serializer.m_MetadataIndex.m_Buffer.data());
+                WriteMetadataIndexFile(m_AsyncMetadataIndex.data(),
+                                       m_AsyncMetadataIndex.size());
             }
+            m_AsyncMetadataIndex.assign(indexBuffer + indexSize - rowsSize,
+                                        indexBuffer + indexSize);
+            if (isFinal)
+            {
+                WriteMetadataIndexFile(m_AsyncMetadataIndex.data(),
+                                       m_AsyncMetadataIndex.size());
+                m_AsyncMetadataIndex.clear();
+            }
+        }
+        else
+        {
+            WriteMetadataIndexFile(indexBuffer, indexSize);
         }
+
+        m_BP4Serializer.m_MetadataSet.MetadataFileLength +=
+            m_BP4Serializer.m_Metadata.m_Position;
     }
     /*Clear the local indices buffer at the end of each step*/
     m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Metadata, true, true);
@@ -708,8 +800,21 @@ void BP4Writer::WriteData(const bool isFinal, const int transportIndex)
         dataSize = m_BP4Serializer.CloseStream(m_IO, false);
     }
 
-    m_FileDataManager.WriteFiles(m_BP4Serializer.m_Data.m_Buffer.data(),
-                                 dataSize, transportIndex);
+    if (m_AsyncWrite && !isFinal)
+    {
+        AsyncWriteData(dataSize, transportIndex);
+        return;
+    }
+    // keep data in order in the files
+    WaitAsyncWriteData();
+
+    dataSize = WriteDataChunks(
+        m_BP4Serializer.m_DataChunks, m_BP4Serializer.m_DataChunksSizes,
+        m_BP4Serializer.m_DataReferences,
+        m_BP4Serializer.m_Data.m_Buffer.data(), dataSize, transportIndex);
+    m_BP4Serializer.RecycleDataChunks(m_BP4Serializer.m_DataChunks,
+                                      m_BP4Serializer.m_DataChunksSizes);
+    m_BP4Serializer.m_DataReferences.clear();
 
     m_FileDataManager.FlushFiles(transportIndex);
     if (m_DrainBB)
@@ -730,20 +835,20 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
     const size_t dataBufferSize = m_BP4Serializer.m_Data.m_Position;
 
     // async?
-    for (int r = 0; r < m_BP4Serializer.m_Aggregator.m_Size; ++r)
+    for (int r = 0; r < m_BP4Serializer.m_Aggregator->ExchangeSteps(); ++r)
     {
         aggregator::MPIAggregator::ExchangeRequests dataRequests =
-            m_BP4Serializer.m_Aggregator.IExchange(m_BP4Serializer.m_Data, r);
+            m_BP4Serializer.m_Aggregator->IExchange(m_BP4Serializer.m_Data, r);
 
         aggregator::MPIAggregator::ExchangeAbsolutePositionRequests
             absolutePositionRequests =
-                m_BP4Serializer.m_Aggregator.IExchangeAbsolutePosition(
+                m_BP4Serializer.m_Aggregator->IExchangeAbsolutePosition(
                     m_BP4Serializer.m_Data, r);
 
-        if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
         {
             const format::Buffer &bufferSTL =
-                m_BP4Serializer.m_Aggregator.GetConsumerBuffer(
+                m_BP4Serializer.m_Aggregator->GetConsumerBuffer(
                     m_BP4Serializer.m_Data);
             if (bufferSTL.m_Position > 0)
             {
@@ -756,11 +861,11 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
             }
         }
 
-        m_BP4Serializer.m_Aggregator.WaitAbsolutePosition(
+        m_BP4Serializer.m_Aggregator->WaitAbsolutePosition(
             absolutePositionRequests, r);
 
-        m_BP4Serializer.m_Aggregator.Wait(dataRequests, r);
-        m_BP4Serializer.m_Aggregator.SwapBuffers(r);
+        m_BP4Serializer.m_Aggregator->Wait(dataRequests, r);
+        m_BP4Serializer.m_Aggregator->SwapBuffers(r);
     }
 
     if (m_DrainBB)
@@ -777,10 +882,10 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
 
     if (isFinal) // Write metadata footer
     {
-        m_BP4Serializer.m_Aggregator.Close();
+        m_BP4Serializer.m_Aggregator->Close();
     }
 
-    m_BP4Serializer.m_Aggregator.ResetBuffers();
+    m_BP4Serializer.m_Aggregator->ResetBuffers();
 
     // Reset Data buffer to its final size on this process at EndStep
     // The aggregation routine has resized it to some incoming process' data
@@ -790,6 +895,129 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
                                       std::to_string(dataBufferSize));
 }
 
+void BP4Writer::AsyncWriteData(const size_t dataSize, const int transportIndex)
+{
+    TAU_SCOPED_TIMER("BP4Writer::AsyncWriteData");
+    // both buffers are busy if the previous write is still running
+    WaitAsyncWriteData();
+
+    format::BufferSTL &data = m_BP4Serializer.m_Data;
+    const size_t bufferSize = data.m_Buffer.size();
+    m_AsyncWriteBuffer.swap(data.m_Buffer);
+    // the spare buffer is only allocated at the first swap
+    data.Resize(bufferSize, "in call to BP4 AsyncWriteData");
+    m_AsyncWriteChunks.swap(m_BP4Serializer.m_DataChunks);
+    m_AsyncWriteChunksSizes.swap(m_BP4Serializer.m_DataChunksSizes);
+    m_AsyncWriteSize =
+        std::accumulate(m_AsyncWriteChunksSizes.begin(),
+                        m_AsyncWriteChunksSizes.end(), dataSize);
+
+    m_AsyncWriteFuture =
+        std::async(std::launch::async, [this, dataSize, transportIndex]() {
+            m_BP4Serializer.m_Profiler.Start("async_write");
+            // payload references are not used with async writes
+            WriteDataChunks(m_AsyncWriteChunks, m_AsyncWriteChunksSizes, {},
+                            m_AsyncWriteBuffer.data(), dataSize,
+                            transportIndex);
+            m_FileDataManager.FlushFiles(transportIndex);
+            m_BP4Serializer.m_Profiler.Stop("async_write");
+        });
+}
+
+void BP4Writer::WaitAsyncWriteData()
+{
+    if (!m_AsyncWriteFuture.valid())
+    {
+        return;
+    }
+
+    TAU_SCOPED_TIMER("BP4Writer::WaitAsyncWriteData");
+    m_BP4Serializer.m_Profiler.Start("async_write_wait");
+    // rethrows exceptions from the background write
+    m_AsyncWriteFuture.get();
+    m_BP4Serializer.m_Profiler.Stop("async_write_wait");
+    m_BP4Serializer.RecycleDataChunks(m_AsyncWriteChunks,
+                                      m_AsyncWriteChunksSizes);
+
+    if (m_DrainBB)
+    {
+        for (size_t i = 0; i < m_SubStreamNames.size(); ++i)
+        {
+            m_FileDrainer.AddOperationCopy(m_SubStreamNames[i],
+                                           m_DrainSubStreamNames[i],
+                                           m_AsyncWriteSize);
+        }
+    }
+}
+
+void BP4Writer::NewDataChunk()
+{
+    const size_t dataSize = m_BP4Serializer.CloseStream(m_IO, false);
+    m_BP4Serializer.RetireDataChunk(dataSize);
+    m_BP4Serializer.PutProcessGroupIndex(
+        m_IO.m_Name, m_IO.m_HostLanguage,
+        m_FileDataManager.GetTransportsTypes());
+}
+
+size_t BP4Writer::WriteDataChunks(
+    const std::vector<std::vector<char>> &chunks,
+    const std::vector<size_t> &chunksSizes,
+    const std::vector<format::BP4Serializer::DataReference> &references,
+    const char *data, const size_t dataSize, const int transportIndex)
+{
+    if (chunks.empty() && references.empty())
+    {
+        m_FileDataManager.WriteFiles(data, dataSize, transportIndex);
+        return dataSize;
+    }
+
+    std::vector<core::iovec> iov;
+    iov.reserve(chunks.size() + 2 * references.size() + 1);
+    size_t totalSize = 0;
+    auto itReference = references.begin();
+
+    // chunk bytes split at the positions of its payload references
+    auto lf_AddChunk = [&](const char *chunk, const size_t size,
+                           const size_t chunkIndex) {
+        size_t position = 0;
+        for (; itReference != references.end() &&
+               itReference->Chunk == chunkIndex;
+             ++itReference)
+        {
+            iov.push_back({chunk + position, itReference->Position - position});
+            iov.push_back({itReference->Data, itReference->Size});
+            totalSize += itReference->Size;
+            position = itReference->Position;
+        }
+        iov.push_back({chunk + position, size - position});
+        totalSize += size;
+    };
+
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+        lf_AddChunk(chunks[c].data(), chunksSizes[c], c);
+    }
+    lf_AddChunk(data, dataSize, chunks.size());
+
+    m_FileDataManager.WriteFiles(iov.data(), iov.size(), transportIndex);
+    return totalSize;
+}
+
+void BP4Writer::WriteMetadataIndexFile(const char *buffer, const size_t size)
+{
+    m_FileMetadataIndexManager.WriteFiles(buffer, size);
+    m_FileMetadataIndexManager.FlushFiles();
+
+    if (m_DrainBB)
+    {
+        for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
+        {
+            m_FileDrainer.AddOperationWrite(m_DrainMetadataIndexFileNames[i],
+                                            size, buffer);
+        }
+    }
+}
+
 #define declare_type(T, L)                                                     \
     T *BP4Writer::DoBufferData_##L(const size_t payloadPosition,               \
                                    const size_t bufferID) noexcept             \
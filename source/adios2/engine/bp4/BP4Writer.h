@@ -18,6 +18,9 @@
 #include "adios2/toolkit/format/bp/bp4/BP4Serializer.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
 
+#include <future>
+#include <vector>
+
 namespace adios2
 {
 namespace core
@@ -88,6 +91,27 @@ private:
     std::vector<std::string> m_DrainMetadataIndexFileNames;
     std::vector<std::string> m_ActiveFlagFileNames;
 
+    /*
+     *  Asynchronous data write variables
+     */
+    /** true if AsyncWrite is set and data is not aggregated */
+    bool m_AsyncWrite = false;
+    /** spare data buffer, swapped with m_BP4Serializer.m_Data at each
+     * flush and written to the data files by m_AsyncWriteFuture */
+    std::vector<char> m_AsyncWriteBuffer;
+    /** bytes of m_AsyncWriteBuffer being written */
+    size_t m_AsyncWriteSize = 0;
+    /** full data chunks written before m_AsyncWriteBuffer (BufferChunkSize)
+     */
+    std::vector<std::vector<char>> m_AsyncWriteChunks;
+    /** bytes used in each of m_AsyncWriteChunks */
+    std::vector<size_t> m_AsyncWriteChunksSizes;
+    /** background write of m_AsyncWriteBuffer, valid while in flight */
+    std::future<void> m_AsyncWriteFuture;
+    /** metadata index table rows of steps whose data may be in flight on
+     * some rank, written by rank 0 with the next collective metadata */
+    std::vector<char> m_AsyncMetadataIndex;
+
     void Init() final;
 
     /** Parses parameters from IO SetParameters */
@@ -115,10 +139,14 @@ private:
     void PutCommon(Variable<T> &variable, typename Variable<T>::Span &span,
                    const size_t bufferID, const T &value);
 
+    /**
+     * @param zeroCopy true: the payload of large blocks is referenced in
+     * application memory and written from there at the next flush
+     */
     template <class T>
     void PutSyncCommon(Variable<T> &variable,
                        const typename Variable<T>::BPInfo &blockInfo,
-                       const bool resize = true);
+                       const bool resize = true, const bool zeroCopy = false);
 
     template <class T>
     void PutDeferredCommon(Variable<T> &variable, const T *data);
@@ -153,6 +181,45 @@ private:
      */
     void AggregateWriteData(const bool isFinal, const int transportIndex = -1);
 
+    /**
+     * Swaps the data buffer with the spare buffer and writes its first
+     * dataSize bytes in a background thread, waits only if the previous
+     * background write is still running
+     * @param dataSize
+     * @param transportIndex
+     */
+    void AsyncWriteData(const size_t dataSize, const int transportIndex = -1);
+
+    /** Waits for the background data write to finish, if any */
+    void WaitAsyncWriteData();
+
+    /**
+     * Closes the process group in the full data buffer chunk and opens a new
+     * one in the next chunk (BufferChunkSize)
+     */
+    void NewDataChunk();
+
+    /**
+     * Writes the used bytes of all chunks followed by the first dataSize
+     * bytes of data, with referenced payloads in between, with a single
+     * vectored write
+     * @param chunks
+     * @param chunksSizes
+     * @param references payloads in application memory (ZeroCopyThreshold)
+     * @param data
+     * @param dataSize
+     * @param transportIndex
+     * @return total number of bytes written
+     */
+    size_t WriteDataChunks(
+        const std::vector<std::vector<char>> &chunks,
+        const std::vector<size_t> &chunksSizes,
+        const std::vector<format::BP4Serializer::DataReference> &references,
+        const char *data, const size_t dataSize, const int transportIndex);
+
+    /** Writes (and drains) a part of the metadata index file, rank 0 only */
+    void WriteMetadataIndexFile(const char *buffer, const size_t size);
+
 #define declare_type(T, L)                                                     \
     T *DoBufferData_##L(const size_t payloadPosition,                          \
                         const size_t bufferID = 0) noexcept final;
@@ -165,7 +232,15 @@ private:
                         const size_t bufferID) noexcept;
 
     template <class T>
-    void PerformPutCommon(Variable<T> &variable);
+    void PerformPutCommon(Variable<T> &variable, const bool zeroCopy);
+
+    /**
+     * Buffers all deferred variables
+     * @param zeroCopy true: deferred payloads of at least ZeroCopyThreshold
+     * bytes are not copied, only if the buffer is flushed before the
+     * application may reuse its memory
+     */
+    void PerformDeferredPuts(const bool zeroCopy);
 };
 
 } // end namespace engine
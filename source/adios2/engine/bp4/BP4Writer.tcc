@@ -51,6 +51,13 @@ void BP4Writer::PutCommon(Variable<T> &variable,
             "buffer reallocation in BP4 engine, remove "
             "MaxBufferSize parameter, in call to Put\n");
     }
+    if (resizeResult == format::BP4Serializer::ResizeResult::NewChunk)
+    {
+        throw std::invalid_argument(
+            "ERROR: returning a Span can't trigger "
+            "a new buffer chunk in BP4 engine, remove "
+            "BufferChunkSize parameter, in call to Put\n");
+    }
 
     // WRITE INDEX to data buffer and metadata structure (in memory)//
     const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
@@ -64,19 +71,26 @@ void BP4Writer::PutCommon(Variable<T> &variable,
 template <class T>
 void BP4Writer::PutSyncCommon(Variable<T> &variable,
                               const typename Variable<T>::BPInfo &blockInfo,
-                              const bool resize)
+                              const bool resize, const bool zeroCopy)
 {
     format::BP4Base::ResizeResult resizeResult =
         format::BP4Base::ResizeResult::Success;
+    size_t dataSize = 0;
     if (resize)
     {
-        const size_t dataSize =
-            helper::PayloadSize(blockInfo.Data, blockInfo.Count) +
-            m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name,
-                                                 blockInfo.Count);
+        dataSize = helper::PayloadSize(blockInfo.Data, blockInfo.Count) +
+                   m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name,
+                                                        blockInfo.Count);
 
         resizeResult = m_BP4Serializer.ResizeBuffer(
             dataSize, "in call to variable " + variable.m_Name + " Put");
+
+        if (resizeResult == format::BP4Base::ResizeResult::NewChunk)
+        {
+            NewDataChunk();
+            resizeResult = m_BP4Serializer.ResizeBuffer(
+                dataSize, "in call to variable " + variable.m_Name + " Put");
+        }
     }
     // if first timestep Write create a new pg index
     if (!m_BP4Serializer.m_MetadataSet.DataPGIsOpen)
@@ -95,12 +109,31 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
         m_BP4Serializer.PutProcessGroupIndex(
             m_IO.m_Name, m_IO.m_HostLanguage,
             m_FileDataManager.GetTransportsTypes());
+
+        // chunks are not resized to MaxBufferSize before a flush
+        if (m_BP4Serializer.m_DataChunkSize > 0)
+        {
+            m_BP4Serializer.ResizeBuffer(dataSize, "in call to variable " +
+                                                       variable.m_Name +
+                                                       " Put");
+        }
     }
 
     // WRITE INDEX to data buffer and metadata structure (in memory)//
     const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
     m_BP4Serializer.PutVariableMetadata(variable, blockInfo, sourceRowMajor);
-    m_BP4Serializer.PutVariablePayload(variable, blockInfo, sourceRowMajor);
+    if (zeroCopy && blockInfo.Operations.empty() &&
+        blockInfo.MemoryStart.empty() &&
+        helper::PayloadSize(blockInfo.Data, blockInfo.Count) >=
+            m_BP4Serializer.m_Parameters.ZeroCopyThreshold)
+    {
+        m_BP4Serializer.PutVariablePayloadReference(variable, blockInfo);
+    }
+    else
+    {
+        m_BP4Serializer.PutVariablePayload(variable, blockInfo,
+                                           sourceRowMajor);
+    }
 }
 
 template <class T>
@@ -131,14 +164,14 @@ T *BP4Writer::BufferDataCommon(const size_t payloadPosition,
 }
 
 template <class T>
-void BP4Writer::PerformPutCommon(Variable<T> &variable)
+void BP4Writer::PerformPutCommon(Variable<T> &variable, const bool zeroCopy)
 {
     for (size_t b = 0; b < variable.m_BlocksInfo.size(); ++b)
     {
         auto itSpanBlock = variable.m_BlocksSpan.find(b);
         if (itSpanBlock == variable.m_BlocksSpan.end())
         {
-            PutSyncCommon(variable, variable.m_BlocksInfo[b], false);
+            PutSyncCommon(variable, variable.m_BlocksInfo[b], false, zeroCopy);
         }
         else
         {
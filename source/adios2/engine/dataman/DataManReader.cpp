@@ -69,6 +69,14 @@ DataManReader::DataManReader(IO &io, const std::string &name,
     nlohmann::json message = nlohmann::json::parse(reply->data());
     m_TransportMode = message["Transport"];
 
+    // writers without this key send JSON strings, binary packs are always
+    // recognized by the deserializer
+    auto itFormat = message.find("MetadataFormat");
+    if (itFormat != message.end())
+    {
+        m_Serializer.SetMetadataFormat(itFormat->get<std::string>());
+    }
+
     if (m_MonitorActive)
     {
         m_Monitor.SetClockError(roundLatency, message["TimeStamp"]);
@@ -44,10 +44,34 @@ DataManWriter::DataManWriter(IO &io, const std::string &name,
     helper::GetParameter(m_IO.m_Parameters, "Monitor", m_MonitorActive);
     helper::GetParameter(m_IO.m_Parameters, "CombiningSteps", m_CombiningSteps);
     helper::GetParameter(m_IO.m_Parameters, "FloatAccuracy", m_FloatAccuracy);
+    helper::GetParameter(m_IO.m_Parameters, "MetadataFormat",
+                         m_MetadataFormat);
+    helper::GetParameter(m_IO.m_Parameters, "CompressionThreads",
+                         m_CompressionThreads);
+
+    m_Serializer.SetMetadataFormat(m_MetadataFormat);
+    if (m_CompressionThreads > 1)
+    {
+        m_Serializer.SetCompressionThreads(m_CompressionThreads);
+    }
+
+    // binary metadata only carries schema entries a reader has not seen yet.
+    // Subscribers may join late or lose packs, and reliable mode with several
+    // readers hands each pack to only one of them, so the full schema is
+    // resent periodically in these cases.
+    if (m_TransportMode == "fast")
+    {
+        m_SchemaResendInterval = 16;
+    }
+    else if (m_RendezvousReaderCount != 1)
+    {
+        m_SchemaResendInterval = 1;
+    }
 
     m_HandshakeJson["Threading"] = m_Threading;
     m_HandshakeJson["Transport"] = m_TransportMode;
     m_HandshakeJson["FloatAccuracy"] = m_FloatAccuracy;
+    m_HandshakeJson["MetadataFormat"] = m_MetadataFormat;
 
     if (m_IPAddress.empty())
     {
@@ -142,10 +166,13 @@ StepStatus DataManWriter::BeginStep(StepMode mode, const float timeout_sec)
 
 size_t DataManWriter::CurrentStep() const { return m_CurrentStep; }
 
-void DataManWriter::PerformPuts() {}
+void DataManWriter::PerformPuts() { m_Serializer.FinishCompression(); }
 
 void DataManWriter::EndStep()
 {
+    // deferred data is only valid until EndStep, also when steps are combined
+    m_Serializer.FinishCompression();
+
     if (m_CurrentStep == 0)
     {
         m_Serializer.PutAttributes(m_IO);
@@ -157,6 +184,7 @@ void DataManWriter::EndStep()
     {
         m_CombinedSteps = 0;
         m_Serializer.AttachAttributesToLocalPack();
+        ResendSchemaIfDue();
         const auto buffer = m_Serializer.GetLocalPack();
         if (buffer->size() > m_SerializerBufferSize)
         {
@@ -205,6 +233,7 @@ void DataManWriter::DoClose(const int transportIndex)
     if (m_CombinedSteps < m_CombiningSteps && m_CombinedSteps > 0)
     {
         m_Serializer.AttachAttributesToLocalPack();
+        ResendSchemaIfDue();
         const auto buffer = m_Serializer.GetLocalPack();
         if (buffer->size() > m_SerializerBufferSize)
         {
@@ -263,6 +292,19 @@ void DataManWriter::DoClose(const int transportIndex)
     }
 }
 
+void DataManWriter::ResendSchemaIfDue()
+{
+    if (m_SchemaResendInterval > 0)
+    {
+        ++m_PacksSinceSchema;
+        if (m_PacksSinceSchema >= m_SchemaResendInterval)
+        {
+            m_Serializer.ResendSchema();
+            m_PacksSinceSchema = 0;
+        }
+    }
+}
+
 void DataManWriter::PushBufferQueue(std::shared_ptr<std::vector<char>> buffer)
 {
     std::lock_guard<std::mutex> l(m_BufferQueueMutex);
@@ -52,6 +52,10 @@ private:
     int m_CombiningSteps = 1;
     int m_CombinedSteps = 0;
     std::string m_FloatAccuracy;
+    std::string m_MetadataFormat = "binary";
+    int m_SchemaResendInterval = 0;
+    int m_PacksSinceSchema = 0;
+    int m_CompressionThreads = 1;
 
     int m_MpiRank;
     int m_MpiSize;
@@ -79,6 +83,7 @@ private:
     std::shared_ptr<std::vector<char>> PopBufferQueue();
 
     void Handshake();
+    void ResendSchemaIfDue();
     void ReplyThread();
     void PublishThread();
 
@@ -118,6 +118,8 @@ StepStatus SscReader::BeginStep(const StepMode stepMode,
         BeginStepConsequentFixed();
     }
 
+    m_CopyPlans.Rewind();
+
     for (const auto &r : m_GlobalWritePattern)
     {
         for (auto &v : r)
@@ -13,6 +13,7 @@
 
 #include "SscHelper.h"
 #include "adios2/core/Engine.h"
+#include "adios2/helper/adiosMemory.h"
 #include "adios2/helper/adiosMpiHandshake.h"
 #include "adios2/toolkit/profiling/taustubs/tautimer.hpp"
 #include <mpi.h>
@@ -49,6 +50,8 @@ private:
 
     ssc::RankPosMap m_AllReceivingWriterRanks;
     std::vector<char> m_Buffer;
+    // with locked selections the same blocks are copied every step
+    helper::NdCopyPlanCache m_CopyPlans;
     MPI_Win m_MpiWin;
     MPI_Group m_WriterGroup;
     MPI_Comm m_StreamComm;
@@ -138,10 +138,11 @@ void SscReader::GetDeferredCommon(Variable<T> &variable, T *data)
                     if (b.shapeId == ShapeID::GlobalArray ||
                         b.shapeId == ShapeID::LocalArray)
                     {
-                        helper::NdCopy<T>(m_Buffer.data() + b.bufferStart,
-                                          b.start, b.count, true, true,
-                                          reinterpret_cast<char *>(data),
-                                          vStart, vCount, true, true);
+                        m_CopyPlans
+                            .Get(b.start, b.count, true, true, vStart, vCount,
+                                 true, true, sizeof(T))
+                            .Execute(m_Buffer.data() + b.bufferStart,
+                                     reinterpret_cast<char *>(data));
                     }
                     else if (b.shapeId == ShapeID::GlobalValue ||
                              b.shapeId == ShapeID::LocalValue)
@@ -272,7 +272,14 @@ void SstWriter::EndStep()
     }
 }
 
-void SstWriter::PerformPuts() {}
+void SstWriter::PerformPuts()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    if (Params.MarshalMethod == SstMarshalFFS)
+    {
+        SstFFSWriterPerformPuts(m_Output);
+    }
+}
 
 void SstWriter::Flush(const int transportIndex) {}
 
@@ -294,11 +301,11 @@ void SstWriter::Init()
 #define declare_type(T)                                                        \
     void SstWriter::DoPutSync(Variable<T> &variable, const T *values)          \
     {                                                                          \
-        PutSyncCommon(variable, values);                                       \
+        PutCommon(variable, values, false);                                    \
     }                                                                          \
     void SstWriter::DoPutDeferred(Variable<T> &variable, const T *values)      \
     {                                                                          \
-        PutSyncCommon(variable, values);                                       \
+        PutCommon(variable, values, true);                                     \
     }
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
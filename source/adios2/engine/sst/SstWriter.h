@@ -51,11 +51,13 @@ private:
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+    /**
+     * Marshals a block of variable
+     * @param deferred with FFS marshaling and DeferredPutNoCopy, values is
+     * referenced instead of copied until PerformPuts or EndStep
+     */
     template <class T>
-    void PutSyncCommon(Variable<T> &variable, const T *values);
-
-    template <class T>
-    void PutDeferredCommon(Variable<T> &variable, const T *values);
+    void PutCommon(Variable<T> &variable, const T *values, const bool deferred);
 
     struct BP3DataBlock
     {
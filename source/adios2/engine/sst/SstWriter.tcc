@@ -24,7 +24,8 @@ namespace engine
 {
 
 template <class T>
-void SstWriter::PutSyncCommon(Variable<T> &variable, const T *values)
+void SstWriter::PutCommon(Variable<T> &variable, const T *values,
+                          const bool deferred)
 {
     TAU_SCOPED_TIMER_FUNC();
     variable.SetData(values);
@@ -57,7 +58,8 @@ void SstWriter::PutSyncCommon(Variable<T> &variable, const T *values)
         }
         SstFFSMarshal(m_Output, (void *)&variable, variable.m_Name.c_str(),
                       (int)variable.m_Type, variable.m_ElementSize, DimCount,
-                      Shape, Count, Start, values);
+                      Shape, Count, Start, values,
+                      deferred && Params.DeferredPutNoCopy);
     }
     else if (Params.MarshalMethod == SstMarshalBP)
     {
@@ -191,8 +191,16 @@ void TableWriter::InitParameters()
         {
             m_RowsPerAggregatorBuffer = std::stoll(value);
         }
+        if (key == "metadataformat")
+        {
+            m_MetadataFormat = value;
+        }
     }
 
+    // all ranks of the table share the parameter, so aggregators decode packs
+    // in the same format the serializers of other ranks encode them
+    m_Deserializer.SetMetadataFormat(m_MetadataFormat);
+
     if (m_Aggregators > m_MpiSize)
     {
         m_Aggregators = m_MpiSize;
@@ -235,6 +243,7 @@ void TableWriter::InitTransports()
     {
         auto s =
             std::make_shared<format::DataManSerializer>(m_Comm, m_IsRowMajor);
+        s->SetMetadataFormat(m_MetadataFormat);
         s->NewWriterBuffer(m_SerializerBufferSize);
         s->SetDestination(m_AllAddresses[i]);
         m_Serializers.push_back(s);
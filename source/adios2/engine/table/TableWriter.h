@@ -59,6 +59,7 @@ private:
     size_t m_SerializerBufferSize = 1 * 1024 * 1024;
     size_t m_ReceiverBufferSize = 512 * 1024 * 1024;
     size_t m_RowsPerAggregatorBuffer = 400;
+    std::string m_MetadataFormat = "binary";
     std::unordered_map<size_t,
                        std::unordered_map<std::string, std::vector<char>>>
         m_AggregatorBuffers;
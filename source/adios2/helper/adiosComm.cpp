@@ -83,6 +83,12 @@ bool Comm::IsMPI() const { return m_Impl->IsMPI(); }
 
 void Comm::Barrier(const std::string &hint) const { m_Impl->Barrier(hint); }
 
+Comm::Win Comm::WinAllocateShared(const size_t size,
+                                  const std::string &hint) const
+{
+    return m_Impl->WinAllocateShared(size, hint);
+}
+
 std::string Comm::BroadcastFile(const std::string &fileName,
                                 const std::string hint,
                                 const int rankSource) const
@@ -135,6 +141,33 @@ Comm::Status Comm::Req::Wait(const std::string &hint)
     return status;
 }
 
+Comm::Win::Win() = default;
+
+Comm::Win::Win(std::unique_ptr<CommWinImpl> impl) : m_Impl(std::move(impl)) {}
+
+Comm::Win::~Win() = default;
+
+Comm::Win::Win(Win &&win) = default;
+
+Comm::Win &Comm::Win::operator=(Win &&win) = default;
+
+char *Comm::Win::SharedQuery(const int rank, size_t &size,
+                             const std::string &hint)
+{
+    return m_Impl->SharedQuery(rank, size, hint);
+}
+
+void Comm::Win::Fence(const std::string &hint) { m_Impl->Fence(hint); }
+
+void Comm::Win::Free(const std::string &hint)
+{
+    if (m_Impl)
+    {
+        m_Impl->Free(hint);
+        m_Impl.reset();
+    }
+}
+
 CommImpl::~CommImpl() = default;
 
 size_t CommImpl::SizeOf(Datatype datatype) { return ToSize(datatype); }
@@ -149,9 +182,16 @@ Comm::Req CommImpl::MakeReq(std::unique_ptr<CommReqImpl> impl)
     return Comm::Req(std::move(impl));
 }
 
+Comm::Win CommImpl::MakeWin(std::unique_ptr<CommWinImpl> impl)
+{
+    return Comm::Win(std::move(impl));
+}
+
 CommImpl *CommImpl::Get(Comm const &comm) { return comm.m_Impl.get(); }
 
 CommReqImpl::~CommReqImpl() = default;
 
+CommWinImpl::~CommWinImpl() = default;
+
 } // end namespace helper
 } // end namespace adios2
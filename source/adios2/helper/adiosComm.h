@@ -19,6 +19,7 @@ namespace helper
 
 class CommImpl;
 class CommReqImpl;
+class CommWinImpl;
 
 /** @brief Encapsulation for communication in a multi-process environment.  */
 class Comm
@@ -26,6 +27,7 @@ class Comm
 public:
     class Req;
     class Status;
+    class Win;
 
     /**
      * @brief Enumeration of element-wise accumulation operations.
@@ -135,6 +137,18 @@ public:
 
     void Barrier(const std::string &hint = std::string()) const;
 
+    /**
+     * @brief Allocate a window of memory shared by all processes.
+     * @param size Bytes contributed by this process, may be 0.
+     * @param hint Description of std::runtime_error exception on error.
+     *
+     * Collective. All processes must be able to share memory, see
+     * GroupByShm.  The memory of each process follows the memory of the
+     * previous rank.
+     */
+    Win WinAllocateShared(const size_t size,
+                          const std::string &hint = std::string()) const;
+
     /**
      * Gather a single source value from each ranks and forms a vector in
      * rankDestination.
@@ -316,6 +330,71 @@ private:
     std::unique_ptr<CommReqImpl> m_Impl;
 };
 
+class Comm::Win
+{
+public:
+    /**
+     * @brief Default constructor.  Produces an empty window.
+     *
+     * An empty window may not be used.
+     */
+    Win();
+
+    /**
+     * @brief Move constructor.  Moves window state from that given.
+     *
+     * The moved-from window is left empty and may not be used.
+     */
+    Win(Win &&);
+
+    /**
+     * @brief Deleted copy constructor.  A window may not be copied.
+     */
+    Win(Win const &) = delete;
+
+    ~Win();
+
+    /**
+     * @brief Move assignment.  Moves window state from that given.
+     *
+     * The moved-from window is left empty and may not be used.
+     */
+    Win &operator=(Win &&);
+
+    /**
+     * @brief Deleted copy assignment.  A window may not be copied.
+     */
+    Win &operator=(Win const &) = delete;
+
+    /**
+     * @brief Address of the memory contributed by a process.
+     * @param rank Process in the communicator that allocated the window.
+     * @param size Returns bytes contributed by the process.
+     */
+    char *SharedQuery(const int rank, size_t &size,
+                      const std::string &hint = std::string());
+
+    /**
+     * @brief Collective synchronization: memory written by any process
+     * before the fence is visible to all processes after it.
+     */
+    void Fence(const std::string &hint = std::string());
+
+    /**
+     * @brief Collective. Free the window memory.
+     *
+     * On return, the window is empty.
+     */
+    void Free(const std::string &hint = std::string());
+
+private:
+    friend class CommImpl;
+
+    explicit Win(std::unique_ptr<CommWinImpl> impl);
+
+    std::unique_ptr<CommWinImpl> m_Impl;
+};
+
 class Comm::Status
 {
 public:
@@ -381,6 +460,8 @@ public:
     virtual int Size() const = 0;
     virtual bool IsMPI() const = 0;
     virtual void Barrier(const std::string &hint) const = 0;
+    virtual Comm::Win WinAllocateShared(const size_t size,
+                                        const std::string &hint) const = 0;
     virtual void Allgather(const void *sendbuf, size_t sendcount,
                            Datatype sendtype, void *recvbuf, size_t recvcount,
                            Datatype recvtype,
@@ -441,6 +522,7 @@ public:
 
     static Comm MakeComm(std::unique_ptr<CommImpl> impl);
     static Comm::Req MakeReq(std::unique_ptr<CommReqImpl> impl);
+    static Comm::Win MakeWin(std::unique_ptr<CommWinImpl> impl);
     static CommImpl *Get(Comm const &comm);
 };
 
@@ -451,6 +533,16 @@ public:
     virtual Comm::Status Wait(const std::string &hint) = 0;
 };
 
+class CommWinImpl
+{
+public:
+    virtual ~CommWinImpl() = 0;
+    virtual char *SharedQuery(const int rank, size_t &size,
+                              const std::string &hint) = 0;
+    virtual void Fence(const std::string &hint) = 0;
+    virtual void Free(const std::string &hint) = 0;
+};
+
 } // end namespace helper
 } // end namespace adios2
 
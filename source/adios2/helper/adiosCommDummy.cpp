@@ -9,6 +9,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "adiosComm.h"
 
@@ -38,6 +39,23 @@ public:
 
 CommReqImplDummy::~CommReqImplDummy() = default;
 
+class CommWinImplDummy : public CommWinImpl
+{
+public:
+    CommWinImplDummy(const size_t size) : m_Memory(size) {}
+    ~CommWinImplDummy() override;
+
+    char *SharedQuery(const int rank, size_t &size,
+                      const std::string &hint) override;
+    void Fence(const std::string &hint) override;
+    void Free(const std::string &hint) override;
+
+    /** memory of the single process */
+    std::vector<char> m_Memory;
+};
+
+CommWinImplDummy::~CommWinImplDummy() = default;
+
 class CommImplDummy : public CommImpl
 {
 public:
@@ -56,6 +74,8 @@ public:
     int Size() const override;
     bool IsMPI() const override;
     void Barrier(const std::string &hint) const override;
+    Comm::Win WinAllocateShared(const size_t size,
+                                const std::string &hint) const override;
 
     void Allgather(const void *sendbuf, size_t sendcount, Datatype sendtype,
                    void *recvbuf, size_t recvcount, Datatype recvtype,
@@ -139,6 +159,13 @@ bool CommImplDummy::IsMPI() const { return false; }
 
 void CommImplDummy::Barrier(const std::string &) const {}
 
+Comm::Win CommImplDummy::WinAllocateShared(const size_t size,
+                                           const std::string &) const
+{
+    auto win = std::unique_ptr<CommWinImplDummy>(new CommWinImplDummy(size));
+    return MakeWin(std::move(win));
+}
+
 void CommImplDummy::Allgather(const void *sendbuf, size_t sendcount,
                               Datatype sendtype, void *recvbuf,
                               size_t recvcount, Datatype recvtype,
@@ -291,6 +318,20 @@ Comm::Status CommReqImplDummy::Wait(const std::string &hint)
     return status;
 }
 
+char *CommWinImplDummy::SharedQuery(const int, size_t &size,
+                                    const std::string &)
+{
+    size = m_Memory.size();
+    return m_Memory.data();
+}
+
+void CommWinImplDummy::Fence(const std::string &) {}
+
+void CommWinImplDummy::Free(const std::string &)
+{
+    std::vector<char>().swap(m_Memory);
+}
+
 Comm CommDummy()
 {
     auto comm = std::unique_ptr<CommImpl>(new CommImplDummy());
@@ -108,6 +108,24 @@ public:
 
 CommReqImplMPI::~CommReqImplMPI() = default;
 
+class CommWinImplMPI : public CommWinImpl
+{
+public:
+    CommWinImplMPI() = default;
+    ~CommWinImplMPI() override;
+
+    char *SharedQuery(const int rank, size_t &size,
+                      const std::string &hint) override;
+    void Fence(const std::string &hint) override;
+    void Free(const std::string &hint) override;
+
+    /** Encapsulated MPI window instance.  MPI_Win_free is collective, so
+     *  the window is only freed by Free.  */
+    MPI_Win m_Win = MPI_WIN_NULL;
+};
+
+CommWinImplMPI::~CommWinImplMPI() = default;
+
 class CommImplMPI : public CommImpl
 {
 public:
@@ -129,6 +147,8 @@ public:
     int Size() const override;
     bool IsMPI() const override;
     void Barrier(const std::string &hint) const override;
+    Comm::Win WinAllocateShared(const size_t size,
+                                const std::string &hint) const override;
 
     void Allgather(const void *sendbuf, size_t sendcount, Datatype sendtype,
                    void *recvbuf, size_t recvcount, Datatype recvtype,
@@ -258,6 +278,18 @@ void CommImplMPI::Barrier(const std::string &hint) const
     CheckMPIReturn(MPI_Barrier(m_MPIComm), hint);
 }
 
+Comm::Win CommImplMPI::WinAllocateShared(const size_t size,
+                                         const std::string &hint) const
+{
+    auto win = std::unique_ptr<CommWinImplMPI>(new CommWinImplMPI());
+    void *baseptr = nullptr;
+    CheckMPIReturn(MPI_Win_allocate_shared(static_cast<MPI_Aint>(size), 1,
+                                           MPI_INFO_NULL, m_MPIComm, &baseptr,
+                                           &win->m_Win),
+                   hint);
+    return MakeWin(std::move(win));
+}
+
 void CommImplMPI::Allgather(const void *sendbuf, size_t sendcount,
                             Datatype sendtype, void *recvbuf, size_t recvcount,
                             Datatype recvtype, const std::string &hint) const
@@ -580,6 +612,32 @@ Comm::Status CommReqImplMPI::Wait(const std::string &hint)
     return status;
 }
 
+char *CommWinImplMPI::SharedQuery(const int rank, size_t &size,
+                                  const std::string &hint)
+{
+    MPI_Aint mpiSize = 0;
+    int dispUnit = 1;
+    void *baseptr = nullptr;
+    CheckMPIReturn(
+        MPI_Win_shared_query(m_Win, rank, &mpiSize, &dispUnit, &baseptr),
+        hint);
+    size = static_cast<size_t>(mpiSize);
+    return static_cast<char *>(baseptr);
+}
+
+void CommWinImplMPI::Fence(const std::string &hint)
+{
+    CheckMPIReturn(MPI_Win_fence(0, m_Win), hint);
+}
+
+void CommWinImplMPI::Free(const std::string &hint)
+{
+    if (m_Win != MPI_WIN_NULL)
+    {
+        CheckMPIReturn(MPI_Win_free(&m_Win), hint);
+    }
+}
+
 Comm CommWithMPI(MPI_Comm mpiComm)
 {
     static InitMPI const initMPI;
@@ -12,13 +12,14 @@
 #ifndef ADIOS2_HELPER_ADIOSFUNCTIONS_H_
 #define ADIOS2_HELPER_ADIOSFUNCTIONS_H_
 
-#include "adios2/helper/adiosMath.h"    //math functions (cmath, algorithm)
-#include "adios2/helper/adiosMemory.h"  //memcpy, std::copy, insert, resize
-#include "adios2/helper/adiosNetwork.h" //network and staging functions
-#include "adios2/helper/adiosString.h"  //std::string manipulation
-#include "adios2/helper/adiosSystem.h"  //OS functionality, POSIX, filesystem
-#include "adios2/helper/adiosType.h"    //Type casting, conversion, checks, etc.
-#include "adios2/helper/adiosXML.h"     //XML parsing
-#include "adios2/helper/adiosYAML.h"    //YAML parsing
+#include "adios2/helper/adiosMath.h"       //math functions (cmath, algorithm)
+#include "adios2/helper/adiosMemory.h"     //memcpy, std::copy, insert, resize
+#include "adios2/helper/adiosNetwork.h"    //network and staging functions
+#include "adios2/helper/adiosString.h"     //std::string manipulation
+#include "adios2/helper/adiosSystem.h"     //OS functionality, POSIX, filesystem
+#include "adios2/helper/adiosThreadPool.h" //ParallelFor on the process pool
+#include "adios2/helper/adiosType.h"       //Type casting, conversion, checks
+#include "adios2/helper/adiosXML.h"        //XML parsing
+#include "adios2/helper/adiosYAML.h"       //YAML parsing
 
 #endif /* ADIOS2_HELPER_ADIOSFUNCTIONS_H_ */
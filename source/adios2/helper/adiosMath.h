@@ -47,7 +47,8 @@ void GetMinMaxSelection(const T *values, const Dims &shape, const Dims &start,
 
 /**
  * Gets the min and max from a values array of primitive types (not including
- * complex)
+ * complex). Vectorized for integer, float and double types, see
+ * adiosMathSIMD.h, NaN values are skipped unless all values are NaN.
  * @param values input array
  * @param size of values array
  * @param min of values
@@ -72,12 +73,12 @@ void GetMinMaxComplex(const std::complex<T> *values, const size_t size,
 /**
  * Threaded version of GetMinMax.
  * Gets the min and max from a values array of primitive types (not including
- * complex) using threads
+ * complex) using threads of the process pool, see ParallelFor
  * @param values input array of complex
  * @param size of values array
  * @param min of values
  * @param max of values
- * @param threads used for parallel computation
+ * @param threads maximum number of chunks computed in parallel
  */
 template <class T>
 void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
@@ -89,7 +90,7 @@ void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
  * @param size of values array
  * @param min of values
  * @param max of values
- * @param threads used for parallel computation
+ * @param threads maximum number of chunks computed in parallel
  */
 template <class T>
 void GetMinMaxThreads(const std::complex<T> *values, const size_t size, T &min,
@@ -313,6 +314,43 @@ void GetMinMaxSubblocks(const T *values, const Dims &count,
                         const BlockDivisionInfo &info, std::vector<T> &MinMaxs,
                         T &bmin, T &bmax, const unsigned int threads) noexcept;
 
+/**
+ * Gets the min and max from a values array while copying it to destination,
+ * reading values once. Vectorized for the types of adiosMathSIMD.h, other
+ * types are copied before GetMinMax.
+ * @param values input array
+ * @param size of values array
+ * @param destination of the copy, may be unaligned
+ * @param min of values
+ * @param max of values
+ * @param nonTemporal true: stores bypass the cache, for copies larger than
+ * the last level cache
+ */
+template <class T>
+void CopyMinMax(const T *values, const size_t size, char *destination, T &min,
+                T &max, const bool nonTemporal = false) noexcept;
+
+/**
+ * Threaded version of CopyMinMax using threads of the process pool
+ * @param threads maximum number of chunks copied in parallel
+ */
+template <class T>
+void CopyMinMaxThreads(const T *values, const size_t size, char *destination,
+                       T &min, T &max, const unsigned int threads = 1,
+                       const bool nonTemporal = false) noexcept;
+
+/**
+ * GetMinMaxSubblocks while copying values to destination, see CopyMinMax
+ * @param values input array, not nullptr
+ * @param destination of the copy of all values, may be unaligned
+ */
+template <class T>
+void CopyMinMaxSubblocks(const T *values, const Dims &count,
+                         const BlockDivisionInfo &info, char *destination,
+                         std::vector<T> &MinMaxs, T &bmin, T &bmax,
+                         const unsigned int threads,
+                         const bool nonTemporal) noexcept;
+
 } // end namespace helper
 } // end namespace adios2
 
@@ -16,10 +16,12 @@
 
 #include <algorithm> // std::minmax_element, std::min_element, std::max_element
                      // std::transform
+#include <cstring>   // std::memcpy
 #include <limits>    //std::numeri_limits
-#include <thread>
 
 #include "adios2/common/ADIOSMacros.h"
+#include "adios2/helper/adiosMathSIMD.h"
+#include "adios2/helper/adiosThreadPool.h"
 
 namespace adios2
 {
@@ -52,7 +54,7 @@ void GetMinMaxSelection(const T *values, const Dims &shape, const Dims &start,
             T minStride, maxStride;
             GetMinMax(values + startOffset, stride, minStride, maxStride);
 
-            if (firstStep)
+            if (firstStep || min != min)
             {
                 min = minStride;
                 max = maxStride;
@@ -117,7 +119,7 @@ void GetMinMaxSelection(const T *values, const Dims &shape, const Dims &start,
             T minStride, maxStride;
             GetMinMax(values + startOffset, stride, minStride, maxStride);
 
-            if (firstStep)
+            if (firstStep || min != min)
             {
                 min = minStride;
                 max = maxStride;
@@ -191,6 +193,16 @@ inline void GetMinMax(const T *values, const size_t size, T &min,
     max = *bounds.second;
 }
 
+#define declare_type(T)                                                        \
+    template <>                                                                \
+    inline void GetMinMax(const T *values, const size_t size, T &min,          \
+                          T &max) noexcept                                     \
+    {                                                                          \
+        GetMinMaxSIMD(values, size, min, max);                                 \
+    }
+ADIOS2_FOREACH_SIMD_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
 template <>
 inline void GetMinMax(const std::complex<float> *values, const size_t size,
                       std::complex<float> &min,
@@ -251,44 +263,21 @@ void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
         return;
     }
 
-    const size_t stride = size / threads;    // elements per thread
-    const size_t remainder = size % threads; // remainder if not aligned
-    const size_t last = stride + remainder;
-
+    // one chunk per thread of the process pool, serial if there is none
     std::vector<T> mins(threads); // zero init
     std::vector<T> maxs(threads); // zero init
 
-    std::vector<std::thread> getMinMaxThreads;
-    getMinMaxThreads.reserve(threads);
-
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t position = stride * t;
-
-        if (t == threads - 1)
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMax<T>, &values[position], last,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-        else
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMax<T>, &values[position], stride,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-    }
-
-    for (auto &getMinMaxThread : getMinMaxThreads)
-    {
-        getMinMaxThread.join();
-    }
-
-    auto itMin = std::min_element(mins.begin(), mins.end());
-    min = *itMin;
-
-    auto itMax = std::max_element(maxs.begin(), maxs.end());
-    max = *itMax;
+    ParallelFor(size, threads,
+                [&](const size_t chunk, const size_t begin, const size_t end) {
+                    GetMinMax(&values[begin], end - begin, mins[chunk],
+                              maxs[chunk]);
+                });
+
+    // same NaN semantics as GetMinMax on the whole array
+    T minTemp;
+    T maxTemp;
+    GetMinMax(mins.data(), mins.size(), min, maxTemp);
+    GetMinMax(maxs.data(), maxs.size(), minTemp, max);
 }
 
 template <class T>
@@ -307,38 +296,15 @@ void GetMinMaxThreads(const std::complex<T> *values, const size_t size,
         return;
     }
 
-    const size_t stride = size / threads;    // elements per thread
-    const size_t remainder = size % threads; // remainder if not aligned
-    const size_t last = stride + remainder;
-
+    // one chunk per thread of the process pool, serial if there is none
     std::vector<std::complex<T>> mins(threads); // zero init
     std::vector<std::complex<T>> maxs(threads); // zero init
 
-    std::vector<std::thread> getMinMaxThreads;
-    getMinMaxThreads.reserve(threads);
-
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t position = stride * t;
-
-        if (t == threads - 1)
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMaxComplex<T>, &values[position], last,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-        else
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMaxComplex<T>, &values[position], stride,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-    }
-
-    for (auto &getMinMaxThread : getMinMaxThreads)
-    {
-        getMinMaxThread.join();
-    }
+    ParallelFor(size, threads,
+                [&](const size_t chunk, const size_t begin, const size_t end) {
+                    GetMinMaxComplex(&values[begin], end - begin,
+                                     mins[chunk], maxs[chunk]);
+                });
 
     std::complex<T> minTemp;
     std::complex<T> maxTemp;
@@ -392,7 +358,9 @@ void GetMinMaxSubblocks(const T *values, const Dims &count,
             GetMinMax(values + pos, nElemsSub, vmin, vmax);
             MinMaxs[2 * b] = vmin;
             MinMaxs[2 * b + 1] = vmax;
-            if (b == 0)
+            // a NaN min/max comes from an all-NaN subblock, replaced by any
+            // later subblock
+            if (b == 0 || bmin != bmin)
             {
                 bmin = vmin;
                 bmax = vmax;
@@ -412,6 +380,118 @@ void GetMinMaxSubblocks(const T *values, const Dims &count,
     }
 }
 
+template <class T>
+void CopyMinMax(const T *values, const size_t size, char *destination, T &min,
+                T &max, const bool /*nonTemporal*/) noexcept
+{
+    if (size == 0)
+    {
+        return;
+    }
+    std::memcpy(destination, values, size * sizeof(T));
+    GetMinMax(values, size, min, max);
+}
+
+#define declare_type(T)                                                        \
+    template <>                                                                \
+    inline void CopyMinMax(const T *values, const size_t size,                 \
+                           char *destination, T &min, T &max,                  \
+                           const bool nonTemporal) noexcept                    \
+    {                                                                          \
+        CopyMinMaxSIMD(values, size, destination, min, max, nonTemporal);      \
+    }
+ADIOS2_FOREACH_SIMD_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+template <class T>
+void CopyMinMaxThreads(const T *values, const size_t size, char *destination,
+                       T &min, T &max, const unsigned int threads,
+                       const bool nonTemporal) noexcept
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    if (threads == 1 || size < 1000000)
+    {
+        CopyMinMax(values, size, destination, min, max, nonTemporal);
+        return;
+    }
+
+    std::vector<T> mins(threads); // zero init
+    std::vector<T> maxs(threads); // zero init
+
+    ParallelFor(size, threads,
+                [&](const size_t chunk, const size_t begin, const size_t end) {
+                    CopyMinMax(&values[begin], end - begin,
+                               destination + begin * sizeof(T), mins[chunk],
+                               maxs[chunk], nonTemporal);
+                });
+
+    // same NaN semantics as GetMinMax on the whole array
+    T minTemp;
+    T maxTemp;
+    GetMinMax(mins.data(), mins.size(), min, maxTemp);
+    GetMinMax(maxs.data(), maxs.size(), minTemp, max);
+}
+
+template <class T>
+void CopyMinMaxSubblocks(const T *values, const Dims &count,
+                         const BlockDivisionInfo &info, char *destination,
+                         std::vector<T> &MinMaxs, T &bmin, T &bmax,
+                         const unsigned int threads,
+                         const bool nonTemporal) noexcept
+{
+    const int ndim = static_cast<int>(count.size());
+    const size_t nElems = helper::GetTotalSize(count);
+    if (info.NBlocks <= 1)
+    {
+        MinMaxs.resize(2);
+        CopyMinMaxThreads(values, nElems, destination, bmin, bmax, threads,
+                          nonTemporal);
+        MinMaxs[0] = bmin;
+        MinMaxs[1] = bmax;
+        return;
+    }
+
+    // the contiguous subblocks cover values in order
+    MinMaxs.resize(2 * info.NBlocks);
+    for (int b = 0; b < info.NBlocks; ++b)
+    {
+        const Box<Dims> box = GetSubBlock(count, info, b);
+        size_t pos = 0;
+        size_t prod = 1;
+        for (int d = ndim - 1; d >= 0; --d)
+        {
+            pos += box.first[d] * prod;
+            prod *= count[d];
+        }
+        T vmin, vmax;
+        const size_t nElemsSub = helper::GetTotalSize(box.second);
+        CopyMinMax(values + pos, nElemsSub, destination + pos * sizeof(T),
+                   vmin, vmax, nonTemporal);
+        MinMaxs[2 * b] = vmin;
+        MinMaxs[2 * b + 1] = vmax;
+        if (b == 0 || bmin != bmin)
+        {
+            bmin = vmin;
+            bmax = vmax;
+        }
+        else
+        {
+            if (LessThan(vmin, bmin))
+            {
+                bmin = vmin;
+            }
+            if (GreaterThan(vmax, bmax))
+            {
+                bmax = vmax;
+            }
+        }
+    }
+}
+
 #if 0
 template <class T>
 void GetMinMaxSubblocks(const T *values, const Dims &count,
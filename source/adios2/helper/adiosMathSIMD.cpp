@@ -0,0 +1,235 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosMathSIMD.cpp scalar and 128-bit kernels, run time dispatch to the
+ * kernels of adiosMathSIMDAVX2.cpp and adiosMathSIMDAVX512.cpp
+ */
+
+#include "adiosMathSIMD.h"
+
+#include "adios2/common/ADIOSConfig.h"
+
+#include <atomic>
+#include <stdexcept> //std::invalid_argument
+
+#define ADIOS2_SIMD_NAMESPACE simd_scalar
+#define ADIOS2_SIMD_BYTES 0
+#include "adiosMathSIMD.tcc"
+#undef ADIOS2_SIMD_BYTES
+#undef ADIOS2_SIMD_NAMESPACE
+
+#ifdef ADIOS2_HAVE_SIMD
+#define ADIOS2_SIMD_NAMESPACE simd_128
+#define ADIOS2_SIMD_BYTES 16
+#include "adiosMathSIMD.tcc"
+#undef ADIOS2_SIMD_BYTES
+#undef ADIOS2_SIMD_NAMESPACE
+#endif
+
+namespace adios2
+{
+namespace helper
+{
+
+// explicitly instantiated in their own translation units
+#define declare_kernels(NAMESPACE)                                             \
+    namespace NAMESPACE                                                        \
+    {                                                                          \
+    template <class T>                                                         \
+    void MinMax(const T *values, const size_t size, T &min, T &max) noexcept;  \
+    template <class T>                                                         \
+    void MinMaxCopy(const T *values, const size_t size, char *destination,     \
+                    T &min, T &max, const bool nonTemporal) noexcept;          \
+    template <class T>                                                         \
+    void SumSquares(const T *values, const size_t size, double &sum,           \
+                    double &sumSquares, size_t &count) noexcept;               \
+    }
+
+#ifdef ADIOS2_HELPER_SIMD_AVX2
+declare_kernels(simd_avx2)
+#endif
+#ifdef ADIOS2_HELPER_SIMD_AVX512
+declare_kernels(simd_avx512)
+#endif
+#undef declare_kernels
+
+namespace
+{
+
+SIMDLevel DetectSIMDLevel() noexcept
+{
+#if defined(ADIOS2_HELPER_SIMD_AVX2) || defined(ADIOS2_HELPER_SIMD_AVX512)
+    __builtin_cpu_init();
+#endif
+#ifdef ADIOS2_HELPER_SIMD_AVX512
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return SIMDLevel::AVX512;
+    }
+#endif
+#ifdef ADIOS2_HELPER_SIMD_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SIMDLevel::AVX2;
+    }
+#endif
+#ifdef ADIOS2_HAVE_SIMD
+    return SIMDLevel::SIMD128;
+#else
+    return SIMDLevel::Scalar;
+#endif
+}
+
+std::atomic<SIMDLevel> &Level() noexcept
+{
+    static std::atomic<SIMDLevel> level(GetMaxSIMDLevel());
+    return level;
+}
+
+template <class T>
+void DispatchMinMax(const T *values, const size_t size, T &min,
+                    T &max) noexcept
+{
+    switch (Level().load(std::memory_order_relaxed))
+    {
+#ifdef ADIOS2_HELPER_SIMD_AVX512
+    case SIMDLevel::AVX512:
+        simd_avx512::MinMax(values, size, min, max);
+        return;
+#endif
+#ifdef ADIOS2_HELPER_SIMD_AVX2
+    case SIMDLevel::AVX2:
+        simd_avx2::MinMax(values, size, min, max);
+        return;
+#endif
+#ifdef ADIOS2_HAVE_SIMD
+    case SIMDLevel::SIMD128:
+        simd_128::MinMax(values, size, min, max);
+        return;
+#endif
+    default:
+        simd_scalar::MinMax(values, size, min, max);
+    }
+}
+
+template <class T>
+void DispatchMinMaxCopy(const T *values, const size_t size, char *destination,
+                        T &min, T &max, const bool nonTemporal) noexcept
+{
+    switch (Level().load(std::memory_order_relaxed))
+    {
+#ifdef ADIOS2_HELPER_SIMD_AVX512
+    case SIMDLevel::AVX512:
+        simd_avx512::MinMaxCopy(values, size, destination, min, max,
+                                nonTemporal);
+        return;
+#endif
+#ifdef ADIOS2_HELPER_SIMD_AVX2
+    case SIMDLevel::AVX2:
+        simd_avx2::MinMaxCopy(values, size, destination, min, max,
+                              nonTemporal);
+        return;
+#endif
+#ifdef ADIOS2_HAVE_SIMD
+    case SIMDLevel::SIMD128:
+        simd_128::MinMaxCopy(values, size, destination, min, max, nonTemporal);
+        return;
+#endif
+    default:
+        simd_scalar::MinMaxCopy(values, size, destination, min, max,
+                                nonTemporal);
+    }
+}
+
+template <class T>
+void DispatchSumSquares(const T *values, const size_t size, double &sum,
+                        double &sumSquares, size_t &count) noexcept
+{
+    switch (Level().load(std::memory_order_relaxed))
+    {
+#ifdef ADIOS2_HELPER_SIMD_AVX512
+    case SIMDLevel::AVX512:
+        simd_avx512::SumSquares(values, size, sum, sumSquares, count);
+        return;
+#endif
+#ifdef ADIOS2_HELPER_SIMD_AVX2
+    case SIMDLevel::AVX2:
+        simd_avx2::SumSquares(values, size, sum, sumSquares, count);
+        return;
+#endif
+#ifdef ADIOS2_HAVE_SIMD
+    case SIMDLevel::SIMD128:
+        simd_128::SumSquares(values, size, sum, sumSquares, count);
+        return;
+#endif
+    default:
+        simd_scalar::SumSquares(values, size, sum, sumSquares, count);
+    }
+}
+
+} // end anonymous namespace
+
+SIMDLevel GetMaxSIMDLevel() noexcept
+{
+    static const SIMDLevel maxLevel = DetectSIMDLevel();
+    return maxLevel;
+}
+
+SIMDLevel GetSIMDLevel() noexcept
+{
+    return Level().load(std::memory_order_relaxed);
+}
+
+void SetSIMDLevel(const SIMDLevel level)
+{
+    if (level > GetMaxSIMDLevel())
+    {
+        throw std::invalid_argument(
+            "ERROR: SIMD level " + ToString(level) +
+            " is not supported by this CPU or build, the maximum is " +
+            ToString(GetMaxSIMDLevel()) + ", in call to SetSIMDLevel\n");
+    }
+    Level().store(level);
+}
+
+std::string ToString(const SIMDLevel level)
+{
+    switch (level)
+    {
+    case SIMDLevel::Scalar:
+        return "scalar";
+    case SIMDLevel::SIMD128:
+        return "simd128";
+    case SIMDLevel::AVX2:
+        return "avx2";
+    case SIMDLevel::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+#define declare_type(T)                                                        \
+    void GetMinMaxSIMD(const T *values, const size_t size, T &min,             \
+                       T &max) noexcept                                        \
+    {                                                                          \
+        DispatchMinMax(values, size, min, max);                                \
+    }                                                                          \
+                                                                               \
+    void CopyMinMaxSIMD(const T *values, const size_t size, char *destination, \
+                        T &min, T &max, const bool nonTemporal) noexcept       \
+    {                                                                          \
+        DispatchMinMaxCopy(values, size, destination, min, max, nonTemporal);  \
+    }                                                                          \
+                                                                               \
+    void GetSumSquares(const T *values, const size_t size, double &sum,        \
+                       double &sumSquares, size_t &count) noexcept             \
+    {                                                                          \
+        DispatchSumSquares(values, size, sum, sumSquares, count);              \
+    }
+
+ADIOS2_FOREACH_SIMD_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+} // end namespace helper
+} // end namespace adios2
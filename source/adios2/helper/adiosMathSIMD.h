@@ -0,0 +1,86 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosMathSIMD.h vectorized statistics kernels used by helper::GetMinMax,
+ * dispatched at run time to the widest instruction set of the CPU
+ */
+
+#ifndef ADIOS2_HELPER_ADIOSMATHSIMD_H_
+#define ADIOS2_HELPER_ADIOSMATHSIMD_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <cstddef>
+#include <cstdint>
+#include <string>
+/// \endcond
+
+/** Types with vectorized kernels, other types use the generic templates */
+#define ADIOS2_FOREACH_SIMD_STDTYPE_1ARG(MACRO)                                \
+    MACRO(int8_t)                                                              \
+    MACRO(int16_t)                                                             \
+    MACRO(int32_t)                                                             \
+    MACRO(int64_t)                                                             \
+    MACRO(uint8_t)                                                             \
+    MACRO(uint16_t)                                                            \
+    MACRO(uint32_t)                                                            \
+    MACRO(uint64_t)                                                            \
+    MACRO(float)                                                               \
+    MACRO(double)
+
+namespace adios2
+{
+namespace helper
+{
+
+/** Instruction sets of the kernels, in increasing vector width */
+enum class SIMDLevel
+{
+    Scalar,  ///< plain loops, always available
+    SIMD128, ///< 128-bit vectors, SSE2 on x86-64, NEON on ARM64
+    AVX2,
+    AVX512 ///< AVX-512F and AVX-512BW
+};
+
+/** Widest level built into the library and supported by this CPU */
+SIMDLevel GetMaxSIMDLevel() noexcept;
+
+/** Level used by the kernels, GetMaxSIMDLevel() unless set */
+SIMDLevel GetSIMDLevel() noexcept;
+
+/**
+ * Forces the level used by the kernels in the process, for testing and
+ * benchmarks
+ * @throws std::invalid_argument if level > GetMaxSIMDLevel()
+ */
+void SetSIMDLevel(const SIMDLevel level);
+
+/** Name of level: "scalar", "simd128", "avx2", "avx512" */
+std::string ToString(const SIMDLevel level);
+
+/*
+ * GetMinMaxSIMD: min and max of values, left unchanged if size == 0.
+ * CopyMinMaxSIMD: GetMinMaxSIMD while copying the size values to destination
+ * in the same pass, which may be unaligned. nonTemporal: stores bypass the
+ * cache if supported, for copies larger than the last level cache.
+ * GetSumSquares: sum and sum of squares of the count non-NaN values,
+ * accumulated in double, the summation order depends on the level.
+ *
+ * float and double NaN values are skipped, min and max are NaN only if all
+ * values are NaN. The sign of a zero min or max is unspecified.
+ */
+#define declare_type(T)                                                        \
+    void GetMinMaxSIMD(const T *values, const size_t size, T &min,             \
+                       T &max) noexcept;                                       \
+    void CopyMinMaxSIMD(const T *values, const size_t size, char *destination, \
+                        T &min, T &max, const bool nonTemporal) noexcept;      \
+    void GetSumSquares(const T *values, const size_t size, double &sum,        \
+                       double &sumSquares, size_t &count) noexcept;
+
+ADIOS2_FOREACH_SIMD_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+} // end namespace helper
+} // end namespace adios2
+
+#endif /* ADIOS2_HELPER_ADIOSMATHSIMD_H_ */
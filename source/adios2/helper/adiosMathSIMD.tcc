@@ -0,0 +1,321 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosMathSIMD.tcc statistics kernels for one vector width, included once
+ * per instruction set after defining ADIOS2_SIMD_NAMESPACE and
+ * ADIOS2_SIMD_BYTES (0 for scalar loops). Vectors use the GCC/Clang vector
+ * extensions, so the same source is compiled to SSE2, AVX2, AVX-512 or NEON.
+ *
+ * Only builtins and the always inline x86 intrinsics are used here: an inline
+ * function from a library header compiled with e.g. -mavx2 could be picked by
+ * the linker for callers in other translation units running on CPUs without
+ * AVX2.
+ */
+
+#ifndef ADIOS2_SIMD_NAMESPACE
+#error "define ADIOS2_SIMD_NAMESPACE and ADIOS2_SIMD_BYTES before including"
+#endif
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+/// \endcond
+
+// non-temporal stores of the vector width, x86 only
+#if ADIOS2_SIMD_BYTES == 64 && defined(__AVX512F__) ||                         \
+    ADIOS2_SIMD_BYTES == 32 && defined(__AVX__) ||                             \
+    ADIOS2_SIMD_BYTES == 16 && defined(__SSE2__)
+#define ADIOS2_SIMD_STREAM 1
+#include <immintrin.h>
+#else
+#define ADIOS2_SIMD_STREAM 0
+#endif
+
+namespace adios2
+{
+namespace helper
+{
+namespace ADIOS2_SIMD_NAMESPACE
+{
+
+/** +inf for floating point types, max value for integers */
+template <class T>
+constexpr T MinStart() noexcept
+{
+    return std::numeric_limits<T>::has_infinity
+               ? std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::max();
+}
+
+/** -inf for floating point types, lowest value for integers */
+template <class T>
+constexpr T MaxStart() noexcept
+{
+    return std::numeric_limits<T>::has_infinity
+               ? -std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::lowest();
+}
+
+/** ignores the values, for MinMax */
+struct NoStore
+{
+    size_t Head(const size_t /*size*/) const noexcept { return 0; }
+
+    template <class V>
+    void operator()(const size_t /*i*/, const V & /*v*/) const noexcept
+    {
+    }
+
+    void Finish() const noexcept {}
+};
+
+/** copies the values to destination, for MinMaxCopy */
+template <class T>
+struct CopyStore
+{
+    char *destination;
+
+    size_t Head(const size_t /*size*/) const noexcept { return 0; }
+
+    /** V: T or a vector of T starting at element i */
+    template <class V>
+    void operator()(const size_t i, const V &v) const noexcept
+    {
+        __builtin_memcpy(destination + i * sizeof(T), &v, sizeof(V));
+    }
+
+    void Finish() const noexcept {}
+};
+
+#if ADIOS2_SIMD_STREAM
+/** copies the values to destination with non-temporal vector stores, which
+ * bypass the cache. Destination must be aligned to sizeof(T) */
+template <class T>
+struct StreamStore
+{
+    char *destination;
+
+    /** values stored as scalars until the vector stores are aligned */
+    size_t Head(const size_t size) const noexcept
+    {
+        const size_t misalignment =
+            reinterpret_cast<uintptr_t>(destination) % ADIOS2_SIMD_BYTES;
+        const size_t head =
+            (ADIOS2_SIMD_BYTES - misalignment) % ADIOS2_SIMD_BYTES / sizeof(T);
+        return head < size ? head : size;
+    }
+
+    /** V: T or a vector of T starting at element i */
+    template <class V>
+    void operator()(const size_t i, const V &v) const noexcept
+    {
+        Store(destination + i * sizeof(T), v,
+              std::integral_constant<bool, sizeof(V) == ADIOS2_SIMD_BYTES>());
+    }
+
+    template <class V>
+    static void Store(char *address, const V &v, std::false_type) noexcept
+    {
+        __builtin_memcpy(address, &v, sizeof(V));
+    }
+
+    template <class V>
+    static void Store(char *address, const V &v, std::true_type) noexcept
+    {
+#if ADIOS2_SIMD_BYTES == 64
+        __m512i bits;
+        __builtin_memcpy(&bits, &v, sizeof(bits));
+        _mm512_stream_si512(reinterpret_cast<__m512i *>(address), bits);
+#elif ADIOS2_SIMD_BYTES == 32
+        __m256i bits;
+        __builtin_memcpy(&bits, &v, sizeof(bits));
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(address), bits);
+#else
+        __m128i bits;
+        __builtin_memcpy(&bits, &v, sizeof(bits));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(address), bits);
+#endif
+    }
+
+    /** orders the non-temporal stores before later stores */
+    void Finish() const noexcept { _mm_sfence(); }
+};
+#endif
+
+/** min and max of values, each element or vector loaded is passed to store */
+template <class T, class Store>
+void MinMaxStore(const T *values, const size_t size, T &min, T &max,
+                 const Store &store) noexcept
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    // a NaN compares false, so it never replaces the running min/max.
+    // constexpr, so no library call is emitted here
+    constexpr T minStart = MinStart<T>();
+    constexpr T maxStart = MaxStart<T>();
+    T sMin = minStart;
+    T sMax = maxStart;
+    size_t i = 0;
+
+    for (const size_t head = store.Head(size); i < head; ++i)
+    {
+        const T value = values[i];
+        store(i, value);
+        sMin = value < sMin ? value : sMin;
+        sMax = value > sMax ? value : sMax;
+    }
+
+#if ADIOS2_SIMD_BYTES > 0
+    typedef T Vector __attribute__((vector_size(ADIOS2_SIMD_BYTES)));
+    constexpr size_t lanes = ADIOS2_SIMD_BYTES / sizeof(T);
+
+    if (size - i >= 2 * lanes)
+    {
+        // two accumulators each to hide the compare/blend latency
+        Vector min0, max0;
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            min0[l] = sMin;
+            max0[l] = sMax;
+        }
+        Vector min1 = min0;
+        Vector max1 = max0;
+
+        for (; i + 2 * lanes <= size; i += 2 * lanes)
+        {
+            Vector a, b;
+            __builtin_memcpy(&a, values + i, sizeof(Vector));
+            __builtin_memcpy(&b, values + i + lanes, sizeof(Vector));
+            store(i, a);
+            store(i + lanes, b);
+            min0 = a < min0 ? a : min0;
+            max0 = a > max0 ? a : max0;
+            min1 = b < min1 ? b : min1;
+            max1 = b > max1 ? b : max1;
+        }
+
+        min0 = min1 < min0 ? min1 : min0;
+        max0 = max1 > max0 ? max1 : max0;
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            sMin = min0[l] < sMin ? min0[l] : sMin;
+            sMax = max0[l] > sMax ? max0[l] : sMax;
+        }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        const T value = values[i];
+        store(i, value);
+        sMin = value < sMin ? value : sMin;
+        sMax = value > sMax ? value : sMax;
+    }
+    store.Finish();
+
+    // only if all values are NaN
+    if (sMin > sMax)
+    {
+        sMin = values[0];
+        sMax = values[0];
+    }
+
+    min = sMin;
+    max = sMax;
+}
+
+template <class T>
+void MinMax(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxStore(values, size, min, max, NoStore());
+}
+
+template <class T>
+void MinMaxCopy(const T *values, const size_t size, char *destination, T &min,
+                T &max, const bool nonTemporal) noexcept
+{
+#if ADIOS2_SIMD_STREAM
+    if (nonTemporal &&
+        reinterpret_cast<uintptr_t>(destination) % sizeof(T) == 0)
+    {
+        MinMaxStore(values, size, min, max, StreamStore<T>{destination});
+        return;
+    }
+#else
+    (void)nonTemporal;
+#endif
+    MinMaxStore(values, size, min, max, CopyStore<T>{destination});
+}
+
+template <class T>
+void SumSquares(const T *values, const size_t size, double &sum,
+                double &sumSquares, size_t &count) noexcept
+{
+    double sSum = 0;
+    double sSquares = 0;
+    size_t nans = 0;
+    size_t i = 0;
+
+#if ADIOS2_SIMD_BYTES > 0
+    typedef double Vector __attribute__((vector_size(ADIOS2_SIMD_BYTES)));
+    constexpr size_t lanes = ADIOS2_SIMD_BYTES / sizeof(double);
+
+    if (size >= lanes)
+    {
+        const Vector zero = {};
+        Vector vSum = zero;
+        Vector vSquares = zero;
+        // lanes are -1 where NaN, subtracted to count them
+        auto vNaNs = zero != zero;
+
+        for (; i + lanes <= size; i += lanes)
+        {
+            Vector v;
+            for (size_t l = 0; l < lanes; ++l)
+            {
+                v[l] = static_cast<double>(values[i + l]);
+            }
+            const auto isNaN = v != v;
+            v = isNaN ? zero : v;
+            vNaNs -= isNaN;
+            vSum += v;
+            vSquares += v * v;
+        }
+
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            sSum += vSum[l];
+            sSquares += vSquares[l];
+            nans += static_cast<size_t>(vNaNs[l]);
+        }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        const double value = static_cast<double>(values[i]);
+        if (value != value)
+        {
+            ++nans;
+            continue;
+        }
+        sSum += value;
+        sSquares += value * value;
+    }
+
+    sum = sSum;
+    sumSquares = sSquares;
+    count = size - nans;
+}
+
+} // end namespace ADIOS2_SIMD_NAMESPACE
+} // end namespace helper
+} // end namespace adios2
+
+#undef ADIOS2_SIMD_STREAM
@@ -0,0 +1,34 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosMathSIMDAVX2.cpp kernels of adiosMathSIMD.tcc compiled with the AVX2
+ * flags, only called by adiosMathSIMD.cpp if the CPU supports AVX2
+ */
+
+#include "adiosMathSIMD.h"
+
+#define ADIOS2_SIMD_NAMESPACE simd_avx2
+#define ADIOS2_SIMD_BYTES 32
+#include "adiosMathSIMD.tcc"
+
+namespace adios2
+{
+namespace helper
+{
+namespace simd_avx2
+{
+
+#define declare_template_instantiation(T)                                      \
+    template void MinMax(const T *, const size_t, T &, T &) noexcept;          \
+    template void MinMaxCopy(const T *, const size_t, char *, T &, T &,        \
+                             const bool) noexcept;                             \
+    template void SumSquares(const T *, const size_t, double &, double &,      \
+                             size_t &) noexcept;
+
+ADIOS2_FOREACH_SIMD_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+} // end namespace simd_avx2
+} // end namespace helper
+} // end namespace adios2
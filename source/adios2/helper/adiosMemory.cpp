@@ -11,8 +11,10 @@
 #include "adiosMemory.h"
 
 #include <algorithm>
+#include <cstring> // std::memcpy
 #include <stddef.h> // max_align_t
 
+#include "adios2/helper/adiosThreadPool.h"
 #include "adios2/helper/adiosType.h"
 
 namespace adios2
@@ -243,6 +245,137 @@ void ClipColumnMajor(char *dest, const Dims &destStart, const Dims &destCount,
     }
 }
 
+/** strides in bytes of each dimension of a box in memory */
+Dims MemoryStrides(const Dims &count, const bool isRowMajor,
+                   const size_t elementSize)
+{
+    const size_t dimensions = count.size();
+    Dims strides(dimensions);
+    size_t stride = elementSize;
+    for (size_t i = 0; i < dimensions; ++i)
+    {
+        const size_t d = isRowMajor ? dimensions - 1 - i : i;
+        strides[d] = stride;
+        stride *= count[d];
+    }
+    return strides;
+}
+
+/** copies a contiguous run of any size */
+struct CopyRun
+{
+    size_t RunSize;
+    void operator()(const char *in, char *out) const noexcept
+    {
+        std::memcpy(out, in, RunSize);
+    }
+};
+
+/** copies a run of N bytes, N known at compile time is a plain move */
+template <size_t N>
+struct CopyFixedRun
+{
+    void operator()(const char *in, char *out) const noexcept
+    {
+        std::memcpy(out, in, N);
+    }
+};
+
+/** reverses the bytes of each of the N bytes elements in a run */
+template <size_t N>
+struct ReverseRun
+{
+    size_t Elements;
+    void operator()(const char *in, char *out) const noexcept
+    {
+        // a fixed size byte permutation is vectorized by the compiler as
+        // a shuffle over several elements
+        for (size_t i = 0; i < Elements; ++i)
+        {
+            char element[N];
+            std::memcpy(element, in + i * N, N);
+            for (size_t j = 0; j < N; ++j)
+            {
+                out[i * N + j] = element[N - 1 - j];
+            }
+        }
+    }
+};
+
+/** ReverseRun for element sizes only known at run time */
+struct ReverseAnyRun
+{
+    size_t Elements;
+    size_t ElementSize;
+    void operator()(const char *in, char *out) const noexcept
+    {
+        for (size_t i = 0; i < Elements; ++i)
+        {
+            for (size_t j = 0; j < ElementSize; ++j)
+            {
+                out[j] = in[ElementSize - 1 - j];
+            }
+            in += ElementSize;
+            out += ElementSize;
+        }
+    }
+};
+
+/**
+ * Runs copyRun over a loop nest without recursion, offsets are updated
+ * by one addition per iteration whatever the number of loops
+ */
+template <class CopyRunFunction>
+void LoopNest(const char *in, char *out, const Dims &count,
+              const Dims &inStride, const Dims &outStride,
+              const CopyRunFunction &copyRun) noexcept
+{
+    if (count.empty())
+    {
+        copyRun(in, out);
+        return;
+    }
+
+    const size_t inner = count.size() - 1;
+    const size_t innerCount = count[inner];
+    const size_t innerInStride = inStride[inner];
+    const size_t innerOutStride = outStride[inner];
+    Dims position(inner, 0);
+    size_t inOffset = 0;
+    size_t outOffset = 0;
+
+    while (true)
+    {
+        const char *inRun = in + inOffset;
+        char *outRun = out + outOffset;
+        for (size_t i = 0; i < innerCount; ++i)
+        {
+            copyRun(inRun, outRun);
+            inRun += innerInStride;
+            outRun += innerOutStride;
+        }
+
+        size_t d = inner;
+        while (true)
+        {
+            if (d == 0)
+            {
+                return;
+            }
+            --d;
+            inOffset += inStride[d];
+            outOffset += outStride[d];
+            if (++position[d] < count[d])
+            {
+                break;
+            }
+            position[d] = 0;
+            inOffset -= count[d] * inStride[d];
+            outOffset -= count[d] * outStride[d];
+        }
+    }
+}
+
 } // end empty namespace
 
 void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
@@ -286,6 +419,237 @@ void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
     }
 }
 
+NdCopyPlan::NdCopyPlan(const Dims &inStart, const Dims &inCount,
+                       const bool inIsRowMajor, const bool inIsLittleEndian,
+                       const Dims &outStart, const Dims &outCount,
+                       const bool outIsRowMajor, const bool outIsLittleEndian,
+                       const size_t elementSize, const Dims &inMemStart,
+                       const Dims &inMemCount, const Dims &outMemStart,
+                       const Dims &outMemCount)
+: m_ElementSize(elementSize),
+  m_ReverseEndian(inIsLittleEndian != outIsLittleEndian)
+{
+    struct Loop
+    {
+        size_t Count;
+        size_t InStride;
+        size_t OutStride;
+    };
+
+    const Dims &inMemStartNC = inMemStart.empty() ? inStart : inMemStart;
+    const Dims &inMemCountNC = inMemCount.empty() ? inCount : inMemCount;
+    const Dims &outMemStartNC = outMemStart.empty() ? outStart : outMemStart;
+    const Dims &outMemCountNC = outMemCount.empty() ? outCount : outMemCount;
+
+    // all boxes are in the same dimension order, the major only sets
+    // which end of it is contiguous in memory
+    const Dims inStride =
+        MemoryStrides(inMemCountNC, inIsRowMajor, elementSize);
+    const Dims outStride =
+        MemoryStrides(outMemCountNC, outIsRowMajor, elementSize);
+
+    std::vector<Loop> loops;
+    loops.reserve(inStart.size());
+    for (size_t d = 0; d < inStart.size(); ++d)
+    {
+        const size_t start = std::max(inStart[d], outStart[d]);
+        const size_t end = std::min(inStart[d] + inCount[d],
+                                    outStart[d] + outCount[d]);
+        if (end <= start)
+        {
+            return; // no overlap
+        }
+        m_InOffset += (start - inMemStartNC[d]) * inStride[d];
+        m_OutOffset += (start - outMemStartNC[d]) * outStride[d];
+        if (end - start > 1)
+        {
+            loops.push_back({end - start, inStride[d], outStride[d]});
+        }
+    }
+    m_HasOverlap = true;
+
+    // output written in order, transposes read with strides instead
+    std::stable_sort(loops.begin(), loops.end(),
+                     [](const Loop &a, const Loop &b) {
+                         return a.OutStride > b.OutStride;
+                     });
+
+    // innermost loops contiguous on both sides become a single run
+    m_RunSize = elementSize;
+    while (!loops.empty() && loops.back().InStride == m_RunSize &&
+           loops.back().OutStride == m_RunSize)
+    {
+        m_RunSize *= loops.back().Count;
+        loops.pop_back();
+    }
+
+    // a loop continuing the next inner loop on both sides is merged with it
+    for (const Loop &loop : loops)
+    {
+        if (!m_Count.empty() &&
+            m_InStride.back() == loop.Count * loop.InStride &&
+            m_OutStride.back() == loop.Count * loop.OutStride)
+        {
+            m_Count.back() *= loop.Count;
+            m_InStride.back() = loop.InStride;
+            m_OutStride.back() = loop.OutStride;
+            continue;
+        }
+        m_Count.push_back(loop.Count);
+        m_InStride.push_back(loop.InStride);
+        m_OutStride.push_back(loop.OutStride);
+    }
+}
+
+bool NdCopyPlan::HasOverlap() const noexcept { return m_HasOverlap; }
+
+void NdCopyPlan::Execute(const char *in, char *out,
+                         const unsigned int threads) const noexcept
+{
+    if (!m_HasOverlap)
+    {
+        return;
+    }
+
+    in += m_InOffset;
+    out += m_OutOffset;
+
+    size_t elements = m_RunSize / m_ElementSize;
+    for (const size_t count : m_Count)
+    {
+        elements *= count;
+    }
+
+    if (threads <= 1 || elements < 1000000)
+    {
+        Run(in, out, m_Count, m_RunSize);
+        return;
+    }
+
+    if (m_Count.empty())
+    {
+        // a single run, split at element boundaries
+        ParallelFor(elements, threads,
+                    [&](const size_t, const size_t begin, const size_t end) {
+                        Run(in + begin * m_ElementSize,
+                            out + begin * m_ElementSize, m_Count,
+                            (end - begin) * m_ElementSize);
+                    });
+        return;
+    }
+
+    ParallelFor(m_Count.front(), threads,
+                [&](const size_t, const size_t begin, const size_t end) {
+                    Dims count(m_Count);
+                    count.front() = end - begin;
+                    Run(in + begin * m_InStride.front(),
+                        out + begin * m_OutStride.front(), count, m_RunSize);
+                });
+}
+
+void NdCopyPlan::Run(const char *in, char *out, const Dims &count,
+                     const size_t runSize) const noexcept
+{
+    if (!m_ReverseEndian || m_ElementSize == 1)
+    {
+        switch (runSize)
+        {
+        case 1:
+            LoopNest(in, out, count, m_InStride, m_OutStride,
+                     CopyFixedRun<1>());
+            break;
+        case 2:
+            LoopNest(in, out, count, m_InStride, m_OutStride,
+                     CopyFixedRun<2>());
+            break;
+        case 4:
+            LoopNest(in, out, count, m_InStride, m_OutStride,
+                     CopyFixedRun<4>());
+            break;
+        case 8:
+            LoopNest(in, out, count, m_InStride, m_OutStride,
+                     CopyFixedRun<8>());
+            break;
+        case 16:
+            LoopNest(in, out, count, m_InStride, m_OutStride,
+                     CopyFixedRun<16>());
+            break;
+        default:
+            LoopNest(in, out, count, m_InStride, m_OutStride,
+                     CopyRun{runSize});
+        }
+        return;
+    }
+
+    const size_t elements = runSize / m_ElementSize;
+    switch (m_ElementSize)
+    {
+    case 2:
+        LoopNest(in, out, count, m_InStride, m_OutStride,
+                 ReverseRun<2>{elements});
+        break;
+    case 4:
+        LoopNest(in, out, count, m_InStride, m_OutStride,
+                 ReverseRun<4>{elements});
+        break;
+    case 8:
+        LoopNest(in, out, count, m_InStride, m_OutStride,
+                 ReverseRun<8>{elements});
+        break;
+    case 16:
+        LoopNest(in, out, count, m_InStride, m_OutStride,
+                 ReverseRun<16>{elements});
+        break;
+    default:
+        LoopNest(in, out, count, m_InStride, m_OutStride,
+                 ReverseAnyRun{elements, m_ElementSize});
+    }
+}
+
+void NdCopyPlanCache::Rewind() noexcept { m_Next = 0; }
+
+const NdCopyPlan &NdCopyPlanCache::Get(
+    const Dims &inStart, const Dims &inCount, const bool inIsRowMajor,
+    const bool inIsLittleEndian, const Dims &outStart, const Dims &outCount,
+    const bool outIsRowMajor, const bool outIsLittleEndian,
+    const size_t elementSize, const Dims &inMemStart, const Dims &inMemCount,
+    const Dims &outMemStart, const Dims &outMemCount)
+{
+    auto lf_Append = [](Dims &key, const Dims &dimensions) {
+        key.push_back(dimensions.size());
+        key.insert(key.end(), dimensions.begin(), dimensions.end());
+    };
+
+    m_Key.clear();
+    m_Key.push_back(elementSize);
+    m_Key.push_back(inIsRowMajor + 2 * inIsLittleEndian + 4 * outIsRowMajor +
+                    8 * outIsLittleEndian);
+    lf_Append(m_Key, inStart);
+    lf_Append(m_Key, inCount);
+    lf_Append(m_Key, outStart);
+    lf_Append(m_Key, outCount);
+    lf_Append(m_Key, inMemStart);
+    lf_Append(m_Key, inMemCount);
+    lf_Append(m_Key, outMemStart);
+    lf_Append(m_Key, outMemCount);
+
+    if (m_Next == m_Entries.size())
+    {
+        m_Entries.emplace_back();
+    }
+    Entry &entry = m_Entries[m_Next++];
+    if (entry.Key != m_Key)
+    {
+        entry.Plan = NdCopyPlan(inStart, inCount, inIsRowMajor,
+                                inIsLittleEndian, outStart, outCount,
+                                outIsRowMajor, outIsLittleEndian, elementSize,
+                                inMemStart, inMemCount, outMemStart,
+                                outMemCount);
+        entry.Key.swap(m_Key);
+    }
+    return entry.Plan;
+}
+
 size_t PaddingToAlignPointer(const void *ptr)
 {
     auto memLocation = reinterpret_cast<std::uintptr_t>(ptr);
@@ -59,7 +59,7 @@ void CopyToBuffer(std::vector<char> &buffer, size_t &position, const T *source,
  * @param position starting position in buffer (in terms of T not bytes)
  * @param source pointer to source data
  * @param elements number of elements of source type
- * @param threads number of threads sharing the copy load
+ * @param threads maximum number of pool threads sharing the copy load
  */
 template <class T>
 void CopyToBufferThreads(std::vector<char> &buffer, size_t &position,
@@ -151,6 +151,8 @@ void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
  * @param isRowMajor true: contiguous data is row major, false: column major
  * @param reverseDimensions true: data and contiguousMemory have different
  * ordering column/row or row/column major, respectively.
+ * @param threads splitting intersections of at least 1M elements along their
+ * slowest dimension in the stored block
  */
 template <class T>
 void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
@@ -159,7 +161,8 @@ void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
                           const Box<Dims> &intersectionBox,
                           const bool isRowMajor = true,
                           const bool reverseDimensions = false,
-                          const bool endianReverse = false);
+                          const bool endianReverse = false,
+                          const unsigned int threads = 1);
 
 template <class T>
 void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
@@ -168,7 +171,8 @@ void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
                           const Box<Dims> &intersectionBox,
                           const bool isRowMajor = true,
                           const bool reverseDimensions = false,
-                          const bool endianReverse = false);
+                          const bool endianReverse = false,
+                          const unsigned int threads = 1);
 
 template <class T>
 void CopyContiguousMemory(const char *src, const size_t stride, T *dest,
@@ -189,22 +193,109 @@ template <class T>
 void Resize(std::vector<T> &vec, const size_t dataSize, const std::string hint,
             T value = T());
 
+/**
+ * Copy of the overlap of two n-dimensional boxes, computed once from the
+ * arguments of NdCopy and executed as a flat loop nest, without recursion.
+ * The innermost dimensions contiguous in both buffers are copied as a single
+ * run, dimensions whose runs follow each other are merged into one loop.
+ * A plan does not depend on the in and out pointers, it can be kept and
+ * executed again while selections repeat, see NdCopyPlanCache.
+ */
+class NdCopyPlan
+{
+public:
+    NdCopyPlan() = default;
+
+    /**
+     * Computes the copy, parameters as in NdCopy
+     * @param elementSize bytes of each element, reversed as a whole if the
+     * endianness of in and out differ
+     */
+    NdCopyPlan(const Dims &inStart, const Dims &inCount,
+               const bool inIsRowMajor, const bool inIsLittleEndian,
+               const Dims &outStart, const Dims &outCount,
+               const bool outIsRowMajor, const bool outIsLittleEndian,
+               const size_t elementSize, const Dims &inMemStart = Dims(),
+               const Dims &inMemCount = Dims(),
+               const Dims &outMemStart = Dims(),
+               const Dims &outMemCount = Dims());
+
+    /** @return false if in and out do not overlap, nothing is copied */
+    bool HasOverlap() const noexcept;
+
+    /**
+     * Copies the overlap
+     * @param in pointer to source memory buffer, see NdCopy
+     * @param out pointer to destination memory buffer
+     * @param threads splitting copies of at least 1M elements along the
+     * outermost loop, or the run if there is no loop
+     */
+    void Execute(const char *in, char *out,
+                 const unsigned int threads = 1) const noexcept;
+
+private:
+    /** loops from outermost to innermost, strides in bytes */
+    Dims m_Count;
+    Dims m_InStride;
+    Dims m_OutStride;
+    size_t m_InOffset = 0;
+    size_t m_OutOffset = 0;
+    /** contiguous bytes copied in each iteration of the innermost loop */
+    size_t m_RunSize = 0;
+    size_t m_ElementSize = 0;
+    bool m_ReverseEndian = false;
+    bool m_HasOverlap = false;
+
+    /** runs the loop nest count with runs of runSize bytes from in, out */
+    void Run(const char *in, char *out, const Dims &count,
+             const size_t runSize) const noexcept;
+};
+
+/**
+ * Plans of a sequence of copies repeated every step, e.g. the blocks read
+ * with locked selections. Get returns the plan of the previous sequence at
+ * the same position when the arguments are the same, a new plan otherwise.
+ */
+class NdCopyPlanCache
+{
+public:
+    /** Starts a new sequence of Get calls */
+    void Rewind() noexcept;
+
+    /** @return the plan for the NdCopyPlan arguments, valid until next Get */
+    const NdCopyPlan &Get(const Dims &inStart, const Dims &inCount,
+                          const bool inIsRowMajor, const bool inIsLittleEndian,
+                          const Dims &outStart, const Dims &outCount,
+                          const bool outIsRowMajor,
+                          const bool outIsLittleEndian,
+                          const size_t elementSize,
+                          const Dims &inMemStart = Dims(),
+                          const Dims &inMemCount = Dims(),
+                          const Dims &outMemStart = Dims(),
+                          const Dims &outMemCount = Dims());
+
+private:
+    struct Entry
+    {
+        Dims Key;
+        NdCopyPlan Plan;
+    };
+    std::vector<Entry> m_Entries;
+    size_t m_Next = 0;
+    Dims m_Key;
+};
+
 /**
  * Author:Shawn Yang, shawnyang610@gmail.com
  * Copies n-dimensional Data from a source buffer to destination buffer, either
  * can be of any Major and Endianess. Return 1 if no overlap is found.
+ * All boxes are given in the same dimension order, the Major of each buffer
+ * sets which end of it is contiguous in memory.
  * Copying from row-major to row-major of the same endian yields the best speed.
- * Optimizations: first: looks for the largest contiguous data
- * block size and copies the block of data as a whole. Second: by using
- * depth-first traversal for dynamic memory pointer calculations.
- * address calculation for each copied block is reduced to O(1) from O(n).
- * which means the computational cost is drastically reduced for data of higher
- * dimensions.
- * For copying involving column major, or different endianess only the
- * second optimization is applied.
- * Note: in case of super high dimensional data(over 10000 dimensions),
- * function stack may run out, set safeMode=true to switch to iterative
- * algms(a little slower due to explicit stack running less efficiently).
+ * Builds a NdCopyPlan and executes it: the largest contiguous data block is
+ * copied as a whole, and the address of each block is updated in O(1)
+ * independently of the number of dimensions, without recursion. Use a
+ * NdCopyPlan directly to reuse it for repeated copies.
  * @param in pointer to source memory buffer
  * @param inStart source data starting offset
  * @param inCount source data structure
@@ -219,10 +310,8 @@ void Resize(std::vector<T> &vec, const size_t dataSize, const std::string hint,
  * @param inMemCount source memory structure
  * @param outMemStart destination request data starting offset
  * @param outMemCount destination request data structure
- * @param safeMode false:runs faster, the number of function stacks
- *                 used by recursive algm is equal to the number of dimensions.
- *                 true: runs a bit slower, same algorithm using the explicit
- *                 stack/simulated stack which has more overhead for the algm.
+ * @param safeMode unused, kept for compatibility: copies no longer recurse
+ * @param threads for large copies, see NdCopyPlan::Execute
  */
 
 template <class T>
@@ -231,7 +320,8 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
            const Dims &outStart, const Dims &outCount, const bool outIsRowMajor,
            const bool outIsLittleEndian, const Dims &inMemStart = Dims(),
            const Dims &inMemCount = Dims(), const Dims &outMemStart = Dims(),
-           const Dims &outMemCount = Dims(), const bool safeMode = false);
+           const Dims &outMemCount = Dims(), const bool safeMode = false,
+           const unsigned int threads = 1);
 
 template <class T>
 size_t PayloadSize(const T *data, const Dims &count) noexcept;
@@ -25,6 +25,11 @@
 #include "adios2/toolkit/transportman/TransportMan.h"
 #include <cstring>
 
+// needed by FileSystemStripeCount()
+#ifdef __linux__
+#include <sys/xattr.h>
+#endif
+
 // remove ctime warning on Windows
 #ifdef _WIN32
 #pragma warning(disable : 4996) // ctime warning
@@ -161,5 +166,43 @@ bool IsHDF5File(const std::string &name, helper::Comm &comm,
     return (flag == 1);
 }
 
+size_t FileSystemStripeCount(const std::string &name,
+                             helper::Comm const &comm) noexcept
+{
+    size_t stripeCount = 0;
+#ifdef __linux__
+    if (!comm.Rank())
+    {
+        std::string directory = adios2sys::SystemTools::GetFilenamePath(name);
+        if (directory.empty())
+        {
+            directory = ".";
+        }
+
+        // struct lov_user_md v1 and v3 share the first 32 bytes:
+        // magic(4), pattern(4), object id(16), stripe size(4),
+        // stripe count(2), stripe offset(2)
+        char layout[256];
+        const ssize_t bytes = getxattr(directory.c_str(), "lustre.lov", layout,
+                                       sizeof(layout));
+        if (bytes >= 32)
+        {
+            uint32_t magic = 0;
+            uint16_t count = 0;
+            std::memcpy(&magic, layout, sizeof(magic));
+            std::memcpy(&count, layout + 28, sizeof(count));
+            // LOV_USER_MAGIC_V1, LOV_USER_MAGIC_V3
+            // count 0xFFFF (-1): stripe over all targets, unknown here
+            if ((magic == 0x0BD10BD0 || magic == 0x0BD30BD0) &&
+                count != 0xFFFF)
+            {
+                stripeCount = static_cast<size_t>(count);
+            }
+        }
+    }
+#endif
+    return comm.BroadcastValue(stripeCount);
+}
+
 } // end namespace helper
 } // end namespace adios2
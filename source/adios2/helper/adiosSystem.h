@@ -78,6 +78,17 @@ int ExceptionToError(const std::string &function);
 bool IsHDF5File(const std::string &name, helper::Comm &comm,
                 const std::vector<Params> &transportsParameters) noexcept;
 
+/**
+ * Number of storage targets a new file is striped over in the directory
+ * containing name, queried by rank 0 and broadcast to all ranks in comm.
+ * Only Lustre default layouts are recognized (lustre.lov extended attribute)
+ * @param name file or directory to be created
+ * @param comm ranks that need the stripe count
+ * @return stripe count, 0: unknown or not a striped file system
+ */
+size_t FileSystemStripeCount(const std::string &name,
+                             helper::Comm const &comm) noexcept;
+
 } // end namespace helper
 } // end namespace adios2
 
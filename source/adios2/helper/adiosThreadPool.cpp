@@ -0,0 +1,249 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosThreadPool.cpp
+ */
+
+#include "adiosThreadPool.h"
+
+#include <algorithm> //std::min
+#include <exception>
+
+namespace adios2
+{
+namespace helper
+{
+
+namespace
+{
+std::mutex PoolMutex;
+std::weak_ptr<ThreadPool> Pool;
+
+/** queue owned by the current thread if it is a worker of pool */
+thread_local const ThreadPool *WorkerPool = nullptr;
+thread_local size_t WorkerIndex = 0;
+} // end anonymous namespace
+
+ThreadPool::ThreadPool(const unsigned int threads)
+: m_Threads(std::max(threads, 1u)), m_Queued(0), m_NextQueue(0)
+{
+    for (unsigned int i = 1; i < m_Threads; ++i)
+    {
+        m_Queues.emplace_back(new Queue());
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+    for (auto &worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::Size() const noexcept { return m_Threads; }
+
+void ThreadPool::ParallelFor(
+    const size_t size, const size_t chunks,
+    const std::function<void(size_t, size_t, size_t)> &task)
+{
+    const size_t n = std::min(chunks, size);
+    auto lf_Begin = [&](const size_t chunk) { return chunk * size / n; };
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    if (n == 1 || m_Threads == 1)
+    {
+        for (size_t c = 0; c < n; ++c)
+        {
+            task(c, lf_Begin(c), lf_Begin(c + 1));
+        }
+        return;
+    }
+
+    std::call_once(m_StartFlag, &ThreadPool::Start, this);
+
+    std::atomic<size_t> remaining(n - 1);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto lf_Run = [&](const size_t chunk) {
+        try
+        {
+            task(chunk, lf_Begin(chunk), lf_Begin(chunk + 1));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    for (size_t c = 1; c < n; ++c)
+    {
+        Push([&, c]() {
+            lf_Run(c);
+            --remaining;
+        });
+    }
+
+    lf_Run(0);
+
+    // help with queued tasks, possibly from other loops, until ours are done
+    while (remaining > 0)
+    {
+        if (!RunOne())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::Acquire(const unsigned int threads)
+{
+    std::lock_guard<std::mutex> lock(PoolMutex);
+    std::shared_ptr<ThreadPool> pool = Pool.lock();
+    if (!pool)
+    {
+        pool = std::make_shared<ThreadPool>(threads);
+        Pool = pool;
+    }
+    return pool;
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::Current() noexcept
+{
+    std::lock_guard<std::mutex> lock(PoolMutex);
+    return Pool.lock();
+}
+
+// PRIVATE
+void ThreadPool::Start()
+{
+    for (size_t i = 0; i < m_Queues.size(); ++i)
+    {
+        m_Workers.emplace_back(&ThreadPool::Worker, this, i);
+    }
+}
+
+void ThreadPool::Push(std::function<void()> task)
+{
+    // workers keep adding to their own queue, other threads spread tasks
+    const size_t index = (WorkerPool == this)
+                             ? WorkerIndex
+                             : m_NextQueue++ % m_Queues.size();
+    // counted before it can be taken, so m_Queued never underflows
+    ++m_Queued;
+    {
+        Queue &queue = *m_Queues[index];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+    }
+    m_Wake.notify_one();
+}
+
+bool ThreadPool::RunOne()
+{
+    if (m_Queued == 0)
+    {
+        return false;
+    }
+
+    const size_t queues = m_Queues.size();
+    const bool isWorker = (WorkerPool == this);
+    const size_t first = isWorker ? WorkerIndex : 0;
+
+    for (size_t i = 0; i < queues; ++i)
+    {
+        const size_t index = (first + i) % queues;
+        Queue &queue = *m_Queues[index];
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (queue.Tasks.empty())
+            {
+                continue;
+            }
+            // newest task from the own queue, oldest when stealing
+            if (isWorker && index == WorkerIndex)
+            {
+                task = std::move(queue.Tasks.back());
+                queue.Tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.Tasks.front());
+                queue.Tasks.pop_front();
+            }
+        }
+        --m_Queued;
+        task();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::Worker(const size_t index)
+{
+    WorkerPool = this;
+    WorkerIndex = index;
+
+    while (true)
+    {
+        if (RunOne())
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_Wake.wait(lock, [this]() { return m_Stop || m_Queued > 0; });
+        if (m_Stop)
+        {
+            return;
+        }
+    }
+}
+
+void ParallelFor(const size_t size, const size_t chunks,
+                 const std::function<void(size_t, size_t, size_t)> &task)
+{
+    std::shared_ptr<ThreadPool> pool;
+    if (chunks > 1 && size > 1)
+    {
+        pool = ThreadPool::Current();
+    }
+
+    if (pool)
+    {
+        pool->ParallelFor(size, chunks, task);
+        return;
+    }
+
+    const size_t n = std::min(chunks, size);
+    for (size_t c = 0; c < n; ++c)
+    {
+        task(c, c * size / n, (c + 1) * size / n);
+    }
+}
+
+} // end namespace helper
+} // end namespace adios2
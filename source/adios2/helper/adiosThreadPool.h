@@ -0,0 +1,105 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosThreadPool.h process-wide pool of worker threads for intra-node
+ * parallel loops
+ */
+
+#ifndef ADIOS2_HELPER_ADIOSTHREADPOOL_H_
+#define ADIOS2_HELPER_ADIOSTHREADPOOL_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+/// \endcond
+
+namespace adios2
+{
+namespace helper
+{
+
+/**
+ * Work-stealing pool shared by all core::ADIOS objects of a process. Each
+ * worker owns a task queue and takes tasks from other queues when its own is
+ * empty. A thread waiting for its tasks runs queued tasks meanwhile, so
+ * ParallelFor may be nested. Workers are started at the first parallel loop.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @param threads running a loop, including the calling thread, a pool of
+     * size 1 runs everything serially
+     */
+    explicit ThreadPool(const unsigned int threads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /** Number of threads running a loop, including the calling thread */
+    unsigned int Size() const noexcept;
+
+    /**
+     * Splits [0, size) in min(chunks, size) contiguous ranges of nearly equal
+     * length and runs task(chunk, begin, end) for each of them, returning when
+     * all are done. The first exception thrown by a task is rethrown.
+     */
+    void ParallelFor(
+        const size_t size, const size_t chunks,
+        const std::function<void(size_t, size_t, size_t)> &task);
+
+    /**
+     * Returns the process pool, creating it with threads if no core::ADIOS
+     * object holds it
+     */
+    static std::shared_ptr<ThreadPool> Acquire(const unsigned int threads);
+
+    /** Returns the process pool, nullptr if no core::ADIOS object holds it */
+    static std::shared_ptr<ThreadPool> Current() noexcept;
+
+private:
+    struct Queue
+    {
+        std::mutex Mutex;
+        std::deque<std::function<void()>> Tasks;
+    };
+
+    const unsigned int m_Threads;
+    std::vector<std::unique_ptr<Queue>> m_Queues;
+    std::vector<std::thread> m_Workers;
+    std::once_flag m_StartFlag;
+
+    /** tasks pushed and not yet taken by any thread */
+    std::atomic<size_t> m_Queued;
+    std::atomic<size_t> m_NextQueue;
+    bool m_Stop = false;
+    std::mutex m_SleepMutex;
+    std::condition_variable m_Wake;
+
+    void Start();
+    void Push(std::function<void()> task);
+    /** runs one queued task, own queue first, returns false if none */
+    bool RunOne();
+    void Worker(const size_t index);
+};
+
+/**
+ * Runs ThreadPool::ParallelFor on the process pool, or serially in the calling
+ * thread, chunk by chunk, if there is no pool
+ */
+void ParallelFor(const size_t size, const size_t chunks,
+                 const std::function<void(size_t, size_t, size_t)> &task);
+
+} // end namespace helper
+} // end namespace adios2
+
+#endif /* ADIOS2_HELPER_ADIOSTHREADPOOL_H_ */
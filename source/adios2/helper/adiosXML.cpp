@@ -32,7 +32,8 @@ namespace helper
 void ParseConfigXML(
     core::ADIOS &adios, const std::string &configFileXML,
     std::map<std::string, core::IO> &ios,
-    std::map<std::string, std::shared_ptr<core::Operator>> &operators)
+    std::map<std::string, std::shared_ptr<core::Operator>> &operators,
+    Params &parameters)
 {
     const std::string hint("for config file " + configFileXML +
                            " in call to ADIOS constructor");
@@ -191,6 +192,9 @@ void ParseConfigXML(
     const std::unique_ptr<pugi::xml_node> config =
         helper::XMLNode("adios-config", *document, hint, true);
 
+    // adios-level parameters, e.g. ThreadPoolSize
+    parameters = helper::XMLGetParameters(*config, hint);
+
     for (const pugi::xml_node &op : config->children("operator"))
     {
         lf_OperatorXML(op);
@@ -26,10 +26,15 @@ namespace adios2
 namespace helper
 {
 
+/**
+ * Parses the config file, defining its io and operator nodes
+ * @param parameters output adios-level parameters found in the file
+ */
 void ParseConfigXML(
     core::ADIOS &adios, const std::string &configFile,
     std::map<std::string, core::IO> &ios,
-    std::map<std::string, std::shared_ptr<core::Operator>> &operators);
+    std::map<std::string, std::shared_ptr<core::Operator>> &operators,
+    Params &parameters);
 
 } // end namespace helper
 } // end namespace adios2
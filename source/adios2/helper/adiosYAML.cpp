@@ -67,7 +67,8 @@ Params YAMLNodeMapToParams(const YAML::Node &node, const std::string &hint)
 void ParseConfigYAML(
     core::ADIOS &adios, const std::string &configFileYAML,
     std::map<std::string, core::IO> &ios,
-    std::map<std::string, std::shared_ptr<core::Operator>> &operators)
+    std::map<std::string, std::shared_ptr<core::Operator>> &operators,
+    Params &parameters)
 {
     const std::string hint = "when parsing config file " + configFileYAML +
                              " in call to ADIOS constructor";
@@ -202,6 +203,14 @@ void ParseConfigYAML(
             const std::string ioName = ioScalar.as<std::string>();
             lf_IOYAML(ioName, *itNode);
         }
+
+        // adios-level parameters, e.g. ThreadPoolSize
+        const YAML::Node parametersMap = YAMLNode(
+            "Parameters", *itNode, hint, isNotMandatory, YAML::NodeType::Map);
+        if (parametersMap && !ioScalar)
+        {
+            parameters = YAMLNodeMapToParams(parametersMap, hint);
+        }
     }
 }
 
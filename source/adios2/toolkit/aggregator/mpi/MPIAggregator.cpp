@@ -33,6 +33,8 @@ void MPIAggregator::Init(const size_t subStreams,
 {
 }
 
+int MPIAggregator::ExchangeSteps() const noexcept { return m_Size; }
+
 void MPIAggregator::SwapBuffers(const int step) noexcept {}
 
 void MPIAggregator::ResetBuffers() noexcept {}
@@ -96,36 +98,88 @@ void MPIAggregator::InitComm(const size_t subStreams,
     m_SubStreams = subStreams;
 }
 
-void MPIAggregator::InitCommOnePerNode(helper::Comm const &parentComm)
+void MPIAggregator::InitCommPerNode(helper::Comm const &parentComm)
 {
-    m_Comm = parentComm.GroupByShm("creating default aggregator setup at Open");
-    m_Rank = m_Comm.Rank();
-    m_Size = m_Comm.Size();
-
-    if (m_Rank != 0)
-    {
-        m_IsConsumer = false;
-    }
-
-    m_IsActive = true;
-
-    /* Determine number of aggregators (= nodes) */
+    helper::Comm nodeComm =
+        parentComm.GroupByShm("creating default aggregator setup at Open");
+    const int nodeRank = nodeComm.Rank();
+    const size_t nodeSize = static_cast<size_t>(nodeComm.Size());
 
     /*
      *  Communicators connecting rank N of each node
      *  We are only interested in the chain of rank 0s
      */
-    int color = (m_Rank ? 1 : 0);
+    int color = (nodeRank ? 1 : 0);
     helper::Comm onePerNodeComm =
         parentComm.Split(color, 0, "creating default aggregator setup at Open");
 
-    if (!m_Rank)
+    size_t nodes = 0;
+    if (!nodeRank)
+    {
+        nodes = static_cast<size_t>(onePerNodeComm.Size());
+    }
+    nodes = nodeComm.BroadcastValue<size_t>(nodes, 0);
+
+    /* Aggregators in this node: as requested, or enough for the whole job
+     * to write one file per storage target */
+    size_t groups = m_AggregatorsPerNode;
+    if (groups == 0)
+    {
+        groups = (m_StripeCount > 0) ? (m_StripeCount + nodes - 1) / nodes : 1;
+    }
+    if (groups > nodeSize)
+    {
+        groups = nodeSize;
+    }
+
+    /* Divide the node ranks into groups, as InitComm does with all ranks */
+    const size_t process = static_cast<size_t>(nodeRank);
+    const size_t q = nodeSize / groups;
+    const size_t r = nodeSize % groups;
+    const size_t firstInSmallGroups = r * (q + 1);
+    const size_t group = (process >= firstInSmallGroups)
+                             ? r + (process - firstInSmallGroups) / q
+                             : process / (q + 1);
+
+    /* Determine number of aggregators and the first one of this node */
+    size_t firstSubStream = 0;
+    if (!nodeRank)
     {
-        m_SubStreamIndex = static_cast<size_t>(onePerNodeComm.Rank());
-        m_SubStreams = static_cast<size_t>(onePerNodeComm.Size());
+        const std::vector<size_t> nodeGroups =
+            onePerNodeComm.AllGatherValues(groups);
+        const size_t node = static_cast<size_t>(onePerNodeComm.Rank());
+        for (size_t n = 0; n < nodeGroups.size(); ++n)
+        {
+            if (n < node)
+            {
+                firstSubStream += nodeGroups[n];
+            }
+            m_SubStreams += nodeGroups[n];
+        }
     }
-    m_SubStreams = m_Comm.BroadcastValue<size_t>(m_SubStreams, 0);
-    m_SubStreamIndex = m_Comm.BroadcastValue<size_t>(m_SubStreamIndex, 0);
+    m_SubStreams = nodeComm.BroadcastValue<size_t>(m_SubStreams, 0);
+    firstSubStream = nodeComm.BroadcastValue<size_t>(firstSubStream, 0);
+    m_SubStreamIndex = firstSubStream + group;
+
+    if (groups == 1)
+    {
+        m_Comm = std::move(nodeComm);
+    }
+    else
+    {
+        m_Comm = nodeComm.Split(static_cast<int>(group), nodeRank,
+                                "creating aggregators comm in node at Open");
+    }
+
+    m_Rank = m_Comm.Rank();
+    m_Size = m_Comm.Size();
+
+    if (m_Rank != 0)
+    {
+        m_IsConsumer = false;
+    }
+
+    m_IsActive = true;
 
     /* Identify parent rank of aggregator process within each group */
     if (!m_Rank)
@@ -146,5 +200,26 @@ void MPIAggregator::HandshakeRank(const int rank)
     m_Comm.Bcast(&message, 1, rank, "handshake with aggregator rank 0 at Open");
 }
 
+void MPIAggregator::ResizeUpdateBuffer(const size_t newSize,
+                                       format::Buffer &buffer,
+                                       const std::string hint)
+{
+    if (buffer.m_FixedSize > 0)
+    {
+        if (newSize > buffer.m_FixedSize)
+        {
+            throw std::invalid_argument(
+                "ERROR: requesting new size: " + std::to_string(newSize) +
+                " bytes, for fixed size buffer " +
+                std::to_string(buffer.m_FixedSize) + " of type " +
+                buffer.m_Type + ", allocate more memory\n");
+        }
+        return; // do nothing if fixed size is enough
+    }
+
+    buffer.Resize(newSize, hint);
+    buffer.m_Position = newSize;
+}
+
 } // end namespace aggregator
 } // end namespace adios2
@@ -53,12 +53,28 @@ public:
      *  corresponds to m_Rank = 0 */
     int m_ConsumerRank = -1;
 
+    /** aggregators in each compute node when Init gets subStreams = 0,
+     *  0: derived from m_StripeCount */
+    size_t m_AggregatorsPerNode = 1;
+
+    /** storage targets the output is striped over, 0: unknown, used if
+     *  m_AggregatorsPerNode = 0 */
+    size_t m_StripeCount = 0;
+
     MPIAggregator();
 
     virtual ~MPIAggregator();
 
     virtual void Init(const size_t subStreams, helper::Comm const &parentComm);
 
+    /**
+     * Number of exchange steps in one aggregation, engines call IExchange,
+     * IExchangeAbsolutePosition, GetConsumerBuffer, the Wait functions and
+     * SwapBuffers for each step from 0 to ExchangeSteps()-1
+     * @return m_Size as default, one step per process in m_Comm
+     */
+    virtual int ExchangeSteps() const noexcept;
+
     struct ExchangeRequests
     {
         helper::Comm::Req m_SendSize;
@@ -91,20 +107,30 @@ public:
     virtual format::Buffer &GetConsumerBuffer(format::Buffer &buffer);
 
     /** closes current aggregator, frees m_Comm */
-    void Close();
+    virtual void Close();
 
 protected:
     /** Init m_Comm splitting assigning ranks to subStreams (balanced except for
      * the last rank) */
     void InitComm(const size_t subStreams, helper::Comm const &parentComm);
 
-    /** A default init function to select one process per node to be aggregator
+    /** A default init function to select m_AggregatorsPerNode processes per
+     * node to be aggregators, each for a contiguous range of the node's ranks
      */
-    void InitCommOnePerNode(helper::Comm const &parentComm);
+    void InitCommPerNode(helper::Comm const &parentComm);
 
     /** handshakes a single rank with the rest of the m_Comm ranks */
     void HandshakeRank(const int rank = 0);
 
+    /**
+     * Resizes and updates m_Position in a buffer, used for receiving buffers
+     * @param newSize new size for receiving buffer
+     * @param buffer to be resized
+     * @param hint used in exception error message
+     */
+    void ResizeUpdateBuffer(const size_t newSize, format::Buffer &buffer,
+                            const std::string hint);
+
     /** assigning extra buffers for aggregation */
     std::vector<std::unique_ptr<format::Buffer>> m_Buffers;
 };
@@ -27,7 +27,7 @@ void MPIChain::Init(const size_t subStreams, helper::Comm const &parentComm)
     }
     else
     {
-        InitCommOnePerNode(parentComm);
+        InitCommPerNode(parentComm);
     }
 
     HandshakeLinks();
@@ -273,25 +273,5 @@ format::Buffer &MPIChain::GetReceiver(format::Buffer &buffer)
     }
 }
 
-void MPIChain::ResizeUpdateBuffer(const size_t newSize, format::Buffer &buffer,
-                                  const std::string hint)
-{
-    if (buffer.m_FixedSize > 0)
-    {
-        if (newSize > buffer.m_FixedSize)
-        {
-            throw std::invalid_argument(
-                "ERROR: requesting new size: " + std::to_string(newSize) +
-                " bytes, for fixed size buffer " +
-                std::to_string(buffer.m_FixedSize) + " of type " +
-                buffer.m_Type + ", allocate more memory\n");
-        }
-        return; // do nothing if fixed size is enough
-    }
-
-    buffer.Resize(newSize, hint);
-    buffer.m_Position = newSize;
-}
-
 } // end namespace aggregator
 } // end namespace adios2
@@ -73,15 +73,6 @@ private:
      * @return reference to receiver buffer
      */
     format::Buffer &GetReceiver(format::Buffer &buffer);
-
-    /**
-     * Resizes and updates m_Position in a buffer, used for receiving buffers
-     * @param newSize new size for receiving buffer
-     * @param buffer to be resized
-     * @param hint used in exception error message
-     */
-    void ResizeUpdateBuffer(const size_t newSize, format::Buffer &buffer,
-                            const std::string hint);
 };
 
 } // end namespace aggregator
@@ -0,0 +1,206 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPIShm.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+#include "MPIShm.h"
+
+#include <cstring>   //std::memcpy
+#include <stdexcept> //std::invalid_argument
+
+namespace adios2
+{
+namespace aggregator
+{
+
+MPIShm::WindowBuffer::WindowBuffer() : format::Buffer("MPIShmWindow") {}
+
+char *MPIShm::WindowBuffer::Data() noexcept { return m_Data; }
+
+const char *MPIShm::WindowBuffer::Data() const noexcept { return m_Data; }
+
+MPIShm::MPIShm() : MPIAggregator() {}
+
+MPIShm::~MPIShm()
+{
+    if (m_IsActive)
+    {
+        m_Window.Free("freeing shared window in MPIShm destructor, not "
+                      "recommended");
+    }
+}
+
+void MPIShm::Init(const size_t subStreams, helper::Comm const &parentComm)
+{
+    if (subStreams > 0)
+    {
+        InitComm(subStreams, parentComm);
+        HandshakeRank(0);
+    }
+    else
+    {
+        InitCommPerNode(parentComm);
+    }
+
+    // all substreams must fit in a compute node
+    helper::Comm shmComm =
+        m_Comm.GroupByShm("checking substream is in one node at Open");
+    const int isNodeLocal = (shmComm.Size() == m_Size) ? 1 : 0;
+    shmComm.Free("checking substream is in one node at Open");
+    int allNodeLocal = 0;
+    parentComm.Allreduce(&isNodeLocal, &allNodeLocal, 1, helper::Comm::Op::Min,
+                         "checking substreams are in one node at Open");
+    if (allNodeLocal == 0)
+    {
+        throw std::invalid_argument(
+            "ERROR: Parameter AggregationType=Shm requires the processes of "
+            "each substream to be on the same compute node, set "
+            "NumAggregators to 0 (one per node) or to a multiple of the "
+            "number of nodes\n");
+    }
+}
+
+int MPIShm::ExchangeSteps() const noexcept { return (m_Size == 1) ? 1 : 2; }
+
+MPIShm::ExchangeRequests MPIShm::IExchange(format::Buffer &buffer,
+                                           const int step)
+{
+    if (m_Size == 1 || step != 0)
+    {
+        return {};
+    }
+
+    const size_t positions[2] = {buffer.m_Position, buffer.m_AbsolutePosition};
+    m_Positions.resize(2 * static_cast<size_t>(m_Size));
+    m_Comm.Allgather(positions, 2, m_Positions.data(), 2,
+                     "shm aggregation Allgather buffer sizes");
+
+    // the consumer writes its own buffer, the rest goes to the window
+    size_t offset = 0;
+    size_t windowPosition = 0;
+    for (int r = 1; r < m_Size; ++r)
+    {
+        if (r == m_Rank)
+        {
+            offset = windowPosition;
+        }
+        windowPosition += m_Positions[2 * r];
+    }
+
+    // collective on all ranks, they all know windowPosition
+    if (windowPosition > m_WindowSize)
+    {
+        m_Window.Free("shm aggregation freeing window to resize it");
+        m_Window = m_Comm.WinAllocateShared(
+            (m_Rank == 0) ? windowPosition : 0,
+            "shm aggregation allocating window of size " +
+                std::to_string(windowPosition));
+        size_t windowSize = 0;
+        m_WindowBuffer.m_Data =
+            m_Window.SharedQuery(0, windowSize, "shm aggregation querying "
+                                                "window address");
+        m_WindowSize = windowSize;
+    }
+    m_WindowBuffer.m_Position = windowPosition;
+
+    if (m_Rank > 0 && buffer.m_Position > 0)
+    {
+        std::memcpy(m_WindowBuffer.m_Data + offset, buffer.Data(),
+                    buffer.m_Position);
+    }
+
+    return {};
+}
+
+MPIShm::ExchangeAbsolutePositionRequests
+MPIShm::IExchangeAbsolutePosition(format::Buffer &buffer, const int step)
+{
+    if (m_Size == 1)
+    {
+        return {};
+    }
+
+    if (m_IsInExchangeAbsolutePosition)
+    {
+        throw std::runtime_error("ERROR: MPIShm::IExchangeAbsolutePosition: "
+                                 "An existing exchange is still active.");
+    }
+
+    if (step == 0)
+    {
+        // data of rank r starts after the data written by rank 0 and the
+        // data of ranks [1,r), rank 0 moves past the data of all ranks
+        size_t absolutePosition = m_Positions[1];
+        const int end = (m_Rank == 0) ? m_Size : m_Rank;
+        for (int r = 1; r < end; ++r)
+        {
+            absolutePosition += m_Positions[2 * r];
+        }
+        buffer.m_AbsolutePosition = absolutePosition;
+    }
+
+    m_IsInExchangeAbsolutePosition = true;
+    return {};
+}
+
+void MPIShm::Wait(ExchangeRequests & /*requests*/, const int step)
+{
+    if (m_Size == 1 || m_WindowSize == 0)
+    {
+        return;
+    }
+
+    // step 0: copies are visible to the consumer
+    // step 1: the consumer is done with the window before the next copies
+    m_Window.Fence("shm aggregation fence at iteration " +
+                   std::to_string(step) + "\n");
+}
+
+void MPIShm::WaitAbsolutePosition(
+    ExchangeAbsolutePositionRequests & /*requests*/, const int /*step*/)
+{
+    if (m_Size == 1)
+    {
+        return;
+    }
+
+    if (!m_IsInExchangeAbsolutePosition)
+    {
+        throw std::runtime_error("ERROR: MPIShm::WaitAbsolutePosition: An "
+                                 "existing exchange is not active.");
+    }
+    m_IsInExchangeAbsolutePosition = false;
+}
+
+void MPIShm::SwapBuffers(const int step) noexcept
+{
+    m_ConsumerStep = step + 1;
+}
+
+void MPIShm::ResetBuffers() noexcept { m_ConsumerStep = 0; }
+
+format::Buffer &MPIShm::GetConsumerBuffer(format::Buffer &buffer)
+{
+    if (m_ConsumerStep == 0)
+    {
+        return buffer;
+    }
+    return m_WindowBuffer;
+}
+
+void MPIShm::Close()
+{
+    if (m_IsActive)
+    {
+        m_Window.Free("freeing shared window at Close\n");
+        m_WindowBuffer.m_Data = nullptr;
+        m_WindowSize = 0;
+    }
+    MPIAggregator::Close();
+}
+
+} // end namespace aggregator
+} // end namespace adios2
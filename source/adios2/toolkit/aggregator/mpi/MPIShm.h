@@ -0,0 +1,95 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPIShm.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPISHM_H_
+#define ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPISHM_H_
+
+#include <vector>
+
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+/**
+ * Aggregates the processes of a compute node through a memory window owned
+ * by the consumer (rank 0) and shared with all processes of m_Comm. Each
+ * process copies its buffer to its offset in the window, in rank order, and
+ * the consumer writes its own buffer and then the window in one call. All
+ * processes of a substream must be on the same compute node.
+ */
+class MPIShm : public MPIAggregator
+{
+
+public:
+    MPIShm();
+
+    ~MPIShm();
+
+    void Init(const size_t subStreams, helper::Comm const &parentComm) final;
+
+    /** @return 2: the consumer writes its own buffer, then the window */
+    int ExchangeSteps() const noexcept final;
+
+    ExchangeRequests IExchange(format::Buffer &buffer, const int step) final;
+
+    ExchangeAbsolutePositionRequests
+    IExchangeAbsolutePosition(format::Buffer &buffer, const int step) final;
+
+    void Wait(ExchangeRequests &requests, const int step) final;
+
+    void WaitAbsolutePosition(ExchangeAbsolutePositionRequests &requests,
+                              const int step) final;
+
+    void SwapBuffers(const int step) noexcept final;
+
+    void ResetBuffers() noexcept final;
+
+    format::Buffer &GetConsumerBuffer(format::Buffer &buffer) final;
+
+    /** frees the shared window, then m_Comm */
+    void Close() final;
+
+private:
+    /** non-owning view of the shared window passed to GetConsumerBuffer */
+    class WindowBuffer : public format::Buffer
+    {
+    public:
+        WindowBuffer();
+        char *Data() noexcept final;
+        const char *Data() const noexcept final;
+
+        char *m_Data = nullptr;
+    };
+
+    bool m_IsInExchangeAbsolutePosition = false;
+
+    /** step written by the consumer in GetConsumerBuffer, 0: own data,
+     * 1: window */
+    int m_ConsumerStep = 0;
+
+    /** memory shared by all processes in m_Comm, allocated by rank 0 */
+    helper::Comm::Win m_Window;
+
+    /** bytes allocated in m_Window, it only grows */
+    size_t m_WindowSize = 0;
+
+    /** m_Window data, m_Position: bytes copied at the current exchange */
+    WindowBuffer m_WindowBuffer;
+
+    /** buffer m_Position and m_AbsolutePosition of each rank at step 0 */
+    std::vector<size_t> m_Positions;
+};
+
+} // end namespace aggregator
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPISHM_H_ */
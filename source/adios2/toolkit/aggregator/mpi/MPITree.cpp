@@ -0,0 +1,221 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPITree.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+#include "MPITree.h"
+
+#include <numeric> // std::accumulate
+
+#include "adios2/toolkit/format/buffer/heap/BufferSTL.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+MPITree::MPITree() : MPIAggregator() {}
+
+void MPITree::Init(const size_t subStreams, helper::Comm const &parentComm)
+{
+    if (subStreams > 0)
+    {
+        InitComm(subStreams, parentComm);
+        HandshakeRank(0);
+    }
+    else
+    {
+        InitCommPerNode(parentComm);
+    }
+
+    // one receiving buffer per exchange step
+    m_Rounds = 0;
+    while ((1 << m_Rounds) < m_Size)
+    {
+        m_Buffers.emplace_back(new format::BufferSTL());
+        ++m_Rounds;
+    }
+}
+
+int MPITree::ExchangeSteps() const noexcept { return m_Rounds + 1; }
+
+MPITree::ExchangeRequests MPITree::IExchange(format::Buffer &buffer,
+                                             const int step)
+{
+    if (m_Size == 1 || step >= m_Rounds)
+    {
+        return {};
+    }
+
+    const int stride = 1 << step;
+    const bool sender = (m_Rank % (2 * stride) == stride) ? true : false;
+    const bool receiver =
+        (m_Rank % (2 * stride) == 0 && m_Rank + stride < m_Size) ? true : false;
+
+    if (sender)
+    {
+        const int destination = m_Rank - stride;
+
+        // own data followed by the data received at previous steps
+        m_SendSizes.resize(static_cast<size_t>(step) + 1);
+        m_SendSizes[0] = buffer.m_Position;
+        for (int s = 0; s < step; ++s)
+        {
+            m_SendSizes[s + 1] = m_Buffers[s]->m_Position;
+        }
+
+        m_SendRequests.push_back(
+            m_Comm.Isend(m_SendSizes.data(), m_SendSizes.size(), destination,
+                         0,
+                         ", tree aggregation Isend sizes at iteration " +
+                             std::to_string(step) + "\n"));
+
+        for (int s = 0; s <= step; ++s)
+        {
+            const format::Buffer &sendBuffer =
+                (s == 0) ? buffer : *m_Buffers[s - 1];
+            // only send data if buffer larger than 0
+            if (m_SendSizes[s] > 0)
+            {
+                m_SendRequests.push_back(m_Comm.Isend(
+                    sendBuffer.Data(), m_SendSizes[s], destination, s + 1,
+                    ", tree aggregation Isend data at iteration " +
+                        std::to_string(step)));
+            }
+        }
+    }
+
+    if (receiver)
+    {
+        const int source = m_Rank + stride;
+
+        std::vector<size_t> sizes(static_cast<size_t>(step) + 1);
+        helper::Comm::Req receiveSizesRequest =
+            m_Comm.Irecv(sizes.data(), sizes.size(), source, 0,
+                         ", tree aggregation Irecv sizes at iteration " +
+                             std::to_string(step) + "\n");
+
+        receiveSizesRequest.Wait(
+            ", tree aggregation waiting for receiver sizes at iteration " +
+            std::to_string(step) + "\n");
+
+        const size_t bufferSize = std::accumulate(sizes.begin(), sizes.end(),
+                                                  static_cast<size_t>(0));
+
+        format::Buffer &receiveBuffer = *m_Buffers[step];
+        ResizeUpdateBuffer(
+            bufferSize, receiveBuffer,
+            "in tree aggregation, when resizing receiving buffer to size " +
+                std::to_string(bufferSize));
+
+        // messages are received back to back, in rank order
+        size_t position = 0;
+        for (size_t s = 0; s < sizes.size(); ++s)
+        {
+            // only receive data if buffer is larger than 0
+            if (sizes[s] > 0)
+            {
+                m_RecvRequests.push_back(m_Comm.Irecv(
+                    receiveBuffer.Data() + position, sizes[s], source,
+                    static_cast<int>(s) + 1,
+                    ", tree aggregation Irecv data at iteration " +
+                        std::to_string(step)));
+                position += sizes[s];
+            }
+        }
+    }
+
+    return {};
+}
+
+MPITree::ExchangeAbsolutePositionRequests
+MPITree::IExchangeAbsolutePosition(format::Buffer &buffer, const int step)
+{
+    if (m_Size == 1)
+    {
+        return {};
+    }
+
+    if (m_IsInExchangeAbsolutePosition)
+    {
+        throw std::runtime_error("ERROR: MPITree::IExchangeAbsolutePosition: "
+                                 "An existing exchange is still active.");
+    }
+
+    if (step == 0)
+    {
+        // data of rank r starts after the data written by rank 0 and the
+        // data of ranks [1,r), rank 0 moves past the data of all ranks
+        const size_t size =
+            (m_Rank == 0) ? buffer.m_AbsolutePosition : buffer.m_Position;
+        const std::vector<size_t> sizes = m_Comm.AllGatherValues(size);
+        const int end = (m_Rank == 0) ? m_Size : m_Rank;
+        buffer.m_AbsolutePosition = std::accumulate(
+            sizes.begin(), sizes.begin() + end, static_cast<size_t>(0));
+    }
+
+    m_IsInExchangeAbsolutePosition = true;
+    return {};
+}
+
+void MPITree::Wait(ExchangeRequests & /*requests*/, const int step)
+{
+    if (m_Size == 1)
+    {
+        return;
+    }
+
+    for (auto &request : m_RecvRequests)
+    {
+        request.Wait(
+            ", tree aggregation waiting for receiver request at iteration " +
+            std::to_string(step) + "\n");
+    }
+    m_RecvRequests.clear();
+
+    for (auto &request : m_SendRequests)
+    {
+        request.Wait(
+            ", tree aggregation waiting for sender request at iteration " +
+            std::to_string(step) + "\n");
+    }
+    m_SendRequests.clear();
+}
+
+void MPITree::WaitAbsolutePosition(
+    ExchangeAbsolutePositionRequests & /*requests*/, const int /*step*/)
+{
+    if (m_Size == 1)
+    {
+        return;
+    }
+
+    if (!m_IsInExchangeAbsolutePosition)
+    {
+        throw std::runtime_error("ERROR: MPITree::WaitAbsolutePosition: An "
+                                 "existing exchange is not active.");
+    }
+    m_IsInExchangeAbsolutePosition = false;
+}
+
+void MPITree::SwapBuffers(const int step) noexcept
+{
+    m_ConsumerStep = step + 1;
+}
+
+void MPITree::ResetBuffers() noexcept { m_ConsumerStep = 0; }
+
+format::Buffer &MPITree::GetConsumerBuffer(format::Buffer &buffer)
+{
+    if (m_ConsumerStep == 0)
+    {
+        return buffer;
+    }
+    return *m_Buffers[m_ConsumerStep - 1];
+}
+
+} // end namespace aggregator
+} // end namespace adios2
@@ -0,0 +1,84 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPITree.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPITREE_H_
+#define ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPITREE_H_
+
+#include <vector>
+
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+/**
+ * Gathers the data of a substream to its consumer (rank 0) along a binomial
+ * tree in ceil(log2(m_Size)) steps. At step s, ranks with rank % 2^(s+1) ==
+ * 2^s send their data and the data gathered at previous steps to rank - 2^s.
+ * Data arrives in rank order, so the consumer writes the buffer received at
+ * step s-1 while step s is in flight. The consumer holds the data of all the
+ * substream ranks at the end of the aggregation.
+ */
+class MPITree : public MPIAggregator
+{
+
+public:
+    MPITree();
+
+    ~MPITree() = default;
+
+    void Init(const size_t subStreams, helper::Comm const &parentComm) final;
+
+    /** @return ceil(log2(m_Size)) exchange steps, plus one step to write the
+     * buffer received at the last exchange */
+    int ExchangeSteps() const noexcept final;
+
+    ExchangeRequests IExchange(format::Buffer &buffer, const int step) final;
+
+    ExchangeAbsolutePositionRequests
+    IExchangeAbsolutePosition(format::Buffer &buffer, const int step) final;
+
+    void Wait(ExchangeRequests &requests, const int step) final;
+
+    void WaitAbsolutePosition(ExchangeAbsolutePositionRequests &requests,
+                              const int step) final;
+
+    void SwapBuffers(const int step) noexcept final;
+
+    void ResetBuffers() noexcept final;
+
+    format::Buffer &GetConsumerBuffer(format::Buffer &buffer) final;
+
+private:
+    bool m_IsInExchangeAbsolutePosition = false;
+
+    /** number of exchange steps, m_Buffers[s] receives at step s */
+    int m_Rounds = 0;
+
+    /** step written by the consumer in GetConsumerBuffer, 0: own data,
+     * s > 0: m_Buffers[s-1] */
+    int m_ConsumerStep = 0;
+
+    /** sizes of own data and of m_Buffers sent at the sender step, must
+     * live until Wait */
+    std::vector<size_t> m_SendSizes;
+
+    /** pending send requests of the current step, one per message */
+    std::vector<helper::Comm::Req> m_SendRequests;
+
+    /** pending receive requests of the current step, one per message */
+    std::vector<helper::Comm::Req> m_RecvRequests;
+};
+
+} // end namespace aggregator
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPITREE_H_ */
@@ -11,8 +11,14 @@
 #include "BPBase.h"
 #include "BPBase.tcc"
 
+#include <numeric> // std::accumulate
+
 #include "adios2/helper/adiosFunctions.h"
 
+#include "adios2/toolkit/aggregator/mpi/MPIChain.h"
+#include "adios2/toolkit/aggregator/mpi/MPIShm.h"
+#include "adios2/toolkit/aggregator/mpi/MPITree.h"
+
 #include "adios2/toolkit/format/bp/bpOperation/compress/BPBZIP2.h"
 #include "adios2/toolkit/format/bp/bpOperation/compress/BPBlosc.h"
 #include "adios2/toolkit/format/bp/bpOperation/compress/BPMGARD.h"
@@ -35,7 +41,8 @@ BPBase::SerialElementIndex::SerialElementIndex(const uint32_t memberID,
 
 BPBase::Minifooter::Minifooter(const int8_t version) : Version(version) {}
 
-BPBase::BPBase(helper::Comm const &comm) : m_Comm(comm)
+BPBase::BPBase(helper::Comm const &comm)
+: m_Comm(comm), m_Aggregator(new aggregator::MPIChain())
 {
     m_RankMPI = m_Comm.Rank();
     m_SizeMPI = m_Comm.Size();
@@ -114,6 +121,32 @@ void BPBase::Init(const Params &parameters, const std::string hint,
             parsedParameters.MaxBufferSize = helper::StringToByteUnits(
                 value, "for Parameter key=MaxBufferSize, in call to Open");
         }
+        else if (key == "bufferchunksize")
+        {
+            parsedParameters.BufferChunkSize = helper::StringToByteUnits(
+                value, "for Parameter key=BufferChunkSize, in call to Open");
+        }
+        else if (key == "zerocopythreshold")
+        {
+            parsedParameters.ZeroCopyThreshold = helper::StringToByteUnits(
+                value, "for Parameter key=ZeroCopyThreshold, in call to Open");
+        }
+        else if (key == "nontemporalthreshold")
+        {
+            parsedParameters.NonTemporalThreshold = helper::StringToByteUnits(
+                value,
+                "for Parameter key=NonTemporalThreshold, in call to Open");
+        }
+        else if (key == "readgapsize")
+        {
+            parsedParameters.ReadGapSize = helper::StringToByteUnits(
+                value, "for Parameter key=ReadGapSize, in call to Open");
+        }
+        else if (key == "prefetchbuffersize")
+        {
+            parsedParameters.PrefetchBufferSize = helper::StringToByteUnits(
+                value, "for Parameter key=PrefetchBufferSize, in call to Open");
+        }
         else if (key == "threads")
         {
             parsedParameters.Threads =
@@ -153,6 +186,12 @@ void BPBase::Init(const Params &parameters, const std::string hint,
             parsedParameters.FlushStepsCount = helper::StringToSizeT(
                 value, " in Parameter key=FlushStepsCount " + hint);
         }
+        else if ((key == "substreams" || key == "numaggregators") &&
+                 value == "auto")
+        {
+            parsedParameters.NumAggregators = 0;
+            parsedParameters.AutoAggregators = true;
+        }
         else if (key == "substreams" || key == "numaggregators")
         {
             int n = static_cast<int>(helper::StringTo<int32_t>(
@@ -167,6 +206,13 @@ void BPBase::Init(const Params &parameters, const std::string hint,
                 n = m_SizeMPI;
             }
             parsedParameters.NumAggregators = n;
+            parsedParameters.AutoAggregators = false;
+        }
+        else if (key == "aggregatorspernode")
+        {
+            parsedParameters.AggregatorsPerNode =
+                static_cast<unsigned int>(helper::StringTo<uint32_t>(
+                    value, " in Parameter key=AggregatorsPerNode " + hint));
         }
         else if (key == "aggregatorratio")
         {
@@ -195,6 +241,28 @@ void BPBase::Init(const Params &parameters, const std::string hint,
                 parsedParameters.NumAggregators = n;
             }
         }
+        else if (key == "aggregationtype")
+        {
+            if (value == "chain")
+            {
+                parsedParameters.Aggregation = AggregationType::Chain;
+            }
+            else if (value == "tree")
+            {
+                parsedParameters.Aggregation = AggregationType::Tree;
+            }
+            else if (value == "shm")
+            {
+                parsedParameters.Aggregation = AggregationType::Shm;
+            }
+            else
+            {
+                throw std::invalid_argument(
+                    "ERROR: value for Parameter key=AggregationType must be "
+                    "Chain, Tree or Shm, " +
+                    hint);
+            }
+        }
         else if (key == "node-local" || key == "nodelocal")
         {
             parsedParameters.NodeLocal = helper::StringTo<bool>(
@@ -221,6 +289,16 @@ void BPBase::Init(const Params &parameters, const std::string hint,
             parsedParameters.StreamReader = helper::StringTo<bool>(
                 value, " in Parameter key=StreamReader " + hint);
         }
+        else if (key == "lazymetadata")
+        {
+            parsedParameters.LazyMetadata = helper::StringTo<bool>(
+                value, " in Parameter key=LazyMetadata " + hint);
+        }
+        else if (key == "asyncwrite")
+        {
+            parsedParameters.AsyncWrite = helper::StringTo<bool>(
+                value, " in Parameter key=AsyncWrite " + hint);
+        }
     }
     if (!engineType.empty())
     {
@@ -262,6 +340,15 @@ void BPBase::Init(const Params &parameters, const std::string hint,
         }
         m_Parameters = parsedParameters;
     }
+    if (m_Parameters.Aggregation == AggregationType::Tree)
+    {
+        m_Aggregator.reset(new aggregator::MPITree());
+    }
+    else if (m_Parameters.Aggregation == AggregationType::Shm)
+    {
+        m_Aggregator.reset(new aggregator::MPIShm());
+    }
+
     // set timers if active
     if (m_Profiler.m_IsActive)
     {
@@ -287,6 +374,26 @@ void BPBase::Init(const Params &parameters, const std::string hint,
     m_Profiler.Stop("buffering");
 }
 
+void BPBase::InitAggregator(const std::string &name)
+{
+    if (m_Parameters.NumAggregators >= static_cast<unsigned int>(m_SizeMPI))
+    {
+        return;
+    }
+
+    if (m_Parameters.AggregatorsPerNode > 0)
+    {
+        m_Aggregator->m_AggregatorsPerNode = m_Parameters.AggregatorsPerNode;
+    }
+    else if (m_Parameters.AutoAggregators)
+    {
+        m_Aggregator->m_AggregatorsPerNode = 0;
+        m_Aggregator->m_StripeCount =
+            helper::FileSystemStripeCount(name, m_Comm);
+    }
+    m_Aggregator->Init(m_Parameters.NumAggregators, m_Comm);
+}
+
 BPBase::ResizeResult BPBase::ResizeBuffer(const size_t dataIn,
                                           const std::string hint)
 {
@@ -313,6 +420,18 @@ BPBase::ResizeResult BPBase::ResizeBuffer(const size_t dataIn,
     {
         // do nothing, unchanged is default
     }
+    else if (m_DataChunkSize > 0 &&
+             (m_MetadataSet.DataPGIsOpen ? m_MetadataSet.DataPGVarsCount > 0
+                                         : m_Data.m_Position > 0))
+    {
+        // a chunk holding data never grows, data goes to a new chunk
+        const size_t chunksSize =
+            std::accumulate(m_DataChunksSizes.begin(), m_DataChunksSizes.end(),
+                            static_cast<size_t>(0));
+        result = (chunksSize + requiredSize > maxBufferSize)
+                     ? ResizeResult::Flush
+                     : ResizeResult::NewChunk;
+    }
     else if (requiredSize > maxBufferSize)
     {
         if (currentSize < maxBufferSize)
@@ -342,6 +461,37 @@ BPBase::ResizeResult BPBase::ResizeBuffer(const size_t dataIn,
     return result;
 }
 
+void BPBase::RetireDataChunk(const size_t dataSize)
+{
+    m_Profiler.Start("buffering");
+    m_DataChunks.emplace_back();
+    m_DataChunks.back().swap(m_Data.m_Buffer);
+    m_DataChunksSizes.push_back(dataSize);
+
+    if (m_DataChunksPool.empty())
+    {
+        m_Data.Resize(m_DataChunkSize, "when allocating a new data chunk");
+    }
+    else
+    {
+        m_Data.m_Buffer.swap(m_DataChunksPool.back());
+        m_DataChunksPool.pop_back();
+    }
+    m_Data.Reset(false, false);
+    m_Profiler.Stop("buffering");
+}
+
+void BPBase::RecycleDataChunks(std::vector<std::vector<char>> &chunks,
+                               std::vector<size_t> &chunksSizes)
+{
+    for (auto &chunk : chunks)
+    {
+        m_DataChunksPool.push_back(std::move(chunk));
+    }
+    chunks.clear();
+    chunksSizes.clear();
+}
+
 void BPBase::ResetBuffer(Buffer &buffer, const bool resetAbsolutePosition,
                          const bool zeroInitialize)
 {
@@ -355,6 +505,10 @@ void BPBase::DeleteBuffers()
     m_Profiler.Start("buffering");
     m_Data.Delete();
     m_Metadata.Delete();
+    std::vector<std::vector<char>>().swap(m_DataChunks);
+    std::vector<std::vector<char>>().swap(m_DataChunksPool);
+    m_DataChunksSizes.clear();
+    m_DataReferences.clear();
     m_Profiler.Stop("buffering");
 }
 
@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_FORMAT_BP_BPBASE_H_
 
 #include <bitset>
+#include <memory> //std::unique_ptr
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -20,7 +21,7 @@
 #include "adios2/common/ADIOSMacros.h"
 #include "adios2/common/ADIOSTypes.h"
 #include "adios2/helper/adiosComm.h"
-#include "adios2/toolkit/aggregator/mpi/MPIChain.h"
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
 #include "adios2/toolkit/format/bp/bpOperation/BPOperation.h"
 #include "adios2/toolkit/format/buffer/Buffer.h"
 #include "adios2/toolkit/profiling/iochrono/IOChrono.h"
@@ -150,6 +151,14 @@ public:
         Minifooter(const int8_t version);
     };
 
+    /** how the processes of a substream send data to their aggregator */
+    enum class AggregationType
+    {
+        Chain, //!< CHAIN, each process forwards to its neighbor, MPIChain
+        Tree,  //!< TREE, binomial tree in log2(processes) steps, MPITree
+        Shm    //!< SHM, memory window shared in a compute node, MPIShm
+    };
+
     /** groups all user-level parameters in a single struct */
     struct Parameters
     {
@@ -163,6 +172,27 @@ public:
         /** max buffer size */
         size_t MaxBufferSize = DefaultMaxBufferSize;
 
+        /** Writer: size of the data buffer chunks, 0: a single contiguous
+         * data buffer that grows by copying */
+        size_t BufferChunkSize = 0;
+
+        /** Writer: minimum payload size of deferred blocks written from
+         * application memory instead of being copied, 0: always copy */
+        size_t ZeroCopyThreshold = 0;
+
+        /** Writer: minimum payload size of blocks copied to the buffer with
+         * non-temporal stores, which bypass the cache, 0: never */
+        size_t NonTemporalThreshold = 32 * 1024 * 1024;
+
+        /** Reader: blocks of a data file separated by at most this many
+         * bytes are read with a single call, 0: only adjacent blocks */
+        size_t ReadGapSize = 0;
+
+        /** Reader: streaming reads of the next step's blocks, predicted from
+         * the current step's selections, are cached up to this size in a
+         * background thread, 0: off */
+        size_t PrefetchBufferSize = 0;
+
         /**
          * sub-block size for min/max calculation of large arrays in number of
          * elements (not bytes). The default big number per Put() default will
@@ -216,12 +246,36 @@ public:
          */
         bool StreamReader = false;
 
+        /** Reader flag: read only the metadata index table in Open.
+         * The metadata of a step is read and parsed when BeginStep moves to
+         * it, or in Open for steps selected by the step selection parameter
+         */
+        bool LazyMetadata = false;
+
+        /** Writer flag: write the data buffer to the data files in a
+         * background thread while the next step fills a second buffer
+         */
+        bool AsyncWrite = false;
+
         /** Number of aggregators.
          * Must be a value between 1 and number of MPI ranks
          * 0 as default means that the engine must define the number of
          * aggregators
          */
         unsigned int NumAggregators = 0;
+
+        /** NumAggregators=auto: aggregators are placed per compute node, as
+         * many as the file system stripe count of the output if known
+         */
+        bool AutoAggregators = false;
+
+        /** Aggregators in each compute node if NumAggregators is 0 or auto,
+         * 0 as default means one per node, or derived with AutoAggregators
+         */
+        unsigned int AggregatorsPerNode = 0;
+
+        /** Writer: aggregator used to gather the data of a substream */
+        AggregationType Aggregation = AggregationType::Chain;
     };
 
     /** Return type of the ResizeBuffer function. */
@@ -230,7 +284,8 @@ public:
         Failure,   //!< FAILURE, caught a std::bad_alloc
         Unchanged, //!< UNCHANGED, no need to resize (sufficient capacity)
         Success,   //!< SUCCESS, resize was successful
-        Flush      //!< FLUSH, need to flush to transports for current variable
+        Flush,     //!< FLUSH, need to flush to transports for current variable
+        NewChunk   //!< NEWCHUNK, continue in a new data buffer chunk
     };
 
     helper::Comm const &m_Comm; ///< multi-process communicator from Engine
@@ -246,6 +301,34 @@ public:
     /** contains data buffer for this rank */
     BufferSTL m_Data;
 
+    /** size of new data buffer chunks, 0: chunks are not used. Set by
+     * engines that write m_DataChunks before m_Data at each flush */
+    size_t m_DataChunkSize = 0;
+
+    /** full data buffer chunks of the current flush, in order */
+    std::vector<std::vector<char>> m_DataChunks;
+
+    /** bytes used in each of m_DataChunks */
+    std::vector<size_t> m_DataChunksSizes;
+
+    /** written data buffer chunks, reused by later steps */
+    std::vector<std::vector<char>> m_DataChunksPool;
+
+    /** block payload left in application memory, written between the bytes
+     * of a data buffer chunk at the next flush instead of being copied */
+    struct DataReference
+    {
+        /** index in m_DataChunks, m_DataChunks.size() for m_Data */
+        size_t Chunk;
+        /** bytes of the chunk written before the payload */
+        size_t Position;
+        const char *Data;
+        size_t Size;
+    };
+
+    /** payload references of the current flush, in order */
+    std::vector<DataReference> m_DataReferences;
+
     /** contains collective metadata buffer, only used by rank 0 */
     BufferSTL m_Metadata;
 
@@ -268,8 +351,9 @@ public:
     /** if reader and writer have different ordering (column vs row major) */
     bool m_ReverseDimensions = false;
 
-    /** manages all communication tasks in aggregation */
-    aggregator::MPIChain m_Aggregator;
+    /** manages all communication tasks in aggregation, MPIChain, MPITree or
+     * MPIShm depending on Parameters::Aggregation */
+    std::unique_ptr<aggregator::MPIAggregator> m_Aggregator;
 
     /** tracks Put and Get variables in deferred mode */
     std::set<std::string> m_DeferredVariables;
@@ -307,6 +391,14 @@ public:
     void Init(const Params &parameters, const std::string hint,
               const std::string engineType = "");
 
+    /**
+     * Writers: places the aggregators from NumAggregators, AggregatorsPerNode
+     * and AutoAggregators and initializes m_Aggregator if it is needed
+     * @param name output name, its directory is queried for the stripe count
+     * with AutoAggregators
+     */
+    void InitAggregator(const std::string &name);
+
     /****************** NEED to check if some are virtual */
 
     /**
@@ -317,6 +409,21 @@ public:
      */
     ResizeResult ResizeBuffer(const size_t dataIn, const std::string hint);
 
+    /**
+     * Moves the data buffer to m_DataChunks and continues in an empty chunk
+     * taken from m_DataChunksPool, or allocated if the pool is empty
+     * @param dataSize bytes used in the data buffer
+     */
+    void RetireDataChunk(const size_t dataSize);
+
+    /**
+     * Returns written chunks to m_DataChunksPool
+     * @param chunks emptied on return
+     * @param chunksSizes emptied on return
+     */
+    void RecycleDataChunks(std::vector<std::vector<char>> &chunks,
+                           std::vector<size_t> &chunksSizes);
+
     /**
      * Sets buffer's positions to zero and fill buffer with zero char
      * @param bufferSTL buffer to be reset
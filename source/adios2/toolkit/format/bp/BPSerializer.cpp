@@ -350,7 +350,7 @@ void BPSerializer::UpdateOffsetsInMetadata()
     };
 
     // BODY OF FUNCTION STARTS HERE
-    if (m_Aggregator.m_IsConsumer)
+    if (m_Aggregator->m_IsConsumer)
     {
         return;
     }
@@ -686,15 +686,6 @@ void BPSerializer::MergeSerializeIndices(
         return;
     }
 
-    const size_t elements = nameRankIndices.size();
-    const size_t stride =
-        elements / m_Parameters.Threads; // elements per thread
-    const size_t last =
-        stride + elements % m_Parameters.Threads; // remainder to last
-
-    std::vector<std::thread> threads;
-    threads.reserve(m_Parameters.Threads);
-
     // copy names in order to use threads
     std::vector<std::string> names;
     names.reserve(nameRankIndices.size());
@@ -704,32 +695,18 @@ void BPSerializer::MergeSerializeIndices(
         names.push_back(nameRankIndexPair.first);
     }
 
-    for (unsigned int t = 0; t < m_Parameters.Threads; ++t)
-    {
-        const size_t start = stride * t;
-        size_t end = start + stride;
-
-        if (t == m_Parameters.Threads - 1)
-        {
-            end = start + last;
-        }
-
-        threads.push_back(
-            std::thread(lf_MergeRankRange, std::ref(nameRankIndices),
-                        std::ref(names), start, end, std::ref(bufferSTL)));
-    }
-
-    for (auto &thread : threads)
-    {
-        thread.join();
-    }
+    helper::ParallelFor(
+        names.size(), m_Parameters.Threads,
+        [&](const size_t, const size_t start, const size_t end) {
+            lf_MergeRankRange(nameRankIndices, names, start, end, bufferSTL);
+        });
 }
 
 uint32_t BPSerializer::GetFileIndex() const noexcept
 {
-    if (m_Aggregator.m_IsActive)
+    if (m_Aggregator->m_IsActive)
     {
-        return static_cast<uint32_t>(m_Aggregator.m_SubStreamIndex);
+        return static_cast<uint32_t>(m_Aggregator->m_SubStreamIndex);
     }
 
     return static_cast<uint32_t>(m_RankMPI);
@@ -890,7 +867,11 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #define declare_template_instantiation(T)                                      \
     template void BPSerializer::PutPayloadInBuffer(                            \
         const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
-        const bool) noexcept;
+        const bool) noexcept;                                                  \
+                                                                               \
+    template void BPSerializer::PutPayloadInBuffer(                            \
+        const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
+        Stats<T> &) noexcept;
 
 ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
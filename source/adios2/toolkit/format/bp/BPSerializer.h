@@ -84,6 +84,18 @@ protected:
                             const typename core::Variable<T>::BPInfo &blockInfo,
                             const bool sourceRowMajor) noexcept;
 
+    /**
+     * PutPayloadInBuffer of a block contiguous in memory, computing the
+     * min/max statistics of its sub-blocks in the same pass over the data.
+     * Blocks of at least the NonTemporalThreshold parameter bytes are stored
+     * bypassing the cache.
+     * @param stats input SubBlockInfo, output Min, Max and MinMaxs
+     */
+    template <class T>
+    void PutPayloadInBuffer(const core::Variable<T> &variable,
+                            const typename core::Variable<T>::BPInfo &blockInfo,
+                            Stats<T> &stats) noexcept;
+
     void PutNameRecord(const std::string name,
                        std::vector<char> &buffer) noexcept;
 
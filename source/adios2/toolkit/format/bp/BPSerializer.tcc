@@ -91,6 +91,26 @@ inline void BPSerializer::PutPayloadInBuffer(
     m_Data.m_AbsolutePosition += blockSize * sizeof(T); // payload size
 }
 
+template <class T>
+inline void BPSerializer::PutPayloadInBuffer(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::BPInfo &blockInfo,
+    Stats<T> &stats) noexcept
+{
+    const size_t blockSize = helper::GetTotalSize(blockInfo.Count);
+    const bool nonTemporal =
+        m_Parameters.NonTemporalThreshold > 0 &&
+        blockSize * sizeof(T) >= m_Parameters.NonTemporalThreshold;
+    m_Profiler.Start("memcpy");
+    helper::CopyMinMaxSubblocks(
+        blockInfo.Data, blockInfo.Count, stats.SubBlockInfo,
+        m_Data.m_Buffer.data() + m_Data.m_Position, stats.MinMaxs, stats.Min,
+        stats.Max, m_Parameters.Threads, nonTemporal);
+    m_Profiler.Stop("memcpy");
+    m_Data.m_Position += blockSize * sizeof(T);
+    m_Data.m_AbsolutePosition += blockSize * sizeof(T); // payload size
+}
+
 // PRIVATE
 template <class T>
 void BPSerializer::UpdateIndexOffsetsCharacteristics(size_t &currentPosition,
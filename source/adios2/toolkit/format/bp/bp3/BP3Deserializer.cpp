@@ -11,7 +11,6 @@
 #include "BP3Deserializer.h"
 #include "BP3Deserializer.tcc"
 
-#include <future>
 #include <unordered_set>
 #include <vector>
 
@@ -241,46 +240,32 @@ void BP3Deserializer::ParseVariablesIndex(const BufferSTL &bufferSTL,
         return;
     }
 
-    // threads for reading Variables
-    std::vector<std::future<void>> asyncs(m_Parameters.Threads);
-    std::vector<size_t> asyncPositions(m_Parameters.Threads);
-
-    bool launched = false;
-
+    // element positions are found serially, the elements are read in
+    // parallel
+    std::vector<size_t> elementPositions;
     while (localPosition < varIndexLength)
     {
-        // extract async positions
-        for (unsigned int t = 0; t < m_Parameters.Threads; ++t)
-        {
-            asyncPositions[t] = position;
-            const size_t elementIndexSize =
-                static_cast<size_t>(helper::ReadValue<uint32_t>(
-                    buffer, position, m_Minifooter.IsLittleEndian));
-            position += elementIndexSize;
-            localPosition = position - startPosition;
-
-            if (launched)
-            {
-                asyncs[t].get();
-            }
-
-            if (localPosition <= varIndexLength)
-            {
-                asyncs[t] = std::async(std::launch::async, lf_ReadElementIndex,
-                                       std::ref(engine), std::ref(buffer),
-                                       asyncPositions[t]);
-            }
-        }
-        launched = true;
-    }
+        const size_t elementPosition = position;
+        const size_t elementIndexSize =
+            static_cast<size_t>(helper::ReadValue<uint32_t>(
+                buffer, position, m_Minifooter.IsLittleEndian));
+        position += elementIndexSize;
+        localPosition = position - startPosition;
 
-    for (auto &async : asyncs)
-    {
-        if (async.valid())
+        if (localPosition <= varIndexLength)
         {
-            async.wait();
+            elementPositions.push_back(elementPosition);
         }
     }
+
+    helper::ParallelFor(
+        elementPositions.size(), m_Parameters.Threads,
+        [&](const size_t, const size_t begin, const size_t end) {
+            for (size_t e = begin; e < end; ++e)
+            {
+                lf_ReadElementIndex(engine, buffer, elementPositions[e]);
+            }
+        });
 }
 
 void BP3Deserializer::ParseAttributesIndex(const BufferSTL &bufferSTL,
@@ -391,10 +376,10 @@ void BP3Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
         core::Variable<T> *variable = io.InquireVariable<T>(variableName);     \
         if (variable != nullptr)                                               \
         {                                                                      \
-            helper::ClipContiguousMemory(variable->m_Data, variable->m_Start,  \
-                                         variable->m_Count, contiguousMemory,  \
-                                         blockBox, intersectionBox,            \
-                                         m_IsRowMajor, m_ReverseDimensions);   \
+            helper::ClipContiguousMemory(                                      \
+                variable->m_Data, variable->m_Start, variable->m_Count,        \
+                contiguousMemory, blockBox, intersectionBox, m_IsRowMajor,     \
+                m_ReverseDimensions, false, m_Parameters.Threads);             \
         }                                                                      \
     }
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -578,7 +578,8 @@ void BP3Deserializer::PostDataRead(
             m_ThreadBuffers[threadID][0].data(), intersectStart, intersectCount,
             true, true, reinterpret_cast<char *>(blockInfo.Data),
             intersectStart, intersectCount, true, true, intersectStart,
-            blockCount, memoryStart, blockInfo.MemoryCount, false);
+            blockCount, memoryStart, blockInfo.MemoryCount, false,
+            m_Parameters.Threads);
     }
     else
     {
@@ -586,7 +587,7 @@ void BP3Deserializer::PostDataRead(
             blockInfo.Data, blockInfoStart, blockInfo.Count,
             m_ThreadBuffers[threadID][0].data(), subStreamBoxInfo.BlockBox,
             subStreamBoxInfo.IntersectionBox, m_IsRowMajor, m_ReverseDimensions,
-            endianReverse);
+            endianReverse, m_Parameters.Threads);
     }
 }
 
@@ -648,9 +649,11 @@ void BP3Deserializer::ClipContiguousMemory(
     const std::vector<char> &contiguousMemory, const Box<Dims> &blockBox,
     const Box<Dims> &intersectionBox) const
 {
-    helper::ClipContiguousMemory(
-        blockInfo.Data, blockInfo.Start, blockInfo.Count, contiguousMemory,
-        blockBox, intersectionBox, m_IsRowMajor, m_ReverseDimensions);
+    helper::ClipContiguousMemory(blockInfo.Data, blockInfo.Start,
+                                 blockInfo.Count, contiguousMemory, blockBox,
+                                 intersectionBox, m_IsRowMajor,
+                                 m_ReverseDimensions, false,
+                                 m_Parameters.Threads);
 }
 
 // PRIVATE
@@ -211,7 +211,8 @@ std::string BP4Base::GetBPSubStreamName(const std::string &name,
 
     const size_t index =
         isReader ? id
-                 : m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : id;
+                 : m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex
+                                            : id;
 
     /* the name of a data file starts with "data." */
     const std::string bpRankName(bpName + PathSeparator + "data." +
@@ -135,6 +135,21 @@ protected:
      */
     size_t m_LastVarLengthPosInBuffer = 0;
 
+    /* true: the statistics of the last variable block are computed while
+     * copying its payload in PutVariablePayload(), reading the block once.
+     * PutVariableMetadata() writes placeholder bounds at the positions below
+     * in the data buffer and in the variable index, rewritten by
+     * PutDeferredStats(). Short lived like m_LastVarLengthPosInBuffer.
+     */
+    bool m_DeferredStats = false;
+    helper::BlockDivisionInfo m_DeferredStatsSubBlocks;
+    size_t m_DeferredStatsPosInBuffer = 0;
+    size_t m_DeferredStatsPosInIndex = 0;
+
+    /** bytes of the open process group held in m_DataReferences, not in the
+     * data buffer */
+    size_t m_DataReferencesPGSize = 0;
+
     ElementIndexHeader
     ReadElementIndexHeader(const std::vector<char> &buffer, size_t &position,
                            const bool isLittleEndian = true) const
@@ -13,7 +13,9 @@
 #include "BP4Deserializer.h"
 #include "BP4Deserializer.tcc"
 
-#include <future>
+#include <algorithm> //std::max, std::min
+#include <limits>
+#include <sstream>
 #include <unordered_set>
 #include <vector>
 
@@ -45,15 +47,62 @@ size_t BP4Deserializer::ParseMetadata(const BufferSTL &bufferSTL,
     size_t allSteps = m_MetadataIndexTable[0].size();
     m_MetadataSet.StepsCount = allSteps;
     m_MetadataSet.CurrentStep = allSteps - 1;
-    size_t lastposition = 0;
     /* parse the metadata step by step using the pointers saved in the metadata
     index table */
-    auto itStepsString = engine.m_IO.m_Parameters.find(engine.m_Name);
+    const std::vector<size_t> selectedSteps = GetSelectedSteps(engine);
+    std::vector<size_t> steps;
+    for (size_t i = oldSteps; i < allSteps; i++)
+    {
+        if (selectedSteps.size() == 0 ||
+            std::find(selectedSteps.begin(), selectedSteps.end(), i) !=
+                selectedSteps.end())
+        {
+            steps.push_back(i + 1);
+        }
+    }
+    return ParseMetadataSteps(bufferSTL, engine, steps);
+}
+
+size_t BP4Deserializer::ParseMetadataSteps(const BufferSTL &bufferSTL,
+                                           core::Engine &engine,
+                                           const std::vector<size_t> &steps)
+{
+    {
+        // block positions are invalidated by new metadata
+        std::lock_guard<std::mutex> lock(m_BlockIndexColumnsMutex);
+        m_BlockIndexColumns.clear();
+    }
+
+    if (m_Parameters.Threads > 1)
+    {
+        ParseMetadataThreads(bufferSTL, engine, steps);
+    }
+    else
+    {
+        for (const size_t step : steps)
+        {
+            ParsePGIndexPerStep(bufferSTL, engine.m_IO.m_HostLanguage, 0,
+                                step);
+            ParseVariablesIndexPerStep(bufferSTL, engine, 0, step);
+            ParseAttributesIndexPerStep(bufferSTL, engine, 0, step);
+        }
+    }
+
+    if (steps.empty())
+    {
+        return 0;
+    }
+    return m_MetadataIndexTable[0][steps.back()][3];
+}
+
+std::vector<size_t>
+BP4Deserializer::GetSelectedSteps(const core::Engine &engine) const
+{
     std::vector<size_t> selectedSteps;
+    auto itStepsString = engine.m_IO.m_Parameters.find(engine.m_Name);
     if (itStepsString != engine.m_IO.m_Parameters.end())
     {
-        std::string selectedStepsStr = engine.m_IO.m_Parameters[engine.m_Name];
-        std::stringstream ss(selectedStepsStr);
+        std::stringstream ss(itStepsString->second);
         std::string item;
 
         while (std::getline(ss, item, ','))
@@ -61,20 +110,7 @@ size_t BP4Deserializer::ParseMetadata(const BufferSTL &bufferSTL,
             selectedSteps.push_back(std::stoi(item));
         }
     }
-    for (size_t i = oldSteps; i < allSteps; i++)
-    {
-        if (selectedSteps.size() == 0 ||
-            std::find(selectedSteps.begin(), selectedSteps.end(), i) !=
-                selectedSteps.end())
-        {
-            ParsePGIndexPerStep(bufferSTL, engine.m_IO.m_HostLanguage, 0,
-                                i + 1);
-            ParseVariablesIndexPerStep(bufferSTL, engine, 0, i + 1);
-            ParseAttributesIndexPerStep(bufferSTL, engine, 0, i + 1);
-            lastposition = m_MetadataIndexTable[0][i + 1][3];
-        }
-    }
-    return lastposition;
+    return selectedSteps;
 }
 
 void BP4Deserializer::ParseMetadataIndex(BufferSTL &bufferSTL,
@@ -310,99 +346,156 @@ void BP4Deserializer::ParseVariablesIndexPerStep(const BufferSTL &bufferSTL,
                                                  size_t submetadatafileId,
                                                  size_t step)
 {
-    auto lf_ReadElementIndexPerStep = [&](core::Engine &engine,
-                                          const std::vector<char> &buffer,
-                                          size_t position, size_t step) {
-        const ElementIndexHeader header = ReadElementIndexHeader(
-            buffer, position, m_Minifooter.IsLittleEndian);
+    const auto &buffer = bufferSTL.m_Buffer;
+    for (const size_t position :
+         VariablesIndexPositionsPerStep(bufferSTL, submetadatafileId, step))
+    {
+        MergeVariableIndex(*StageVariableIndex(buffer, position), engine,
+                           step);
+    }
+}
 
-        switch (header.DataType)
+void BP4Deserializer::ParseMetadataThreads(const BufferSTL &bufferSTL,
+                                           core::Engine &engine,
+                                           const std::vector<size_t> &steps)
+{
+    // bounds the number of decoded, not yet merged, variable index elements
+    const size_t maxStagedElements = 1024 * m_Parameters.Threads;
+
+    const auto &buffer = bufferSTL.m_Buffer;
+    auto itStep = steps.begin();
+
+    while (itStep != steps.end())
+    {
+        // gather variable index elements from a batch of steps,
+        // pair: index in batchSteps, element position in buffer
+        std::vector<size_t> batchSteps;
+        std::vector<std::pair<size_t, size_t>> elements;
+        while (itStep != steps.end() && elements.size() < maxStagedElements)
         {
+            for (const size_t position :
+                 VariablesIndexPositionsPerStep(bufferSTL, 0, *itStep))
+            {
+                elements.emplace_back(batchSteps.size(), position);
+            }
+            batchSteps.push_back(*itStep);
+            ++itStep;
+        }
 
-#define make_case(T)                                                           \
-    case (TypeTraits<T>::type_enum):                                           \
-    {                                                                          \
-        DefineVariableInEngineIOPerStep<T>(header, engine, buffer, position,   \
-                                           step);                              \
-        break;                                                                 \
-    }
-            ADIOS2_FOREACH_STDTYPE_1ARG(make_case)
-#undef make_case
+        // decode characteristics in parallel, each thread owns a
+        // contiguous range of staged elements
+        std::vector<std::unique_ptr<StagedVariableIndex>> staged(
+            elements.size());
 
-        } // end switch
-    };
+        auto lf_Stage = [&](const size_t begin, const size_t end) {
+            for (size_t e = begin; e < end; ++e)
+            {
+                staged[e] = StageVariableIndex(buffer, elements[e].second);
+            }
+        };
+
+        helper::ParallelFor(
+            elements.size(), m_Parameters.Threads,
+            [&](const size_t, const size_t begin, const size_t end) {
+                lf_Stage(begin, end);
+            });
+
+        // merge into IO serially and in step order, since
+        // IO::DefineVariable is not thread-safe
+        size_t e = 0;
+        for (size_t s = 0; s < batchSteps.size(); ++s)
+        {
+            const size_t step = batchSteps[s];
+            ParsePGIndexPerStep(bufferSTL, engine.m_IO.m_HostLanguage, 0,
+                                step);
+            for (; e < elements.size() && elements[e].first == s; ++e)
+            {
+                MergeVariableIndex(*staged[e], engine, step);
+                staged[e].reset();
+            }
+            ParseAttributesIndexPerStep(bufferSTL, engine, 0, step);
+        }
+    }
+}
 
+std::vector<size_t>
+BP4Deserializer::VariablesIndexPositionsPerStep(const BufferSTL &bufferSTL,
+                                                size_t submetadatafileId,
+                                                size_t step) const
+{
     const auto &buffer = bufferSTL.m_Buffer;
-    size_t position = m_MetadataIndexTable[submetadatafileId][step][1];
+    size_t position = m_MetadataIndexTable.at(submetadatafileId).at(step)[1];
 
     const uint32_t count = helper::ReadValue<uint32_t>(
         buffer, position, m_Minifooter.IsLittleEndian);
     const uint64_t length = helper::ReadValue<uint64_t>(
         buffer, position, m_Minifooter.IsLittleEndian);
 
+    std::vector<size_t> positions;
+    positions.reserve(count);
+
     const size_t startPosition = position;
     size_t localPosition = 0;
 
-    /* FIXME: multi-threaded processing does not work here
-     * because DefineVariable may be called from several threads
-     */
-    /*if (m_Threads == 1)*/
+    while (localPosition < length)
     {
-        while (localPosition < length)
-        {
-            lf_ReadElementIndexPerStep(engine, buffer, position, step);
+        positions.push_back(position);
 
-            const size_t elementIndexSize =
-                static_cast<size_t>(helper::ReadValue<uint32_t>(
-                    buffer, position, m_Minifooter.IsLittleEndian));
-            position += elementIndexSize;
-            localPosition = position - startPosition;
-        }
-        return;
+        const size_t elementIndexSize =
+            static_cast<size_t>(helper::ReadValue<uint32_t>(
+                buffer, position, m_Minifooter.IsLittleEndian));
+        position += elementIndexSize;
+        localPosition = position - startPosition;
     }
-    /*
-        // threads for reading Variables
-        std::vector<std::future<void>> asyncs(m_Threads);
-        std::vector<size_t> asyncPositions(m_Threads);
+    return positions;
+}
 
-        bool launched = false;
+std::unique_ptr<BP4Deserializer::StagedVariableIndex>
+BP4Deserializer::StageVariableIndex(const std::vector<char> &buffer,
+                                    size_t position) const
+{
+    const ElementIndexHeader header =
+        ReadElementIndexHeader(buffer, position, m_Minifooter.IsLittleEndian);
 
-        while (localPosition < length)
-        {
-            // extract async positions
-            for (unsigned int t = 0; t < m_Threads; ++t)
-            {
-                asyncPositions[t] = position;
-                const size_t elementIndexSize =
-                    static_cast<size_t>(helper::ReadValue<uint32_t>(
-                        buffer, position, m_Minifooter.IsLittleEndian));
-                position += elementIndexSize;
-                localPosition = position - startPosition;
-
-                if (launched)
-                {
-                    asyncs[t].get();
-                }
+    switch (header.DataType)
+    {
 
-                if (localPosition <= length)
-                {
-                    asyncs[t] =
-                        std::async(std::launch::async,
-       lf_ReadElementIndexPerStep, std::ref(engine), std::ref(buffer),
-                                   asyncPositions[t], step);
-                }
-            }
-            launched = true;
-        }
+#define make_case(T)                                                           \
+    case (TypeTraits<T>::type_enum):                                           \
+    {                                                                          \
+        return StageVariableIndexCharacteristics<T>(header, buffer, position); \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(make_case)
+#undef make_case
 
-        for (auto &async : asyncs)
-        {
-            if (async.valid())
-            {
-                async.wait();
-            }
-        }
-    */
+    } // end switch
+
+    // unsupported types are staged without blocks and skipped at merge
+    std::unique_ptr<StagedVariableIndex> staged(new StagedVariableIndex());
+    staged->Header = header;
+    staged->Position = position;
+    return staged;
+}
+
+void BP4Deserializer::MergeVariableIndex(const StagedVariableIndex &staged,
+                                         core::Engine &engine,
+                                         size_t step) const
+{
+    switch (staged.Header.DataType)
+    {
+
+#define make_case(T)                                                           \
+    case (TypeTraits<T>::type_enum):                                           \
+    {                                                                          \
+        DefineVariableInEngineIOPerStep<T>(                                    \
+            static_cast<const StagedVariableIndexType<T> &>(staged), engine,   \
+            step);                                                             \
+        break;                                                                 \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(make_case)
+#undef make_case
+
+    } // end switch
 }
 
 /* void BP4Deserializer::ParseVariablesIndex(const BufferSTL &bufferSTL,
@@ -641,10 +734,10 @@ void BP4Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
         core::Variable<T> *variable = io.InquireVariable<T>(variableName);     \
         if (variable != nullptr)                                               \
         {                                                                      \
-            helper::ClipContiguousMemory(variable->m_Data, variable->m_Start,  \
-                                         variable->m_Count, contiguousMemory,  \
-                                         blockBox, intersectionBox,            \
-                                         m_IsRowMajor, m_ReverseDimensions);   \
+            helper::ClipContiguousMemory(                                      \
+                variable->m_Data, variable->m_Start, variable->m_Count,        \
+                contiguousMemory, blockBox, intersectionBox, m_IsRowMajor,     \
+                m_ReverseDimensions, false, m_Parameters.Threads);             \
         }                                                                      \
     }
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -666,6 +759,190 @@ bool BP4Deserializer::ReadActiveFlag(std::vector<char> &buffer)
     return m_WriterIsActive;
 }
 
+const BP4Deserializer::BlockBoxTree &
+BP4Deserializer::GetBlockBoxTree(const BlockIndexColumnsBase &columns) const
+{
+    std::lock_guard<std::mutex> lock(m_BlockIndexColumnsMutex);
+    if (!columns.BoxTree)
+    {
+        std::unique_ptr<BlockBoxTree> boxTree(new BlockBoxTree());
+        boxTree->Build(columns);
+        columns.BoxTree = std::move(boxTree);
+    }
+    return *columns.BoxTree;
+}
+
+constexpr size_t BP4Deserializer::BlockBoxTree::LeafSize;
+
+void BP4Deserializer::BlockBoxTree::Build(const BlockIndexColumnsBase &columns)
+{
+    const size_t blocks = columns.Positions.size();
+    Dimensions =
+        blocks > 0 ? columns.CountsOffsets[1] - columns.CountsOffsets[0] : 0;
+
+    BlockStarts.resize(blocks * Dimensions);
+    BlockEnds.resize(blocks * Dimensions);
+    Blocks.reserve(blocks);
+
+    for (size_t b = 0; b < blocks; ++b)
+    {
+        const size_t startsOffset = columns.StartsOffsets[b];
+        const size_t countsOffset = columns.CountsOffsets[b];
+
+        bool isIndexed =
+            Dimensions > 0 &&
+            columns.StartsOffsets[b + 1] - startsOffset == Dimensions &&
+            columns.CountsOffsets[b + 1] - countsOffset == Dimensions;
+
+        for (size_t d = 0; isIndexed && d < Dimensions; ++d)
+        {
+            const size_t start = columns.Starts[startsOffset + d];
+            const size_t count = columns.Counts[countsOffset + d];
+            isIndexed = count > 0;
+            BlockStarts[b * Dimensions + d] = start;
+            BlockEnds[b * Dimensions + d] = start + count - 1;
+        }
+
+        if (isIndexed)
+        {
+            Blocks.push_back(b);
+        }
+        else
+        {
+            Unindexed.push_back(b);
+        }
+    }
+
+    if (!Blocks.empty())
+    {
+        BuildNode(0, Blocks.size());
+    }
+}
+
+size_t BP4Deserializer::BlockBoxTree::BuildNode(const size_t first,
+                                                const size_t last)
+{
+    const size_t node = Nodes.size();
+    Nodes.push_back(Node());
+    Nodes[node].First = first;
+    Nodes[node].Last = last;
+
+    NodeStarts.resize((node + 1) * Dimensions,
+                      std::numeric_limits<size_t>::max());
+    NodeEnds.resize((node + 1) * Dimensions, 0);
+
+    // bounding box of all blocks, split along its longest side
+    size_t splitDimension = 0;
+    size_t maxExtent = 0;
+    for (size_t d = 0; d < Dimensions; ++d)
+    {
+        size_t &nodeStart = NodeStarts[node * Dimensions + d];
+        size_t &nodeEnd = NodeEnds[node * Dimensions + d];
+        for (size_t i = first; i < last; ++i)
+        {
+            const size_t b = Blocks[i];
+            nodeStart = std::min(nodeStart, BlockStarts[b * Dimensions + d]);
+            nodeEnd = std::max(nodeEnd, BlockEnds[b * Dimensions + d]);
+        }
+
+        if (nodeEnd - nodeStart >= maxExtent)
+        {
+            maxExtent = nodeEnd - nodeStart;
+            splitDimension = d;
+        }
+    }
+
+    if (last - first <= LeafSize)
+    {
+        return node;
+    }
+
+    const size_t middle = first + (last - first) / 2;
+    std::nth_element(
+        Blocks.begin() + first, Blocks.begin() + middle, Blocks.begin() + last,
+        [&](const size_t b1, const size_t b2) {
+            const size_t i1 = b1 * Dimensions + splitDimension;
+            const size_t i2 = b2 * Dimensions + splitDimension;
+            return BlockStarts[i1] < BlockStarts[i2] ||
+                   (BlockStarts[i1] == BlockStarts[i2] &&
+                    BlockEnds[i1] < BlockEnds[i2]);
+        });
+
+    // children are pushed after node, Nodes may reallocate
+    const size_t left = BuildNode(first, middle);
+    const size_t right = BuildNode(middle, last);
+    Nodes[node].Left = left;
+    Nodes[node].Right = right;
+    return node;
+}
+
+std::vector<size_t>
+BP4Deserializer::BlockBoxTree::Intersect(const Box<Dims> &selectionBox) const
+{
+    std::vector<size_t> hits(Unindexed);
+
+    if (selectionBox.first.size() != Dimensions ||
+        selectionBox.second.size() != Dimensions)
+    {
+        // let the caller check and report every block
+        hits.insert(hits.end(), Blocks.begin(), Blocks.end());
+        std::sort(hits.begin(), hits.end());
+        return hits;
+    }
+
+    auto lf_Intersects = [&](const std::vector<size_t> &starts,
+                             const std::vector<size_t> &ends,
+                             const size_t index) -> bool {
+        for (size_t d = 0; d < Dimensions; ++d)
+        {
+            if (selectionBox.first[d] > ends[index * Dimensions + d] ||
+                selectionBox.second[d] < starts[index * Dimensions + d])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<size_t> nodes;
+    if (!Nodes.empty())
+    {
+        nodes.push_back(0);
+    }
+
+    while (!nodes.empty())
+    {
+        const size_t n = nodes.back();
+        nodes.pop_back();
+
+        if (!lf_Intersects(NodeStarts, NodeEnds, n))
+        {
+            continue;
+        }
+
+        const Node &node = Nodes[n];
+
+        if (node.Left == 0) // leaf
+        {
+            for (size_t i = node.First; i < node.Last; ++i)
+            {
+                if (lf_Intersects(BlockStarts, BlockEnds, Blocks[i]))
+                {
+                    hits.push_back(Blocks[i]);
+                }
+            }
+        }
+        else
+        {
+            nodes.push_back(node.Right);
+            nodes.push_back(node.Left);
+        }
+    }
+
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
 #define declare_template_instantiation(T)                                      \
     template void BP4Deserializer::GetSyncVariableDataFromStream(              \
         core::Variable<T> &, BufferSTL &) const;                               \
@@ -716,7 +993,12 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
                                                                                \
     template void BP4Deserializer::PostDataRead(                               \
         core::Variable<T> &, typename core::Variable<T>::BPInfo &,             \
-        const helper::SubStreamBoxInfo &, const bool, const size_t);
+        const helper::SubStreamBoxInfo &, const bool, const size_t,            \
+        const char *);                                                         \
+                                                                               \
+    template void BP4Deserializer::ClipBlock(                                  \
+        const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
+        const helper::SubStreamBoxInfo &, T *, const char *) const;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
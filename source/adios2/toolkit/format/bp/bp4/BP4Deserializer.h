@@ -15,6 +15,8 @@
 
 #include "BP4Base.h"
 
+#include <map>
+#include <memory> //std::unique_ptr
 #include <mutex>
 #include <set>
 #include <utility> //std::pair
@@ -58,6 +60,26 @@ public:
     size_t ParseMetadata(const BufferSTL &bufferSTL, core::Engine &engine,
                          const bool firstStep = true);
 
+    /**
+     * Parses the metadata of the given steps only, without updating the
+     * number of available steps
+     * @param bufferSTL metadata buffer, positions in m_MetadataIndexTable of
+     * the given steps must point into it
+     * @param engine reader engine owning the IO to define variables in
+     * @param steps steps (starting at 1) to be parsed, in increasing order
+     * @return position in the buffer where processing ends
+     */
+    size_t ParseMetadataSteps(const BufferSTL &bufferSTL, core::Engine &engine,
+                              const std::vector<size_t> &steps);
+
+    /**
+     * Steps (starting at 0) selected by the user with a parameter whose key
+     * is the engine name, e.g. io.SetParameter(fileName, "1,3")
+     * @param engine reader engine
+     * @return selected steps, empty if no selection
+     */
+    std::vector<size_t> GetSelectedSteps(const core::Engine &engine) const;
+
     /**
      * Used to get the variable payload data for the current selection (dims and
      * steps), used in single buffer for streaming
@@ -112,12 +134,33 @@ public:
                      char *&buffer, size_t &payloadSize, size_t &payloadOffset,
                      const size_t threadID = 0);
 
+    /**
+     * Decodes and clips a block read after PreDataRead
+     * @param postOpData operated payload already in memory (e.g. a file
+     * mapping), nullptr: the thread buffer PreDataRead returned
+     */
     template <class T>
     void PostDataRead(core::Variable<T> &variable,
                       typename core::Variable<T>::BPInfo &blockInfo,
                       const helper::SubStreamBoxInfo &subStreamBoxInfo,
                       const bool isRowMajorDestination,
-                      const size_t threadID = 0);
+                      const size_t threadID = 0,
+                      const char *postOpData = nullptr);
+
+    /**
+     * Clips the payload of a block without operations into user memory,
+     * thread-safe for disjoint destinations
+     * @param variable owner of blockInfo
+     * @param blockInfo user selection
+     * @param subStreamBoxInfo block to be clipped
+     * @param data user memory of the selection at the block's step
+     * @param payload raw block data, starts at subStreamBoxInfo.Seeks.first
+     */
+    template <class T>
+    void ClipBlock(const core::Variable<T> &variable,
+                   const typename core::Variable<T>::BPInfo &blockInfo,
+                   const helper::SubStreamBoxInfo &subStreamBoxInfo, T *data,
+                   const char *payload) const;
 
     /**
      * Clips and assigns memory to blockInfo.Data from a contiguous memory
@@ -199,25 +242,97 @@ private:
                                     core::Engine &engine,
                                     size_t submetadatafileId, size_t step);
 
+    /**
+     * Parses the metadata of several steps using m_Parameters.Threads.
+     * Variable index characteristics are decoded in parallel into staged
+     * records, then merged into engine.m_IO serially in step order.
+     * @param bufferSTL metadata buffer
+     * @param engine reader engine owning the IO to define variables in
+     * @param steps steps (starting at 1) to be parsed, in increasing order
+     */
+    void ParseMetadataThreads(const BufferSTL &bufferSTL,
+                              core::Engine &engine,
+                              const std::vector<size_t> &steps);
+
+    /**
+     * Returns the positions of all variable index elements of a step
+     * @param bufferSTL metadata buffer
+     * @param submetadatafileId
+     * @param step
+     * @return element positions in bufferSTL.m_Buffer
+     */
+    std::vector<size_t>
+    VariablesIndexPositionsPerStep(const BufferSTL &bufferSTL,
+                                   size_t submetadatafileId,
+                                   size_t step) const;
+
     // void ParseAttributesIndex(const BufferSTL &bufferSTL, core::IO &io);
     void ParseAttributesIndexPerStep(const BufferSTL &bufferSTL,
                                      core::Engine &engine,
                                      size_t submetadatafileId, size_t step);
 
+    /** Fields of a single characteristics set (block) in a variable index
+     * needed to update a Variable<T> */
+    template <class T>
+    struct StagedBlockIndex
+    {
+        /** characteristics set position in metadata buffer */
+        size_t Position = 0;
+        /** as stored in the file, not reversed */
+        Dims Shape;
+        T Min = T();
+        T Max = T();
+        uint32_t Step = 0;
+        ShapeID EntryShapeID = ShapeID::Unknown;
+    };
+
     /**
-     * Reads a variable index element (serialized) and calls IO.DefineVariable
-     * to deserialize the Variable metadata
-     * @param header serialize
-     * @param io
-     * @param buffer
-     * @param position
+     * A variable index element decoded from metadata without touching IO.
+     * Staging is thread-safe, while merging into IO (DefineVariable) is not.
      */
+    struct StagedVariableIndex
+    {
+        ElementIndexHeader Header;
+        /** position of the first characteristics set in metadata buffer */
+        size_t Position = 0;
+
+        virtual ~StagedVariableIndex() = default;
+    };
 
     template <class T>
-    void DefineVariableInEngineIOPerStep(const ElementIndexHeader &header,
+    struct StagedVariableIndexType : public StagedVariableIndex
+    {
+        /** characteristics of the first block */
+        Characteristics<T> First;
+        std::vector<StagedBlockIndex<T>> Blocks;
+    };
+
+    /**
+     * Decodes a variable index element, thread-safe
+     * @param buffer metadata buffer
+     * @param position start of the variable index element
+     * @return staged element, to be passed to MergeVariableIndex
+     */
+    std::unique_ptr<StagedVariableIndex>
+    StageVariableIndex(const std::vector<char> &buffer, size_t position) const;
+
+    template <class T>
+    std::unique_ptr<StagedVariableIndex>
+    StageVariableIndexCharacteristics(const ElementIndexHeader &header,
+                                      const std::vector<char> &buffer,
+                                      size_t position) const;
+
+    /**
+     * Defines or updates the variable of a staged element in engine.m_IO,
+     * not thread-safe
+     */
+    void MergeVariableIndex(const StagedVariableIndex &staged,
+                            core::Engine &engine, size_t step) const;
+
+    template <class T>
+    void DefineVariableInEngineIOPerStep(const StagedVariableIndexType<T> &staged,
                                          core::Engine &engine,
-                                         const std::vector<char> &buffer,
-                                         size_t position, size_t step) const;
+                                         size_t step) const;
 
     template <class T>
     void DefineAttributeInEngineIO(const ElementIndexHeader &header,
@@ -225,9 +340,134 @@ private:
                                    const std::vector<char> &buffer,
                                    size_t position) const;
 
+    struct BlockIndexColumnsBase;
+
+    /**
+     * Bounding volume tree (binary R-tree) over the boxes of the blocks of a
+     * variable in a step, finds the blocks intersecting a selection in
+     * O(log(blocks) + hits) instead of testing every block
+     */
+    struct BlockBoxTree
+    {
+        struct Node
+        {
+            /** leaves own Blocks[First, Last) */
+            size_t First = 0;
+            size_t Last = 0;
+            /** children in Nodes, 0 (root) for leaves */
+            size_t Left = 0;
+            size_t Right = 0;
+        };
+
+        /** maximum blocks in a leaf */
+        static constexpr size_t LeafSize = 8;
+
+        size_t Dimensions = 0;
+        std::vector<Node> Nodes;
+        /** node n box is [NodeStarts, NodeEnds] at n * Dimensions, in file
+         * order, end inclusive */
+        std::vector<size_t> NodeStarts;
+        std::vector<size_t> NodeEnds;
+        /** block b box is [BlockStarts, BlockEnds] at b * Dimensions */
+        std::vector<size_t> BlockStarts;
+        std::vector<size_t> BlockEnds;
+        /** indexed block ids, each leaf owns a contiguous range */
+        std::vector<size_t> Blocks;
+        /** blocks with zero count or different dimensions, always returned
+         * by Intersect to be checked by the caller */
+        std::vector<size_t> Unindexed;
+
+        /**
+         * Builds the tree from block Start and Count columns
+         * @param columns
+         */
+        void Build(const BlockIndexColumnsBase &columns);
+
+        /**
+         * Finds blocks whose box may intersect a selection
+         * @param selectionBox start and end (inclusive) in file order
+         * @return block ids in increasing order
+         */
+        std::vector<size_t> Intersect(const Box<Dims> &selectionBox) const;
+
+    private:
+        size_t BuildNode(const size_t first, const size_t last);
+    };
+
+    /**
+     * Block index of a variable in a step stored as columns (structure of
+     * arrays), decoded once from the characteristics in metadata and reused
+     * by BlocksInfo queries and block selection instead of deserializing
+     * again. Dimensions are stored as in the file, not reversed.
+     */
+    struct BlockIndexColumnsBase
+    {
+        /** characteristics set positions in metadata buffer, used as key */
+        std::vector<size_t> Positions;
+        /** block b shape is in [ShapesOffsets[b], ShapesOffsets[b+1]) of
+         * Shapes, same for Starts and Counts */
+        std::vector<size_t> ShapesOffsets;
+        std::vector<size_t> Shapes;
+        std::vector<size_t> StartsOffsets;
+        std::vector<size_t> Starts;
+        std::vector<size_t> CountsOffsets;
+        std::vector<size_t> Counts;
+        /** built on first selection, see GetBlockBoxTree */
+        mutable std::unique_ptr<BlockBoxTree> BoxTree;
+
+        virtual ~BlockIndexColumnsBase() = default;
+    };
+
+    template <class T>
+    struct BlockIndexColumns : public BlockIndexColumnsBase
+    {
+        std::vector<T> Mins;
+        std::vector<T> Maxs;
+        std::vector<T> Values;
+        /** block b sub-block min-max are in
+         * [MinMaxsOffsets[b], MinMaxsOffsets[b+1]) of MinMaxs */
+        std::vector<size_t> MinMaxsOffsets;
+        std::vector<T> MinMaxs;
+        std::vector<helper::BlockDivisionInfo> SubBlockInfos;
+        std::vector<uint64_t> PayloadOffsets;
+        std::vector<uint32_t> Steps;
+        std::vector<uint32_t> FileIndices;
+        std::vector<char> IsValues;
+    };
+
+    /** key: {variable name, step starting at 1} */
+    mutable std::map<std::pair<std::string, size_t>,
+                     std::unique_ptr<BlockIndexColumnsBase>>
+        m_BlockIndexColumns;
+
+    /** protects m_BlockIndexColumns in const queries */
+    mutable std::mutex m_BlockIndexColumnsMutex;
+
+    /**
+     * Returns the columnar block index of a variable in a step, decoding it
+     * from metadata if not cached or if block positions changed
+     * @param variable
+     * @param step starting at 1
+     * @param blocksIndexOffsets characteristics positions for step
+     * @return cached columns, valid until next metadata parsing
+     */
+    template <class T>
+    const BlockIndexColumns<T> &
+    GetBlockIndexColumns(const core::Variable<T> &variable, const size_t step,
+                         const std::vector<size_t> &blocksIndexOffsets) const;
+
+    /**
+     * Returns the spatial index of the blocks in columns, building it on
+     * first use
+     * @param columns from GetBlockIndexColumns
+     * @return tree valid as long as columns
+     */
+    const BlockBoxTree &
+    GetBlockBoxTree(const BlockIndexColumnsBase &columns) const;
+
     template <class T>
     std::vector<typename core::Variable<T>::BPInfo>
-    BlocksInfoCommon(const core::Variable<T> &variable,
+    BlocksInfoCommon(const core::Variable<T> &variable, const size_t step,
                      const std::vector<size_t> &blocksIndexOffsets) const;
 
     template <class T>
@@ -288,7 +528,12 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
                                                                                \
     extern template void BP4Deserializer::PostDataRead(                        \
         core::Variable<T> &, typename core::Variable<T>::BPInfo &,             \
-        const helper::SubStreamBoxInfo &, const bool, const size_t);
+        const helper::SubStreamBoxInfo &, const bool, const size_t,            \
+        const char *);                                                         \
+                                                                               \
+    extern template void BP4Deserializer::ClipBlock(                           \
+        const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
+        const helper::SubStreamBoxInfo &, T *, const char *) const;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -17,6 +17,7 @@
 
 #include <algorithm> //std::reverse
 #include <iostream>
+#include <iterator> //std::reverse_iterator
 #include <unordered_set>
 
 #include "adios2/helper/adiosFunctions.h"
@@ -390,12 +391,15 @@ void BP4Deserializer::SetVariableBlockInfo(
                         ", in call to Get");
                 }
             }
-            // Get intersections with each block
-            for (const size_t blockOffset : blockOffsets)
+            // Get intersections with blocks found in the spatial index
+            const BlockIndexColumns<T> &columns =
+                GetBlockIndexColumns(variable, step, blockOffsets);
+            for (const size_t block :
+                 GetBlockBoxTree(columns).Intersect(selectionBox))
             {
-                lf_SetSubStreamInfoGlobalArray(variable.m_Name, selectionBox,
-                                               blockInfo, step, blockOffset,
-                                               m_Metadata, m_IsRowMajor);
+                lf_SetSubStreamInfoGlobalArray(
+                    variable.m_Name, selectionBox, blockInfo, step,
+                    blockOffsets[block], m_Metadata, m_IsRowMajor);
             }
         }
         else if (variable.m_ShapeID == ShapeID::LocalArray)
@@ -508,7 +512,8 @@ template <class T>
 void BP4Deserializer::PostDataRead(
     core::Variable<T> &variable, typename core::Variable<T>::BPInfo &blockInfo,
     const helper::SubStreamBoxInfo &subStreamBoxInfo,
-    const bool isRowMajorDestination, const size_t threadID)
+    const bool isRowMajorDestination, const size_t threadID,
+    const char *postOpData)
 {
     if (subStreamBoxInfo.OperationsInfo.size() > 0 &&
         !IdentityOperation<T>(blockInfo.Operations))
@@ -527,7 +532,10 @@ void BP4Deserializer::PostDataRead(
 
         // get original block back
         char *preOpData = m_ThreadBuffers[threadID][0].data();
-        const char *postOpData = m_ThreadBuffers[threadID][1].data();
+        if (postOpData == nullptr)
+        {
+            postOpData = m_ThreadBuffers[threadID][1].data();
+        }
         bp4Op->GetData(postOpData, blockOperationInfo, preOpData);
 
         // clip block to match selection
@@ -536,6 +544,17 @@ void BP4Deserializer::PostDataRead(
                            subStreamBoxInfo.Seeks.second);
     }
 
+    ClipBlock(variable, blockInfo, subStreamBoxInfo, blockInfo.Data,
+              m_ThreadBuffers[threadID][0].data());
+}
+
+template <class T>
+void BP4Deserializer::ClipBlock(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::BPInfo &blockInfo,
+    const helper::SubStreamBoxInfo &subStreamBoxInfo, T *data,
+    const char *payload) const
+{
 #ifdef ADIOS2_HAVE_ENDIAN_REVERSE
     const bool endianReverse =
         (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian) ? true
@@ -549,11 +568,11 @@ void BP4Deserializer::PostDataRead(
             ? Dims(blockInfo.Count.size(), 0)
             : blockInfo.Start;
 
-    helper::ClipContiguousMemory(
-        blockInfo.Data, blockInfoStart, blockInfo.Count,
-        m_ThreadBuffers[threadID][0].data(), subStreamBoxInfo.BlockBox,
-        subStreamBoxInfo.IntersectionBox, m_IsRowMajor, m_ReverseDimensions,
-        endianReverse);
+    helper::ClipContiguousMemory(data, blockInfoStart, blockInfo.Count, payload,
+                                 subStreamBoxInfo.BlockBox,
+                                 subStreamBoxInfo.IntersectionBox, m_IsRowMajor,
+                                 m_ReverseDimensions, endianReverse,
+                                 m_Parameters.Threads);
 }
 
 template <class T>
@@ -569,7 +588,7 @@ BP4Deserializer::AllStepsBlocksInfo(const core::Variable<T> &variable) const
         const std::vector<size_t> &blockPositions = pair.second;
         // bp4 index starts at 1
         allStepsBlocksInfo[step - 1] =
-            BlocksInfoCommon(variable, blockPositions);
+            BlocksInfoCommon(variable, step, blockPositions);
     }
     return allStepsBlocksInfo;
 }
@@ -588,7 +607,7 @@ BP4Deserializer::AllRelativeStepsBlocksInfo(
     {
         const std::vector<size_t> &blockPositions = pair.second;
         allRelativeStepsBlocksInfo[relativeStep] =
-            BlocksInfoCommon(variable, blockPositions);
+            BlocksInfoCommon(variable, pair.first, blockPositions);
         ++relativeStep;
     }
     return allRelativeStepsBlocksInfo;
@@ -605,7 +624,7 @@ BP4Deserializer::BlocksInfo(const core::Variable<T> &variable,
     {
         return std::vector<typename core::Variable<T>::BPInfo>();
     }
-    return BlocksInfoCommon(variable, itStep->second);
+    return BlocksInfoCommon(variable, itStep->first, itStep->second);
 }
 
 template <class T>
@@ -614,24 +633,77 @@ void BP4Deserializer::ClipContiguousMemory(
     const std::vector<char> &contiguousMemory, const Box<Dims> &blockBox,
     const Box<Dims> &intersectionBox) const
 {
-    helper::ClipContiguousMemory(
-        blockInfo.Data, blockInfo.Start, blockInfo.Count, contiguousMemory,
-        blockBox, intersectionBox, m_IsRowMajor, m_ReverseDimensions);
+    helper::ClipContiguousMemory(blockInfo.Data, blockInfo.Start,
+                                 blockInfo.Count, contiguousMemory, blockBox,
+                                 intersectionBox, m_IsRowMajor,
+                                 m_ReverseDimensions, false,
+                                 m_Parameters.Threads);
 }
 
 // PRIVATE
 
+template <class T>
+std::unique_ptr<BP4Deserializer::StagedVariableIndex>
+BP4Deserializer::StageVariableIndexCharacteristics(
+    const ElementIndexHeader &header, const std::vector<char> &buffer,
+    size_t position) const
+{
+    std::unique_ptr<StagedVariableIndexType<T>> staged(
+        new StagedVariableIndexType<T>());
+    staged->Header = header;
+    staged->Position = position;
+
+    // going back to get variable index position
+    const size_t endPosition =
+        position -
+        (header.Name.size() + header.GroupName.size() + header.Path.size() +
+         23) +
+        static_cast<size_t>(header.Length) + 4;
+
+    while (position < endPosition)
+    {
+        const size_t subsetPosition = position;
+
+        // read until step is found
+        Characteristics<T> subsetCharacteristics =
+            ReadElementIndexCharacteristics<T>(
+                buffer, position, static_cast<DataTypes>(header.DataType),
+                false, m_Minifooter.IsLittleEndian);
+
+        if (subsetPosition == staged->Position)
+        {
+            staged->First = subsetCharacteristics;
+        }
+
+        StagedBlockIndex<T> block;
+        block.Position = subsetPosition;
+        block.Step = subsetCharacteristics.Statistics.Step;
+        block.EntryShapeID = subsetCharacteristics.EntryShapeID;
+        if (block.EntryShapeID == ShapeID::GlobalArray)
+        {
+            block.Shape = std::move(subsetCharacteristics.Shape);
+        }
+        block.Min = staged->First.Statistics.IsValue
+                        ? subsetCharacteristics.Statistics.Value
+                        : subsetCharacteristics.Statistics.Min;
+        block.Max = staged->First.Statistics.IsValue
+                        ? subsetCharacteristics.Statistics.Value
+                        : subsetCharacteristics.Statistics.Max;
+        staged->Blocks.push_back(std::move(block));
+
+        position = subsetPosition + subsetCharacteristics.EntryLength + 5;
+    }
+
+    return std::move(staged);
+}
+
 template <>
 inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
-    const ElementIndexHeader &header, core::Engine &engine,
-    const std::vector<char> &buffer, size_t position, size_t step) const
+    const StagedVariableIndexType<std::string> &staged, core::Engine &engine,
+    size_t step) const
 {
-    const size_t initialPosition = position;
-
-    const Characteristics<std::string> characteristics =
-        ReadElementIndexCharacteristics<std::string>(
-            buffer, position, static_cast<DataTypes>(header.DataType), false,
-            m_Minifooter.IsLittleEndian);
+    const ElementIndexHeader &header = staged.Header;
+    const Characteristics<std::string> &characteristics = staged.First;
 
     const std::string variableName =
         header.Path.empty() ? header.Name
@@ -641,29 +713,15 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
     variable = engine.m_IO.InquireVariable<std::string>(variableName);
     if (variable)
     {
-        size_t endPositionCurrentStep =
-            initialPosition -
-            (header.Name.size() + header.GroupName.size() + header.Path.size() +
-             23) +
-            static_cast<size_t>(header.Length) + 4;
-        position = initialPosition;
         // variable->m_AvailableStepsCount = step;
         ++variable->m_AvailableStepsCount;
         // std::cout << variable->m_Name << ", " <<
         // variable->m_AvailableStepsCount << std::endl;
-        while (position < endPositionCurrentStep)
+        for (const StagedBlockIndex<std::string> &block : staged.Blocks)
         {
-            const size_t subsetPosition = position;
-
-            // read until step is found
-            const Characteristics<std::string> subsetCharacteristics =
-                ReadElementIndexCharacteristics<std::string>(
-                    buffer, position, static_cast<DataTypes>(header.DataType),
-                    false, m_Minifooter.IsLittleEndian);
-
-            if (subsetCharacteristics.EntryShapeID == ShapeID::LocalValue)
+            if (block.EntryShapeID == ShapeID::LocalValue)
             {
-                if (subsetPosition == initialPosition)
+                if (block.Position == staged.Position)
                 {
                     // reset shape and count
                     variable->m_Shape[0] = 1;
@@ -677,8 +735,7 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
             }
 
             variable->m_AvailableStepBlockIndexOffsets[step].push_back(
-                subsetPosition);
-            position = subsetPosition + subsetCharacteristics.EntryLength + 5;
+                block.Position);
         }
         return;
     }
@@ -707,36 +764,22 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
 
     // going back to get variable index position
     variable->m_IndexStart =
-        initialPosition - (header.Name.size() + header.GroupName.size() +
+        staged.Position - (header.Name.size() + header.GroupName.size() +
                            header.Path.size() + 23);
 
-    const size_t endPosition =
-        variable->m_IndexStart + static_cast<size_t>(header.Length) + 4;
-
-    position = initialPosition;
-
     size_t currentStep = 0; // Starts at 1 in bp file
     std::set<uint32_t> stepsFound;
     variable->m_AvailableStepsCount = 0;
-    while (position < endPosition)
+    for (const StagedBlockIndex<std::string> &block : staged.Blocks)
     {
-        const size_t subsetPosition = position;
-
-        // read until step is found
-        const Characteristics<std::string> subsetCharacteristics =
-            ReadElementIndexCharacteristics<std::string>(
-                buffer, position, static_cast<DataTypes>(header.DataType),
-                false, m_Minifooter.IsLittleEndian);
-
-        const bool isNextStep =
-            stepsFound.insert(subsetCharacteristics.Statistics.Step).second;
+        const bool isNextStep = stepsFound.insert(block.Step).second;
 
         // if new step is inserted
         if (isNextStep)
         {
-            currentStep = subsetCharacteristics.Statistics.Step;
+            currentStep = block.Step;
             ++variable->m_AvailableStepsCount;
-            if (subsetCharacteristics.EntryShapeID == ShapeID::LocalValue)
+            if (block.EntryShapeID == ShapeID::LocalValue)
             {
                 // reset shape and count
                 variable->m_Shape[0] = 1;
@@ -745,7 +788,7 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
         }
         else
         {
-            if (subsetCharacteristics.EntryShapeID == ShapeID::LocalValue)
+            if (block.EntryShapeID == ShapeID::LocalValue)
             {
                 ++variable->m_Shape[0];
                 ++variable->m_Count[0];
@@ -753,8 +796,7 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
         }
 
         variable->m_AvailableStepBlockIndexOffsets[currentStep].push_back(
-            subsetPosition);
-        position = subsetPosition + subsetCharacteristics.EntryLength + 5;
+            block.Position);
     }
 
     if (variable->m_ShapeID == ShapeID::LocalValue)
@@ -772,20 +814,21 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
 /* Define the variable of each step when parsing the metadata */
 template <class T>
 void BP4Deserializer::DefineVariableInEngineIOPerStep(
-    const ElementIndexHeader &header, core::Engine &engine,
-    const std::vector<char> &buffer, size_t position, size_t step) const
+    const StagedVariableIndexType<T> &staged, core::Engine &engine,
+    size_t step) const
 {
-    const size_t initialPosition = position;
-
-    const Characteristics<T> characteristics =
-        ReadElementIndexCharacteristics<T>(
-            buffer, position, static_cast<DataTypes>(header.DataType), false,
-            m_Minifooter.IsLittleEndian);
+    const ElementIndexHeader &header = staged.Header;
+    const Characteristics<T> &characteristics = staged.First;
 
     const std::string variableName =
         header.Path.empty() ? header.Name
                             : header.Path + PathSeparator + header.Name;
 
+    auto lf_Shape = [&](const Dims &shape) -> Dims {
+        return m_ReverseDimensions ? Dims(shape.rbegin(), shape.rend())
+                                   : shape;
+    };
+
     core::Variable<T> *variable = nullptr;
     {
         // to prevent conflict with DefineVariable
@@ -795,44 +838,23 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
 
     if (variable)
     {
-        size_t endPositionCurrentStep =
-            initialPosition -
-            (header.Name.size() + header.GroupName.size() + header.Path.size() +
-             23) +
-            static_cast<size_t>(header.Length) + 4;
-        position = initialPosition;
         // variable->m_AvailableStepsCount = step;
         ++variable->m_AvailableStepsCount;
-        while (position < endPositionCurrentStep)
+        for (const StagedBlockIndex<T> &block : staged.Blocks)
         {
-            const size_t subsetPosition = position;
-
-            // read until step is found
-            const Characteristics<T> subsetCharacteristics =
-                ReadElementIndexCharacteristics<T>(
-                    buffer, position, static_cast<DataTypes>(header.DataType),
-                    false, m_Minifooter.IsLittleEndian);
-
-            const T blockMin = characteristics.Statistics.IsValue
-                                   ? subsetCharacteristics.Statistics.Value
-                                   : subsetCharacteristics.Statistics.Min;
-            const T blockMax = characteristics.Statistics.IsValue
-                                   ? subsetCharacteristics.Statistics.Value
-                                   : subsetCharacteristics.Statistics.Max;
-
-            if (helper::LessThan(blockMin, variable->m_Min))
+            if (helper::LessThan(block.Min, variable->m_Min))
             {
-                variable->m_Min = blockMin;
+                variable->m_Min = block.Min;
             }
 
-            if (helper::GreaterThan(blockMax, variable->m_Max))
+            if (helper::GreaterThan(block.Max, variable->m_Max))
             {
-                variable->m_Max = blockMax;
+                variable->m_Max = block.Max;
             }
 
-            if (subsetCharacteristics.EntryShapeID == ShapeID::LocalValue)
+            if (block.EntryShapeID == ShapeID::LocalValue)
             {
-                if (subsetPosition == initialPosition)
+                if (block.Position == staged.Position)
                 {
                     // reset shape and count
                     variable->m_Shape[0] = 1;
@@ -844,22 +866,17 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
                     ++variable->m_Count[0];
                 }
             }
-            else if (subsetCharacteristics.EntryShapeID == ShapeID::GlobalArray)
+            else if (block.EntryShapeID == ShapeID::GlobalArray)
             {
                 // Shape definition is by the last block now, not the first
                 // block
-                const Dims shape =
-                    m_ReverseDimensions
-                        ? Dims(subsetCharacteristics.Shape.rbegin(),
-                               subsetCharacteristics.Shape.rend())
-                        : subsetCharacteristics.Shape;
+                const Dims shape = lf_Shape(block.Shape);
                 variable->m_Shape = shape;
                 variable->m_AvailableShapes[step] = shape;
             }
 
             variable->m_AvailableStepBlockIndexOffsets[step].push_back(
-                subsetPosition);
-            position = subsetPosition + subsetCharacteristics.EntryLength + 5;
+                block.Position);
         }
         return;
     }
@@ -875,10 +892,7 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
         }
         case (ShapeID::GlobalArray):
         {
-            const Dims shape = m_ReverseDimensions
-                                   ? Dims(characteristics.Shape.rbegin(),
-                                          characteristics.Shape.rend())
-                                   : characteristics.Shape;
+            const Dims shape = lf_Shape(characteristics.Shape);
 
             variable = &engine.m_IO.DefineVariable<T>(
                 variableName, shape, Dims(shape.size(), 0), shape);
@@ -895,10 +909,7 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
         }
         case (ShapeID::LocalArray):
         {
-            const Dims count = m_ReverseDimensions
-                                   ? Dims(characteristics.Count.rbegin(),
-                                          characteristics.Count.rend())
-                                   : characteristics.Count;
+            const Dims count = lf_Shape(characteristics.Count);
             variable =
                 &engine.m_IO.DefineVariable<T>(variableName, {}, {}, count);
             break;
@@ -924,42 +935,21 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
 
     // going back to get variable index position
     variable->m_IndexStart =
-        initialPosition - (header.Name.size() + header.GroupName.size() +
+        staged.Position - (header.Name.size() + header.GroupName.size() +
                            header.Path.size() + 23);
 
-    const size_t endPosition =
-        variable->m_IndexStart + static_cast<size_t>(header.Length) + 4;
-
-    position = initialPosition;
-
     size_t currentStep = 0; // Starts at 1 in bp file
     std::set<uint32_t> stepsFound;
     variable->m_AvailableStepsCount = 0;
-    while (position < endPosition)
+    for (const StagedBlockIndex<T> &block : staged.Blocks)
     {
-        const size_t subsetPosition = position;
-
-        // read until step is found
-        const Characteristics<T> subsetCharacteristics =
-            ReadElementIndexCharacteristics<T>(
-                buffer, position, static_cast<DataTypes>(header.DataType),
-                false, m_Minifooter.IsLittleEndian);
-
-        const T blockMin = characteristics.Statistics.IsValue
-                               ? subsetCharacteristics.Statistics.Value
-                               : subsetCharacteristics.Statistics.Min;
-        const T blockMax = characteristics.Statistics.IsValue
-                               ? subsetCharacteristics.Statistics.Value
-                               : subsetCharacteristics.Statistics.Max;
-
-        const bool isNextStep =
-            stepsFound.insert(subsetCharacteristics.Statistics.Step).second;
+        const bool isNextStep = stepsFound.insert(block.Step).second;
 
         if (isNextStep)
         {
-            currentStep = subsetCharacteristics.Statistics.Step;
+            currentStep = block.Step;
             ++variable->m_AvailableStepsCount;
-            if (subsetCharacteristics.EntryShapeID == ShapeID::LocalValue)
+            if (block.EntryShapeID == ShapeID::LocalValue)
             {
                 // reset shape and count
                 variable->m_Shape[0] = 1;
@@ -968,7 +958,7 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
         }
         else
         {
-            if (subsetCharacteristics.EntryShapeID == ShapeID::LocalValue)
+            if (block.EntryShapeID == ShapeID::LocalValue)
             {
                 ++variable->m_Shape[0];
                 ++variable->m_Count[0];
@@ -976,35 +966,30 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
         }
 
         // Shape definition is by the last block now, not the first block
-        if (subsetCharacteristics.EntryShapeID == ShapeID::GlobalArray)
+        if (block.EntryShapeID == ShapeID::GlobalArray)
         {
-            const Dims shape = m_ReverseDimensions
-                                   ? Dims(subsetCharacteristics.Shape.rbegin(),
-                                          subsetCharacteristics.Shape.rend())
-                                   : subsetCharacteristics.Shape;
+            const Dims shape = lf_Shape(block.Shape);
             variable->m_Shape = shape;
             variable->m_AvailableShapes[currentStep] = shape;
         }
 
         // update min max for global values only if new step is found
-        if ((isNextStep &&
-             subsetCharacteristics.EntryShapeID == ShapeID::GlobalValue) ||
-            (subsetCharacteristics.EntryShapeID != ShapeID::GlobalValue))
+        if ((isNextStep && block.EntryShapeID == ShapeID::GlobalValue) ||
+            (block.EntryShapeID != ShapeID::GlobalValue))
         {
-            if (helper::LessThan(blockMin, variable->m_Min))
+            if (helper::LessThan(block.Min, variable->m_Min))
             {
-                variable->m_Min = blockMin;
+                variable->m_Min = block.Min;
             }
 
-            if (helper::GreaterThan(blockMax, variable->m_Max))
+            if (helper::GreaterThan(block.Max, variable->m_Max))
             {
-                variable->m_Max = blockMax;
+                variable->m_Max = block.Max;
             }
         }
 
         variable->m_AvailableStepBlockIndexOffsets[currentStep].push_back(
-            subsetPosition);
-        position = subsetPosition + subsetCharacteristics.EntryLength + 5;
+            block.Position);
     }
 
     if (variable->m_ShapeID == ShapeID::LocalValue)
@@ -1139,15 +1124,47 @@ BP4Deserializer::GetSubFileInfo(const core::Variable<T> &variable) const
 
 // PRIVATE
 template <class T>
-std::vector<typename core::Variable<T>::BPInfo>
-BP4Deserializer::BlocksInfoCommon(
-    const core::Variable<T> &variable,
+const BP4Deserializer::BlockIndexColumns<T> &
+BP4Deserializer::GetBlockIndexColumns(
+    const core::Variable<T> &variable, const size_t step,
     const std::vector<size_t> &blocksIndexOffsets) const
 {
-    std::vector<typename core::Variable<T>::BPInfo> blocksInfo;
-    blocksInfo.reserve(blocksIndexOffsets.size());
+    std::lock_guard<std::mutex> lock(m_BlockIndexColumnsMutex);
+
+    std::unique_ptr<BlockIndexColumnsBase> &cached =
+        m_BlockIndexColumns[std::make_pair(variable.m_Name, step)];
+
+    const BlockIndexColumns<T> *cachedColumns =
+        dynamic_cast<const BlockIndexColumns<T> *>(cached.get());
+    if (cachedColumns != nullptr &&
+        cachedColumns->Positions == blocksIndexOffsets)
+    {
+        return *cachedColumns;
+    }
+
+    BlockIndexColumns<T> *columns = new BlockIndexColumns<T>();
+    cached.reset(columns);
+
+    const size_t blocks = blocksIndexOffsets.size();
+    columns->Positions = blocksIndexOffsets;
+    columns->ShapesOffsets.reserve(blocks + 1);
+    columns->StartsOffsets.reserve(blocks + 1);
+    columns->CountsOffsets.reserve(blocks + 1);
+    columns->MinMaxsOffsets.reserve(blocks + 1);
+    columns->Mins.reserve(blocks);
+    columns->Maxs.reserve(blocks);
+    columns->Values.reserve(blocks);
+    columns->SubBlockInfos.reserve(blocks);
+    columns->PayloadOffsets.reserve(blocks);
+    columns->Steps.reserve(blocks);
+    columns->FileIndices.reserve(blocks);
+    columns->IsValues.reserve(blocks);
+
+    columns->ShapesOffsets.push_back(0);
+    columns->StartsOffsets.push_back(0);
+    columns->CountsOffsets.push_back(0);
+    columns->MinMaxsOffsets.push_back(0);
 
-    size_t n = 0;
     for (const size_t blockIndexOffset : blocksIndexOffsets)
     {
         size_t position = blockIndexOffset;
@@ -1157,49 +1174,98 @@ BP4Deserializer::BlocksInfoCommon(
                                                TypeTraits<T>::type_enum, false,
                                                m_Minifooter.IsLittleEndian);
 
-        typename core::Variable<T>::BPInfo blockInfo;
-        blockInfo.Shape = blockCharacteristics.Shape;
-        blockInfo.Start = blockCharacteristics.Start;
-        blockInfo.Count = blockCharacteristics.Count;
-        blockInfo.WriterID = blockCharacteristics.Statistics.FileIndex;
-        blockInfo.IsReverseDims = m_ReverseDimensions;
+        auto lf_AppendDims = [](std::vector<size_t> &column,
+                                std::vector<size_t> &offsets,
+                                const Dims &dims) {
+            column.insert(column.end(), dims.begin(), dims.end());
+            offsets.push_back(column.size());
+        };
+
+        lf_AppendDims(columns->Shapes, columns->ShapesOffsets,
+                      blockCharacteristics.Shape);
+        lf_AppendDims(columns->Starts, columns->StartsOffsets,
+                      blockCharacteristics.Start);
+        lf_AppendDims(columns->Counts, columns->CountsOffsets,
+                      blockCharacteristics.Count);
+
+        const Stats<T> &stats = blockCharacteristics.Statistics;
+        columns->Mins.push_back(stats.Min);
+        columns->Maxs.push_back(stats.Max);
+        columns->Values.push_back(stats.Value);
+        columns->MinMaxs.insert(columns->MinMaxs.end(), stats.MinMaxs.begin(),
+                                stats.MinMaxs.end());
+        columns->MinMaxsOffsets.push_back(columns->MinMaxs.size());
+        columns->SubBlockInfos.push_back(stats.SubBlockInfo);
+        columns->PayloadOffsets.push_back(stats.PayloadOffset);
+        columns->Steps.push_back(stats.Step);
+        columns->FileIndices.push_back(stats.FileIndex);
+        columns->IsValues.push_back(stats.IsValue);
+    }
 
+    return *columns;
+}
+
+template <class T>
+std::vector<typename core::Variable<T>::BPInfo>
+BP4Deserializer::BlocksInfoCommon(
+    const core::Variable<T> &variable, const size_t step,
+    const std::vector<size_t> &blocksIndexOffsets) const
+{
+    const BlockIndexColumns<T> &columns =
+        GetBlockIndexColumns(variable, step, blocksIndexOffsets);
+
+    auto lf_GetDims = [&](const std::vector<size_t> &column,
+                          const std::vector<size_t> &offsets,
+                          const size_t block) -> Dims {
+        auto itBegin = column.begin() + offsets[block];
+        auto itEnd = column.begin() + offsets[block + 1];
         if (m_ReverseDimensions)
         {
-            std::reverse(blockInfo.Shape.begin(), blockInfo.Shape.end());
-            std::reverse(blockInfo.Start.begin(), blockInfo.Start.end());
-            std::reverse(blockInfo.Count.begin(), blockInfo.Count.end());
+            return Dims(std::reverse_iterator<decltype(itEnd)>(itEnd),
+                        std::reverse_iterator<decltype(itBegin)>(itBegin));
         }
+        return Dims(itBegin, itEnd);
+    };
+
+    const size_t blocks = blocksIndexOffsets.size();
+    std::vector<typename core::Variable<T>::BPInfo> blocksInfo(blocks);
+
+    for (size_t n = 0; n < blocks; ++n)
+    {
+        typename core::Variable<T>::BPInfo &blockInfo = blocksInfo[n];
+        blockInfo.Shape = lf_GetDims(columns.Shapes, columns.ShapesOffsets, n);
+        blockInfo.Start = lf_GetDims(columns.Starts, columns.StartsOffsets, n);
+        blockInfo.Count = lf_GetDims(columns.Counts, columns.CountsOffsets, n);
+        blockInfo.WriterID = static_cast<int>(columns.FileIndices[n]);
+        blockInfo.IsReverseDims = m_ReverseDimensions;
 
-        if (blockCharacteristics.Statistics.IsValue) // value
+        if (columns.IsValues[n]) // value
         {
             blockInfo.IsValue = true;
-            blockInfo.Value = blockCharacteristics.Statistics.Value;
+            blockInfo.Value = columns.Values[n];
         }
         else // array
         {
             blockInfo.IsValue = false;
-            blockInfo.Min = blockCharacteristics.Statistics.Min;
-            blockInfo.Max = blockCharacteristics.Statistics.Max;
-            blockInfo.MinMaxs = blockCharacteristics.Statistics.MinMaxs;
-            blockInfo.SubBlockInfo =
-                blockCharacteristics.Statistics.SubBlockInfo;
+            blockInfo.Min = columns.Mins[n];
+            blockInfo.Max = columns.Maxs[n];
+            blockInfo.MinMaxs.assign(
+                columns.MinMaxs.begin() + columns.MinMaxsOffsets[n],
+                columns.MinMaxs.begin() + columns.MinMaxsOffsets[n + 1]);
+            blockInfo.SubBlockInfo = columns.SubBlockInfos[n];
         }
         if (blockInfo.Shape.size() == 1 &&
             blockInfo.Shape.front() == LocalValueDim)
         {
-            blockInfo.Shape = Dims{blocksIndexOffsets.size()};
+            blockInfo.Shape = Dims{blocks};
             blockInfo.Count = Dims{1};
             blockInfo.Start = Dims{n};
-            blockInfo.Min = blockCharacteristics.Statistics.Value;
-            blockInfo.Max = blockCharacteristics.Statistics.Value;
+            blockInfo.Min = columns.Values[n];
+            blockInfo.Max = columns.Values[n];
         }
         // bp index starts at 1
-        blockInfo.Step =
-            static_cast<size_t>(blockCharacteristics.Statistics.Step - 1);
+        blockInfo.Step = static_cast<size_t>(columns.Steps[n] - 1);
         blockInfo.BlockID = n;
-        blocksInfo.push_back(blockInfo);
-        ++n;
     }
     return blocksInfo;
 }
@@ -13,6 +13,7 @@
 #include "BP4Serializer.h"
 #include "BP4Serializer.tcc"
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <string>
@@ -253,7 +254,7 @@ size_t BP4Serializer::CloseData(core::IO &io)
             m_Profiler.m_Bytes.at("buffering") = m_Data.m_AbsolutePosition;
         }
 
-        m_Aggregator.Close();
+        m_Aggregator->Close();
         m_IsClosed = true;
     }
 
@@ -362,8 +363,8 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
     // without record itself and vars count
     // Note: m_MetadataSet.DataPGVarsCount has been incremented by 4
     // in previous CopyToBuffer operation!
-    const uint64_t varsLength =
-        position - m_MetadataSet.DataPGVarsCountPosition - 8;
+    const uint64_t varsLength = position + m_DataReferencesPGSize -
+                                m_MetadataSet.DataPGVarsCountPosition - 8;
     helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
                          &varsLength);
 
@@ -391,7 +392,8 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
             m_Data.Resize(minSize, "for empty Attributes\n");
         }
         // Attribute index header for zero attributes: 0, 0LL
-        // Resize() already takes care of this
+        // written explicitly, a reused buffer holds the previous step here
+        std::fill_n(buffer.begin() + position, 12, '\0');
         position += 12;
         absolutePosition += 12;
     }
@@ -403,10 +405,12 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
 
     // Finish writing pg group length INCLUDING the record itself and
     // including the closing padding but NOT the opening [PGI
-    const uint64_t dataPGLength = position - m_MetadataSet.DataPGLengthPosition;
+    const uint64_t dataPGLength = position + m_DataReferencesPGSize -
+                                  m_MetadataSet.DataPGLengthPosition;
     helper::CopyToBuffer(buffer, m_MetadataSet.DataPGLengthPosition,
                          &dataPGLength);
 
+    m_DataReferencesPGSize = 0;
     m_MetadataSet.DataPGIsOpen = false;
 }
 
@@ -1152,6 +1156,10 @@ ADIOS2_FOREACH_ATTRIBUTE_STDTYPE_1ARG(declare_template_instantiation)
         const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
         const bool, typename core::Variable<T>::Span *) noexcept;              \
                                                                                \
+    template void BP4Serializer::PutVariablePayloadReference(                  \
+        const core::Variable<T> &,                                             \
+        const typename core::Variable<T>::BPInfo &) noexcept;                  \
+                                                                               \
     template void BP4Serializer::PutVariableMetadata(                          \
         const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
         const bool, typename core::Variable<T>::Span *) noexcept;
@@ -83,6 +83,19 @@ public:
         const bool sourceRowMajor = true,
         typename core::Variable<T>::Span *span = nullptr) noexcept;
 
+    /**
+     * Put a reference to the variable payload in application memory instead
+     * of copying it to the buffer, the payload is written at the next flush
+     * and must not change until then. Only for blocks without operations and
+     * memory selections.
+     * @param variable
+     * @param blockInfo
+     */
+    template <class T>
+    void PutVariablePayloadReference(
+        const core::Variable<T> &variable,
+        const typename core::Variable<T>::BPInfo &blockInfo) noexcept;
+
     template <class T>
     void PutSpanMetadata(const core::Variable<T> &variable,
                          const typename core::Variable<T>::BPInfo &blockInfo,
@@ -225,6 +238,17 @@ private:
         const Stats<T> &stats, std::vector<char> &buffer,
         typename core::Variable<T>::Span *span) noexcept;
 
+    /**
+     * Computes the statistics of the last variable block and rewrites its
+     * placeholder bounds, see m_DeferredStats
+     * @param copyPayload true: copy the payload to the buffer in the same
+     * pass, false: the payload is not buffered (PutVariablePayloadReference)
+     */
+    template <class T>
+    void PutDeferredStats(const core::Variable<T> &variable,
+                          const typename core::Variable<T>::BPInfo &blockInfo,
+                          const bool copyPayload) noexcept;
+
     template <class T>
     void PutVariableCharacteristicsInData(
         const core::Variable<T> &variable,
@@ -261,6 +285,10 @@ private:
         const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
         const bool, typename core::Variable<T>::Span *) noexcept;              \
                                                                                \
+    extern template void BP4Serializer::PutVariablePayloadReference(           \
+        const core::Variable<T> &,                                             \
+        const typename core::Variable<T>::BPInfo &) noexcept;                  \
+                                                                               \
     extern template void BP4Serializer::PutVariableMetadata(                   \
         const core::Variable<T> &, const typename core::Variable<T>::BPInfo &, \
         const bool, typename core::Variable<T>::Span *) noexcept;
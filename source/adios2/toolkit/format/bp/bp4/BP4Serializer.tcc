@@ -37,7 +37,7 @@ inline void BP4Serializer::PutVariableMetadata(
     const bool sourceRowMajor, typename core::Variable<T>::Span *span) noexcept
 {
     auto lf_SetOffset = [&](uint64_t &offset) {
-        if (m_Aggregator.m_IsActive && !m_Aggregator.m_IsConsumer)
+        if (m_Aggregator->m_IsActive && !m_Aggregator->m_IsConsumer)
         {
             offset = static_cast<uint64_t>(m_Data.m_Position);
         }
@@ -50,6 +50,7 @@ inline void BP4Serializer::PutVariableMetadata(
 
     m_Profiler.Start("buffering");
 
+    m_DeferredStats = false;
     Stats<T> stats =
         GetBPStats<T>(variable.m_SingleValue, blockInfo, sourceRowMajor);
 
@@ -111,7 +112,11 @@ inline void BP4Serializer::PutVariablePayload(
         return;
     }
 
-    if (blockInfo.Operations.empty())
+    if (m_DeferredStats)
+    {
+        PutDeferredStats(variable, blockInfo, true);
+    }
+    else if (blockInfo.Operations.empty())
     {
         PutPayloadInBuffer(variable, blockInfo, sourceRowMajor);
     }
@@ -131,6 +136,34 @@ inline void BP4Serializer::PutVariablePayload(
     m_Profiler.Stop("buffering");
 }
 
+template <class T>
+inline void BP4Serializer::PutVariablePayloadReference(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::BPInfo &blockInfo) noexcept
+{
+    m_Profiler.Start("buffering");
+    if (m_DeferredStats)
+    {
+        PutDeferredStats(variable, blockInfo, false);
+    }
+    const size_t payloadSize =
+        helper::GetTotalSize(blockInfo.Count) * sizeof(T);
+
+    m_DataReferences.push_back(
+        {m_DataChunks.size(), m_Data.m_Position,
+         reinterpret_cast<const char *>(blockInfo.Data), payloadSize});
+    m_DataReferencesPGSize += payloadSize;
+    m_Data.m_AbsolutePosition += payloadSize;
+
+    // varLength includes the payload that is not in the buffer
+    const uint64_t varLength = static_cast<uint64_t>(
+        m_Data.m_Position - m_LastVarLengthPosInBuffer + payloadSize);
+    size_t backPosition = m_LastVarLengthPosInBuffer;
+    helper::CopyToBuffer(m_Data.m_Buffer, backPosition, &varLength);
+
+    m_Profiler.Stop("buffering");
+}
+
 template <class T>
 void BP4Serializer::PutSpanMetadata(
     const core::Variable<T> &variable,
@@ -166,6 +199,50 @@ void BP4Serializer::PutSpanMetadata(
 }
 
 // PRIVATE
+template <>
+inline void BP4Serializer::PutDeferredStats(
+    const core::Variable<std::string> & /*variable*/,
+    const typename core::Variable<std::string>::BPInfo & /*blockInfo*/,
+    const bool /*copyPayload*/) noexcept
+{
+    // strings have no statistics
+}
+
+template <class T>
+void BP4Serializer::PutDeferredStats(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::BPInfo &blockInfo,
+    const bool copyPayload) noexcept
+{
+    Stats<T> stats;
+    stats.SubBlockInfo = m_DeferredStatsSubBlocks;
+    if (copyPayload)
+    {
+        PutPayloadInBuffer(variable, blockInfo, stats);
+    }
+    else
+    {
+        m_Profiler.Start("minmax");
+        helper::GetMinMaxSubblocks(blockInfo.Data, blockInfo.Count,
+                                   stats.SubBlockInfo, stats.MinMaxs, stats.Min,
+                                   stats.Max, m_Parameters.Threads);
+        m_Profiler.Stop("minmax");
+    }
+
+    // same size as the placeholders
+    uint8_t dummyCounter = 0;
+    size_t position = m_DeferredStatsPosInBuffer;
+    PutBoundsRecord(false, stats, dummyCounter, m_Data.m_Buffer, position);
+
+    SerialElementIndex &variableIndex =
+        m_MetadataSet.VarsIndices.at(variable.m_Name);
+    position = m_DeferredStatsPosInIndex;
+    PutBoundsRecord(false, stats, dummyCounter, variableIndex.Buffer,
+                    position);
+
+    m_DeferredStats = false;
+}
+
 template <class T>
 size_t
 BP4Serializer::PutAttributeHeaderInData(const core::Attribute<T> &attribute,
@@ -365,9 +442,25 @@ BP4Serializer::GetBPStats(const bool singleValue,
             stats.SubBlockInfo = helper::DivideBlock(
                 blockInfo.Count, m_Parameters.StatsBlockSize,
                 helper::BlockDivisionMethod::Contiguous);
-            helper::GetMinMaxSubblocks(
-                blockInfo.Data, blockInfo.Count, stats.SubBlockInfo,
-                stats.MinMaxs, stats.Min, stats.Max, m_Parameters.Threads);
+            if (blockInfo.Operations.empty())
+            {
+                // computed while copying the payload, only size MinMaxs for
+                // the placeholder bounds
+                m_DeferredStats = true;
+                m_DeferredStatsSubBlocks = stats.SubBlockInfo;
+                stats.Min = {};
+                stats.Max = {};
+                helper::GetMinMaxSubblocks(
+                    static_cast<const T *>(nullptr), blockInfo.Count,
+                    stats.SubBlockInfo, stats.MinMaxs, stats.Min, stats.Max,
+                    m_Parameters.Threads);
+            }
+            else
+            {
+                helper::GetMinMaxSubblocks(
+                    blockInfo.Data, blockInfo.Count, stats.SubBlockInfo,
+                    stats.MinMaxs, stats.Min, stats.Max, m_Parameters.Threads);
+            }
         }
         else
         {
@@ -791,6 +884,10 @@ void BP4Serializer::PutVariableCharacteristics(
             span->m_MinMaxMetadataPositions.first = buffer.size();
             span->m_MinMaxMetadataPositions.second = buffer.size();
         }
+        if (m_DeferredStats)
+        {
+            m_DeferredStatsPosInIndex = buffer.size();
+        }
 
         PutBoundsRecord(variable.m_SingleValue, stats, characteristicsCounter,
                         buffer);
@@ -851,6 +948,10 @@ void BP4Serializer::PutVariableCharacteristicsInData(
     // in the data file (only in metadata file in other function)
     if (blockInfo.Data != nullptr && !variable.m_SingleValue)
     {
+        if (m_DeferredStats)
+        {
+            m_DeferredStatsPosInBuffer = position;
+        }
         PutBoundsRecord(variable.m_SingleValue, stats, characteristicsCounter,
                         buffer, position);
     }
@@ -18,6 +18,18 @@ namespace adios2
 namespace format
 {
 
+namespace
+{
+const char BinaryMagic[4] = {'D', 'M', 'B', '1'};
+
+void InsertString(std::vector<char> &buffer, const std::string &str)
+{
+    const uint32_t length = static_cast<uint32_t>(str.size());
+    helper::InsertToBuffer(buffer, &length);
+    helper::InsertToBuffer(buffer, str.data(), str.size());
+}
+} // end anonymous namespace
+
 DataManSerializer::DataManSerializer(helper::Comm const &comm,
                                      const bool isRowMajor)
 : m_Comm(comm), m_IsRowMajor(isRowMajor),
@@ -33,6 +45,15 @@ DataManSerializer::~DataManSerializer()
     {
         m_PutPackThread.join();
     }
+    {
+        std::lock_guard<std::mutex> l(m_CompressionMutex);
+        m_StopCompression = true;
+    }
+    m_CompressionQueued.notify_all();
+    for (auto &worker : m_CompressionWorkers)
+    {
+        worker.join();
+    }
 }
 
 void DataManSerializer::NewWriterBuffer(size_t bufferSize)
@@ -43,22 +64,213 @@ void DataManSerializer::NewWriterBuffer(size_t bufferSize)
     // queue in transport manager. It will be automatically released when the
     // entire workflow finishes using it.
     m_MetadataJson = nullptr;
+    m_BinaryBlocks.clear();
+    m_BinaryBlockCount = 0;
     m_LocalBuffer = std::make_shared<std::vector<char>>();
     m_LocalBuffer->reserve(bufferSize);
     m_LocalBuffer->resize(sizeof(uint64_t) * 2);
 }
 
+void DataManSerializer::SetMetadataFormat(const std::string &format)
+{
+    if (format == "binary")
+    {
+        m_UseBinaryMetadata = true;
+    }
+    else if (format == "string" or format == "msgpack" or format == "cbor" or
+             format == "ubjson")
+    {
+        m_UseBinaryMetadata = false;
+        m_UseJsonSerialization = format;
+    }
+    else
+    {
+        throw(std::invalid_argument(
+            format + " is not a valid metadata format. DataManSerializer "
+                     "only uses binary, string, msgpack, cbor or ubjson"));
+    }
+}
+
+std::string DataManSerializer::GetMetadataFormat() const
+{
+    if (m_UseBinaryMetadata)
+    {
+        return "binary";
+    }
+    return m_UseJsonSerialization;
+}
+
+void DataManSerializer::ResendSchema() { m_SchemaSent = 0; }
+
+void DataManSerializer::SetCompressionThreads(const unsigned int threads)
+{
+    m_CompressionThreads = threads;
+}
+
+void DataManSerializer::QueueCompression(std::unique_ptr<PendingBlock> block)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    // workers are started at the first compressed block, the writer thread
+    // keeps putting blocks meanwhile
+    if (m_CompressionWorkers.empty())
+    {
+        for (unsigned int i = 0; i < m_CompressionThreads; ++i)
+        {
+            m_CompressionWorkers.emplace_back(
+                &DataManSerializer::CompressionWorker, this);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> l(m_CompressionMutex);
+        m_CompressionQueue.push_back(block.get());
+        m_PendingBlocks.push_back(std::move(block));
+    }
+    m_CompressionQueued.notify_one();
+}
+
+void DataManSerializer::CompressionWorker()
+{
+    std::unique_lock<std::mutex> l(m_CompressionMutex);
+    while (true)
+    {
+        m_CompressionQueued.wait(l, [this]() {
+            return m_StopCompression or not m_CompressionQueue.empty();
+        });
+        if (m_CompressionQueue.empty())
+        {
+            return;
+        }
+        PendingBlock *block = m_CompressionQueue.front();
+        m_CompressionQueue.pop_front();
+        ++m_CompressionsRunning;
+        l.unlock();
+        block->compress(*this, *block);
+        l.lock();
+        --m_CompressionsRunning;
+        if (m_CompressionQueue.empty() and m_CompressionsRunning == 0)
+        {
+            m_CompressionDone.notify_all();
+        }
+    }
+}
+
+void DataManSerializer::FinishCompression()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    std::vector<std::unique_ptr<PendingBlock>> blocks;
+    {
+        std::unique_lock<std::mutex> l(m_CompressionMutex);
+        m_CompressionDone.wait(l, [this]() {
+            return m_CompressionQueue.empty() and m_CompressionsRunning == 0;
+        });
+        blocks.swap(m_PendingBlocks);
+    }
+    for (const auto &block : blocks)
+    {
+        PutBlock(*block);
+    }
+}
+
+void DataManSerializer::PutBlock(const PendingBlock &block)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    VecPtr localBuffer = block.localBuffer;
+    const size_t position = localBuffer->size();
+
+    if (localBuffer->capacity() < position + block.datasize)
+    {
+        localBuffer->reserve((position + block.datasize) * 2);
+    }
+
+    localBuffer->resize(position + block.datasize);
+
+    if (block.compressed)
+    {
+        std::memcpy(localBuffer->data() + position,
+                    block.compressBuffer.data(), block.datasize);
+    }
+    else
+    {
+        std::memcpy(localBuffer->data() + position, block.data,
+                    block.datasize);
+    }
+
+    if (m_UseBinaryMetadata and block.metadataJson == nullptr)
+    {
+        PutBinaryBlock(block.schema, block.start, block.count, block.step,
+                       block.rank, position, block.datasize, block.min,
+                       block.max);
+        return;
+    }
+
+    nlohmann::json metaj;
+
+    metaj["N"] = block.schema.name;
+    metaj["O"] = block.start;
+    metaj["C"] = block.count;
+    metaj["S"] = block.schema.shape;
+    metaj["Y"] = ToString(block.schema.type);
+    metaj["P"] = position;
+    metaj["I"] = block.datasize;
+
+    if (not block.schema.address.empty())
+    {
+        metaj["A"] = block.schema.address;
+    }
+
+    if (not block.min.empty())
+    {
+        metaj["+"] = block.max;
+        metaj["-"] = block.min;
+    }
+
+    if (not m_IsRowMajor)
+    {
+        metaj["M"] = m_IsRowMajor;
+    }
+    if (not m_IsLittleEndian)
+    {
+        metaj["E"] = m_IsLittleEndian;
+    }
+
+    if (block.compressed)
+    {
+        metaj["Z"] = block.schema.compression;
+        metaj["ZP"] = block.schema.params;
+    }
+
+    const std::string step = std::to_string(block.step);
+    const std::string rank = std::to_string(block.rank);
+    if (block.metadataJson == nullptr)
+    {
+        m_MetadataJson[step][rank].emplace_back(std::move(metaj));
+    }
+    else
+    {
+        (*block.metadataJson)[step][rank].emplace_back(std::move(metaj));
+    }
+}
+
 VecPtr DataManSerializer::GetLocalPack()
 {
     TAU_SCOPED_TIMER_FUNC();
-    m_TimeStampsMutex.lock();
-    if (!m_TimeStamps.empty())
+    FinishCompression();
+    VecPtr metapack;
+    if (m_UseBinaryMetadata)
     {
-        m_MetadataJson["T"] = m_TimeStamps;
-        m_TimeStamps.clear();
+        metapack = SerializeBinary();
+    }
+    else
+    {
+        m_TimeStampsMutex.lock();
+        if (!m_TimeStamps.empty())
+        {
+            m_MetadataJson["T"] = m_TimeStamps;
+            m_TimeStamps.clear();
+        }
+        m_TimeStampsMutex.unlock();
+        metapack = SerializeJson(m_MetadataJson);
     }
-    m_TimeStampsMutex.unlock();
-    auto metapack = SerializeJson(m_MetadataJson);
     size_t metasize = metapack->size();
     (reinterpret_cast<uint64_t *>(m_LocalBuffer->data()))[0] =
         m_LocalBuffer->size();
@@ -205,6 +417,13 @@ void DataManSerializer::GetAttributes(core::IO &io)
 void DataManSerializer::AttachAttributesToLocalPack()
 {
     TAU_SCOPED_TIMER_FUNC();
+    if (m_UseBinaryMetadata)
+    {
+        // attributes are static, binary packs only carry them along with
+        // the full schema
+        m_AttachAttributes = true;
+        return;
+    }
     std::lock_guard<std::mutex> l1(m_StaticDataJsonMutex);
     m_MetadataJson["S"] = m_StaticDataJson["S"];
 }
@@ -380,6 +599,364 @@ void DataManSerializer::JsonToVarMap(nlohmann::json &metaJ, VecPtr pack)
     }
 }
 
+uint32_t DataManSerializer::GetSchemaIndex(const BinarySchema &schema)
+{
+    auto it = m_SchemaIndex.find(schema.name);
+    if (it != m_SchemaIndex.end())
+    {
+        const BinarySchema &known = m_Schema[it->second];
+        if (known.type == schema.type and known.shape == schema.shape and
+            known.startDims == schema.startDims and
+            known.countDims == schema.countDims and
+            known.address == schema.address and
+            known.compression == schema.compression and
+            known.params == schema.params)
+        {
+            return it->second;
+        }
+    }
+    const uint32_t index = static_cast<uint32_t>(m_Schema.size());
+    m_Schema.push_back(schema);
+    m_SchemaIndex[schema.name] = index;
+    return index;
+}
+
+void DataManSerializer::PutBinaryBlock(
+    const BinarySchema &schema, const Dims &varStart, const Dims &varCount,
+    const size_t step, const int rank, const size_t position,
+    const size_t datasize, const std::vector<char> &min,
+    const std::vector<char> &max)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    const uint32_t index = GetSchemaIndex(schema);
+    const int32_t rank32 = static_cast<int32_t>(rank);
+    const uint8_t minMaxSize = static_cast<uint8_t>(min.size());
+
+    helper::InsertToBuffer(m_BinaryBlocks, &index);
+    helper::InsertToBuffer(m_BinaryBlocks, &rank32);
+    helper::InsertU64(m_BinaryBlocks, step);
+    helper::InsertU64(m_BinaryBlocks, position);
+    helper::InsertU64(m_BinaryBlocks, datasize);
+    helper::InsertToBuffer(m_BinaryBlocks, &minMaxSize);
+    for (const auto d : varStart)
+    {
+        helper::InsertU64(m_BinaryBlocks, d);
+    }
+    for (const auto d : varCount)
+    {
+        helper::InsertU64(m_BinaryBlocks, d);
+    }
+    helper::InsertToBuffer(m_BinaryBlocks, min.data(), min.size());
+    helper::InsertToBuffer(m_BinaryBlocks, max.data(), max.size());
+    ++m_BinaryBlockCount;
+}
+
+VecPtr DataManSerializer::SerializeBinary()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    std::vector<uint64_t> timeStamps;
+    m_TimeStampsMutex.lock();
+    timeStamps.swap(m_TimeStamps);
+    m_TimeStampsMutex.unlock();
+
+    std::string attributes;
+    if (m_AttachAttributes and m_SchemaSent == 0)
+    {
+        std::lock_guard<std::mutex> l(m_StaticDataJsonMutex);
+        if (m_StaticDataJson != nullptr)
+        {
+            attributes = m_StaticDataJson["S"].dump();
+        }
+    }
+
+    auto pack = std::make_shared<std::vector<char>>();
+    pack->reserve(64 + m_BinaryBlocks.size() + attributes.size());
+
+    const uint8_t isLittleEndian = m_IsLittleEndian;
+    const uint8_t isRowMajor = m_IsRowMajor;
+    const int32_t writerRank = static_cast<int32_t>(m_MpiRank);
+    const uint32_t schemaBase = static_cast<uint32_t>(m_SchemaSent);
+    const uint32_t schemaCount =
+        static_cast<uint32_t>(m_Schema.size() - m_SchemaSent);
+    const uint32_t timeStampCount = static_cast<uint32_t>(timeStamps.size());
+    const uint64_t attributesSize = attributes.size();
+
+    helper::InsertToBuffer(*pack, BinaryMagic, sizeof(BinaryMagic));
+    helper::InsertToBuffer(*pack, &isLittleEndian);
+    helper::InsertToBuffer(*pack, &isRowMajor);
+    helper::InsertToBuffer(*pack, &writerRank);
+    helper::InsertToBuffer(*pack, &schemaBase);
+    helper::InsertToBuffer(*pack, &schemaCount);
+    helper::InsertToBuffer(*pack, &timeStampCount);
+    helper::InsertToBuffer(*pack, &m_BinaryBlockCount);
+    helper::InsertToBuffer(*pack, &attributesSize);
+
+    for (size_t i = m_SchemaSent; i < m_Schema.size(); ++i)
+    {
+        const BinarySchema &schema = m_Schema[i];
+        const uint8_t type = static_cast<uint8_t>(schema.type);
+        helper::InsertToBuffer(*pack, &type);
+        InsertString(*pack, schema.name);
+        InsertString(*pack, schema.address);
+        InsertString(*pack, schema.compression);
+        const uint32_t paramsCount =
+            static_cast<uint32_t>(schema.params.size());
+        helper::InsertToBuffer(*pack, &paramsCount);
+        for (const auto &param : schema.params)
+        {
+            InsertString(*pack, param.first);
+            InsertString(*pack, param.second);
+        }
+        const uint32_t shapeDims = static_cast<uint32_t>(schema.shape.size());
+        helper::InsertToBuffer(*pack, &shapeDims);
+        for (const auto d : schema.shape)
+        {
+            helper::InsertU64(*pack, d);
+        }
+        const uint32_t startDims = static_cast<uint32_t>(schema.startDims);
+        const uint32_t countDims = static_cast<uint32_t>(schema.countDims);
+        helper::InsertToBuffer(*pack, &startDims);
+        helper::InsertToBuffer(*pack, &countDims);
+    }
+    m_SchemaSent = m_Schema.size();
+
+    helper::InsertToBuffer(*pack, timeStamps.data(), timeStamps.size());
+    helper::InsertToBuffer(*pack, attributes.data(), attributes.size());
+    helper::InsertToBuffer(*pack, m_BinaryBlocks.data(), m_BinaryBlocks.size());
+
+    return pack;
+}
+
+bool DataManSerializer::BinaryToVarMap(VecPtr pack, size_t position,
+                                       const size_t end)
+{
+    TAU_SCOPED_TIMER_FUNC();
+
+    const std::vector<char> &buffer = *pack;
+    auto lf_Check = [&](const size_t bytes) {
+        if (position + bytes > end)
+        {
+            throw(std::runtime_error("DataManSerializer::BinaryToVarMap "
+                                     "binary metadata is truncated"));
+        }
+    };
+    bool isLittleEndian;
+    auto lf_ReadString = [&]() -> std::string {
+        lf_Check(sizeof(uint32_t));
+        const uint32_t length =
+            helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+        lf_Check(length);
+        std::string str(buffer.data() + position, length);
+        position += length;
+        return str;
+    };
+
+    lf_Check(sizeof(BinaryMagic) + 2 * sizeof(uint8_t) + 5 * sizeof(uint32_t) +
+             sizeof(uint64_t));
+    position += sizeof(BinaryMagic);
+    isLittleEndian = buffer[position++] != 0;
+    const bool isRowMajor = buffer[position++] != 0;
+#ifndef ADIOS2_HAVE_ENDIAN_REVERSE
+    if (isLittleEndian != m_IsLittleEndian)
+    {
+        throw(std::runtime_error(
+            "DataManSerializer::BinaryToVarMap writer has a different byte "
+            "order and ADIOS2 is built without endian reverse support, use "
+            "MetadataFormat=string in the writer"));
+    }
+#endif
+    const int writerRank =
+        helper::ReadValue<int32_t>(buffer, position, isLittleEndian);
+    const uint32_t schemaBase =
+        helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+    const uint32_t schemaCount =
+        helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+    const uint32_t timeStampCount =
+        helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+    const uint32_t blockCount =
+        helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+    const uint64_t attributesSize =
+        helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+
+    std::vector<BinarySchema> newSchema(schemaCount);
+    for (auto &schema : newSchema)
+    {
+        lf_Check(sizeof(uint8_t));
+        schema.type = static_cast<DataType>(buffer[position++]);
+        schema.name = lf_ReadString();
+        schema.address = lf_ReadString();
+        schema.compression = lf_ReadString();
+        lf_Check(sizeof(uint32_t));
+        const uint32_t paramsCount =
+            helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+        for (uint32_t i = 0; i < paramsCount; ++i)
+        {
+            const std::string key = lf_ReadString();
+            schema.params[key] = lf_ReadString();
+        }
+        lf_Check(sizeof(uint32_t));
+        const uint32_t shapeDims =
+            helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+        lf_Check(shapeDims * sizeof(uint64_t) + 2 * sizeof(uint32_t));
+        schema.shape.resize(shapeDims);
+        for (auto &d : schema.shape)
+        {
+            d = helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+        }
+        schema.startDims =
+            helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+        schema.countDims =
+            helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+    }
+
+    lf_Check(timeStampCount * sizeof(uint64_t));
+    std::vector<uint64_t> timeStamps(timeStampCount);
+    for (auto &t : timeStamps)
+    {
+        t = helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+    }
+
+    lf_Check(attributesSize);
+    if (attributesSize > 0)
+    {
+        const char *start = buffer.data() + position;
+        std::lock_guard<std::mutex> l(m_StaticDataJsonMutex);
+        m_StaticDataJson["S"] =
+            nlohmann::json::parse(start, start + attributesSize);
+    }
+    position += attributesSize;
+
+    // copy of the schema of this writer after applying the new entries, the
+    // cache is only updated once the pack is known to be usable
+    std::vector<BinarySchema> schemaTable;
+    {
+        std::lock_guard<std::mutex> l(m_ReceivedSchemaMutex);
+        auto it = m_ReceivedSchema.find(writerRank);
+        if (it != m_ReceivedSchema.end())
+        {
+            schemaTable = it->second;
+        }
+        else if (schemaBase > 0)
+        {
+            Log(1,
+                "DataManSerializer::BinaryToVarMap dropped a pack from "
+                "writer " +
+                    std::to_string(writerRank) +
+                    " because its schema has not been received",
+                true, true);
+            return false;
+        }
+    }
+    if (schemaBase > schemaTable.size())
+    {
+        Log(1,
+            "DataManSerializer::BinaryToVarMap dropped a pack from writer " +
+                std::to_string(writerRank) +
+                " because part of its schema was lost",
+            true, true);
+        return false;
+    }
+    schemaTable.resize(schemaBase);
+    schemaTable.insert(schemaTable.end(), newSchema.begin(), newSchema.end());
+    {
+        std::lock_guard<std::mutex> l(m_ReceivedSchemaMutex);
+        m_ReceivedSchema[writerRank] = schemaTable;
+    }
+
+    if (timeStampCount > 0)
+    {
+        std::lock_guard<std::mutex> l(m_TimeStampsMutex);
+        m_TimeStamps = std::move(timeStamps);
+    }
+
+    // see JsonToVarMap for why the mutex is held through the entire loop
+    std::lock_guard<std::mutex> lDataManVarMapMutex(m_DataManVarMapMutex);
+
+    m_CombiningSteps = 0;
+    bool hasStep = false;
+    size_t lastStep = 0;
+
+    for (uint32_t b = 0; b < blockCount; ++b)
+    {
+        lf_Check(2 * sizeof(uint32_t) + 3 * sizeof(uint64_t) +
+                 sizeof(uint8_t));
+        const uint32_t index =
+            helper::ReadValue<uint32_t>(buffer, position, isLittleEndian);
+        if (index >= schemaTable.size())
+        {
+            throw(std::runtime_error("DataManSerializer::BinaryToVarMap "
+                                     "block refers to unknown schema entry"));
+        }
+        const BinarySchema &schema = schemaTable[index];
+
+        DataManVar var;
+        var.rank = helper::ReadValue<int32_t>(buffer, position, isLittleEndian);
+        var.step =
+            helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+        var.position =
+            helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+        var.size =
+            helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+        const uint8_t minMaxSize = buffer[position++];
+
+        lf_Check((schema.startDims + schema.countDims) * sizeof(uint64_t) +
+                 2 * minMaxSize);
+        var.start.resize(schema.startDims);
+        for (auto &d : var.start)
+        {
+            d = helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+        }
+        var.count.resize(schema.countDims);
+        for (auto &d : var.count)
+        {
+            d = helper::ReadValue<uint64_t>(buffer, position, isLittleEndian);
+        }
+        if (minMaxSize > 0)
+        {
+            var.min.assign(buffer.begin() + position,
+                           buffer.begin() + position + minMaxSize);
+            position += minMaxSize;
+            var.max.assign(buffer.begin() + position,
+                           buffer.begin() + position + minMaxSize);
+            position += minMaxSize;
+        }
+
+        var.isRowMajor = isRowMajor;
+        var.isLittleEndian = isLittleEndian;
+        var.name = schema.name;
+        var.type = schema.type;
+        var.shape = schema.shape;
+        var.address = schema.address;
+        var.compression = schema.compression;
+        var.params = schema.params;
+        var.buffer = pack;
+
+        if (not hasStep or var.step != lastStep)
+        {
+            hasStep = true;
+            lastStep = var.step;
+            ++m_CombiningSteps;
+            std::lock_guard<std::mutex> l(m_DeserializedBlocksForStepMutex);
+            ++m_DeserializedBlocksForStep[var.step];
+        }
+
+        auto &vars = m_DataManVarMap[var.step];
+        if (vars == nullptr)
+        {
+            vars = std::make_shared<std::vector<DataManVar>>();
+        }
+        vars->emplace_back(std::move(var));
+    }
+
+    if (m_Verbosity >= 5)
+    {
+        std::cout << "DataManSerializer::BinaryToVarMap Total buffered steps "
+                     "= "
+                  << m_DataManVarMap.size() << std::endl;
+    }
+    return true;
+}
+
 void DataManSerializer::PutPack(const VecPtr data, const bool useThread)
 {
     if (useThread)
@@ -407,6 +984,23 @@ int DataManSerializer::PutPackThread(const VecPtr data)
     uint64_t metaPosition =
         (reinterpret_cast<const uint64_t *>(data->data()))[0];
     uint64_t metaSize = (reinterpret_cast<const uint64_t *>(data->data()))[1];
+    if (metaPosition + metaSize > data->size())
+    {
+        throw(std::runtime_error(
+            "DataManSerializer::PutPackThread received a truncated pack"));
+    }
+    // binary metadata is recognized by its magic so that packs from writers
+    // still using JSON metadata can be read as well
+    if (metaSize >= sizeof(BinaryMagic) and
+        std::memcmp(data->data() + metaPosition, BinaryMagic,
+                    sizeof(BinaryMagic)) == 0)
+    {
+        if (not BinaryToVarMap(data, metaPosition, metaPosition + metaSize))
+        {
+            return -2;
+        }
+        return 0;
+    }
     nlohmann::json j = DeserializeJson(data->data() + metaPosition, metaSize);
     JsonToVarMap(j, data);
     return 0;
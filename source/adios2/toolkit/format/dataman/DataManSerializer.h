@@ -17,7 +17,12 @@
 #include "adios2/helper/adiosJSONcomplex.h"
 #include "adios2/toolkit/profiling/taustubs/tautimer.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #include <nlohmann/json.hpp>
@@ -43,6 +48,19 @@
 // + - Max
 // # - Value
 
+// Binary metadata ("MetadataFormat" = "binary"), all values in writer byte
+// order except Magic and E:
+// Magic "DMB1", E (uint8), M (uint8), writer rank (int32), first schema
+// index (uint32), schema entries (uint32), time stamps (uint32), blocks
+// (uint32), attributes size (uint64), then
+// schema entries: Y (uint8), N, A, Z (uint32 length + chars), ZP (uint32
+// count + key/value strings), S (uint32 + uint64 each), number of O and C
+// dimensions (uint32 each)
+// time stamps: T (uint64 each)
+// attributes: JSON string of static data, only in packs with full schema
+// blocks: schema index (uint32), rank (int32), T, P, I (uint64), size of
+// min/max (uint8), O, C (uint64 each), -, +
+
 namespace adios2
 {
 namespace format
@@ -90,6 +108,17 @@ public:
     // clear and allocate new buffer for writer
     void NewWriterBuffer(size_t size);
 
+    // binary (default), or JSON as string, msgpack, cbor or ubjson
+    void SetMetadataFormat(const std::string &format);
+    std::string GetMetadataFormat() const;
+
+    // send all binary schema entries again with the next local pack, for
+    // readers that joined late or lost a pack
+    void ResendSchema();
+
+    // number of threads compressing blocks, 1 compresses inside PutData
+    void SetCompressionThreads(const unsigned int threads);
+
     // get attributes from IO and put into m_StaticDataJson
     void PutAttributes(core::IO &io);
 
@@ -109,6 +138,10 @@ public:
                  const size_t step, const int rank, const std::string &address,
                  VecPtr localBuffer = nullptr, JsonPtr metadataJson = nullptr);
 
+    // wait for blocks being compressed and add them to the local pack,
+    // input data passed to PutData must be valid until this returns
+    void FinishCompression();
+
     // attach attributes to local pack
     void AttachAttributesToLocalPack();
 
@@ -156,21 +189,67 @@ public:
     OperatorMap GetOperatorMap();
 
 private:
+    // variable properties that rarely change between blocks, sent once per
+    // reader in binary metadata and referred to by index from each block
+    struct BinarySchema
+    {
+        DataType type;
+        std::string name;
+        std::string address;
+        std::string compression;
+        Params params;
+        Dims shape;
+        size_t startDims;
+        size_t countDims;
+    };
+
+    // a block put by PutData, kept until it is compressed into its own
+    // buffer when compression runs on worker threads
+    struct PendingBlock
+    {
+        BinarySchema schema;
+        Dims start;
+        Dims count;
+        size_t step;
+        int rank;
+        std::vector<char> min;
+        std::vector<char> max;
+        VecPtr localBuffer;
+        JsonPtr metadataJson;
+        const char *data;
+        size_t datasize;
+        bool compressed = false;
+        std::vector<char> compressBuffer;
+        std::function<void(DataManSerializer &, PendingBlock &)> compress;
+    };
+
+    template <class T>
+    void CompressBlock(const T *inputData, PendingBlock &block);
+
+    // copy block data into its local buffer and add its metadata
+    void PutBlock(const PendingBlock &block);
+
+    void QueueCompression(std::unique_ptr<PendingBlock> block);
+    void CompressionWorker();
+
     template <class T>
-    void PutZfp(nlohmann::json &metaj, size_t &datasize, const T *inputData,
-                const Dims &varCount, const Params &params);
+    void PutZfp(std::vector<char> &buffer, size_t &datasize,
+                const T *inputData, const Dims &varCount,
+                const Params &params);
 
     template <class T>
-    void PutSz(nlohmann::json &metaj, size_t &datasize, const T *inputData,
+    void PutSz(std::vector<char> &buffer, size_t &datasize, const T *inputData,
                const Dims &varCount, const Params &params);
 
     template <class T>
-    void PutBZip2(nlohmann::json &metaj, size_t &datasize, const T *inputData,
-                  const Dims &varCount, const Params &params);
+    void PutBZip2(std::vector<char> &buffer, size_t &datasize,
+                  const T *inputData, const Dims &varCount,
+                  const Params &params);
 
     template <class T>
-    void PutMgard(nlohmann::json &metaj, size_t &datasize, const T *inputData,
-                  const Dims &varCount, const Params &params);
+    void PutMgard(std::vector<char> &buffer, size_t &datasize,
+                  const T *inputData, const Dims &varCount,
+                  const Params &params);
 
     template <class T>
     void PutAttribute(const core::Attribute<T> &attribute);
@@ -180,12 +259,28 @@ private:
 
     void JsonToVarMap(nlohmann::json &metaJ, VecPtr pack);
 
+    // returns the schema index for a block, adding a new entry if the
+    // variable changed since it was last put
+    uint32_t GetSchemaIndex(const BinarySchema &schema);
+
+    void PutBinaryBlock(const BinarySchema &schema, const Dims &varStart,
+                        const Dims &varCount, const size_t step,
+                        const int rank, const size_t position,
+                        const size_t datasize, const std::vector<char> &min,
+                        const std::vector<char> &max);
+
+    VecPtr SerializeBinary();
+
+    // returns false if the pack refers to schema entries not received yet
+    bool BinaryToVarMap(VecPtr pack, size_t position, const size_t end);
+
     VecPtr SerializeJson(const nlohmann::json &message);
     nlohmann::json DeserializeJson(const char *start, size_t size);
 
+    // leaves min and max empty for types without ordering
     template <typename T>
     void CalculateMinMax(const T *data, const Dims &count,
-                         nlohmann::json &metaj);
+                         std::vector<char> &min, std::vector<char> &max);
 
     bool StepHasMinimumBlocks(const size_t step,
                               const int requireMinimumBlocks);
@@ -201,9 +296,19 @@ private:
     // writer app API thread, do not need mutex
     nlohmann::json m_MetadataJson;
 
-    // temporary compression buffer, made class member only for saving costs for
-    // memory allocation
-    std::vector<char> m_CompressBuffer;
+    // compression workers, used in writer. Blocks are queued by PutData and
+    // taken by workers from m_CompressionQueue, m_PendingBlocks keeps them in
+    // put order until FinishCompression adds them to the local pack.
+    unsigned int m_CompressionThreads = 1;
+    std::vector<std::thread> m_CompressionWorkers;
+    std::vector<std::unique_ptr<PendingBlock>> m_PendingBlocks;
+    std::deque<PendingBlock *> m_CompressionQueue;
+    size_t m_CompressionsRunning = 0;
+    bool m_StopCompression = false;
+    std::mutex m_CompressionMutex;
+    std::condition_variable m_CompressionQueued;
+    std::condition_variable m_CompressionDone;
+    std::mutex m_SerialCompressionMutex;
 
     // global aggregated buffer for metadata and data buffer, used in writer
     // (Staging engine) and reader (all engines), needs mutex for accessing
@@ -228,6 +333,21 @@ private:
 
     // string, msgpack, cbor, ubjson
     std::string m_UseJsonSerialization = "string";
+    bool m_UseBinaryMetadata = true;
+
+    // binary schema entries and local block records, used in writer, only
+    // accessed from writer app API thread, do not need mutex. Entries from
+    // m_SchemaSent on go with the next local pack.
+    std::vector<BinarySchema> m_Schema;
+    std::unordered_map<std::string, uint32_t> m_SchemaIndex;
+    size_t m_SchemaSent = 0;
+    std::vector<char> m_BinaryBlocks;
+    uint32_t m_BinaryBlockCount = 0;
+    bool m_AttachAttributes = false;
+
+    // binary schema entries received from each writer rank, used in reader
+    std::unordered_map<int, std::vector<BinarySchema>> m_ReceivedSchema;
+    std::mutex m_ReceivedSchemaMutex;
 
     OperatorMap m_OperatorMap;
     std::mutex m_OperatorMapMutex;
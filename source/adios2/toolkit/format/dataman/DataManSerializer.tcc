@@ -37,46 +37,47 @@ namespace format
 
 template <>
 inline void DataManSerializer::CalculateMinMax<std::complex<float>>(
-    const std::complex<float> *data, const Dims &count, nlohmann::json &metaj)
+    const std::complex<float> *data, const Dims &count, std::vector<char> &min,
+    std::vector<char> &max)
 {
 }
 
 template <>
 inline void DataManSerializer::CalculateMinMax<std::complex<double>>(
-    const std::complex<double> *data, const Dims &count, nlohmann::json &metaj)
+    const std::complex<double> *data, const Dims &count,
+    std::vector<char> &min, std::vector<char> &max)
 {
 }
 
 template <typename T>
 void DataManSerializer::CalculateMinMax(const T *data, const Dims &count,
-                                        nlohmann::json &metaj)
+                                        std::vector<char> &min,
+                                        std::vector<char> &max)
 {
     TAU_SCOPED_TIMER_FUNC();
     size_t size = std::accumulate(count.begin(), count.end(), 1,
                                   std::multiplies<size_t>());
-    T max = std::numeric_limits<T>::min();
-    T min = std::numeric_limits<T>::max();
+    T maxValue = std::numeric_limits<T>::min();
+    T minValue = std::numeric_limits<T>::max();
 
     for (size_t j = 0; j < size; ++j)
     {
         T value = data[j];
-        if (value > max)
+        if (value > maxValue)
         {
-            max = value;
+            maxValue = value;
         }
-        if (value < min)
+        if (value < minValue)
         {
-            min = value;
+            minValue = value;
         }
     }
 
-    std::vector<char> vectorValue(sizeof(T));
+    max.resize(sizeof(T));
+    reinterpret_cast<T *>(max.data())[0] = maxValue;
 
-    reinterpret_cast<T *>(vectorValue.data())[0] = max;
-    metaj["+"] = vectorValue;
-
-    reinterpret_cast<T *>(vectorValue.data())[0] = min;
-    metaj["-"] = vectorValue;
+    min.resize(sizeof(T));
+    reinterpret_cast<T *>(min.data())[0] = minValue;
 }
 
 template <class T>
@@ -112,162 +113,112 @@ void DataManSerializer::PutData(
         localBuffer = m_LocalBuffer;
     }
 
-    nlohmann::json metaj;
-
-    metaj["N"] = varName;
-    metaj["O"] = varStart;
-    metaj["C"] = varCount;
-    metaj["S"] = varShape;
-    metaj["Y"] = ToString(helper::GetDataType<T>());
-    metaj["P"] = localBuffer->size();
-
-    if (not address.empty())
-    {
-        metaj["A"] = address;
-    }
+    std::unique_ptr<PendingBlock> block(new PendingBlock);
+    block->schema.type = helper::GetDataType<T>();
+    block->schema.name = varName;
+    block->schema.address = address;
+    block->schema.shape = varShape;
+    block->schema.startDims = varStart.size();
+    block->schema.countDims = varCount.size();
+    block->start = varStart;
+    block->count = varCount;
+    block->step = step;
+    block->rank = rank;
+    block->localBuffer = localBuffer;
+    block->metadataJson = metadataJson;
+    block->data = reinterpret_cast<const char *>(inputData);
+    block->datasize = std::accumulate(varCount.begin(), varCount.end(),
+                                      sizeof(T), std::multiplies<size_t>());
 
     if (m_EnableStat)
     {
-        CalculateMinMax(inputData, varCount, metaj);
-    }
-
-    if (not m_IsRowMajor)
-    {
-        metaj["M"] = m_IsRowMajor;
-    }
-    if (not m_IsLittleEndian)
-    {
-        metaj["E"] = m_IsLittleEndian;
+        CalculateMinMax(inputData, varCount, block->min, block->max);
     }
 
-    size_t datasize = 0;
-    bool compressed = false;
-    std::string compressionMethod;
     if (not ops.empty())
     {
-        compressionMethod = ops[0].Op->m_Type;
+        std::string compressionMethod = ops[0].Op->m_Type;
         std::transform(compressionMethod.begin(), compressionMethod.end(),
                        compressionMethod.begin(), ::tolower);
-        if (compressionMethod == "zfp")
-        {
-            if (IsCompressionAvailable(compressionMethod,
-                                       helper::GetDataType<T>(), varCount))
-            {
-                try
-                {
-                    PutZfp<T>(metaj, datasize, inputData, varCount,
-                              ops[0].Parameters);
-                    compressed = true;
-                }
-                catch (std::exception &e)
-                {
-                    std::cout << e.what() << std::endl;
-                }
-            }
-        }
-        else if (compressionMethod == "sz")
-        {
-            if (IsCompressionAvailable(compressionMethod,
-                                       helper::GetDataType<T>(), varCount))
-            {
-                try
-                {
-                    PutSz<T>(metaj, datasize, inputData, varCount,
-                             ops[0].Parameters);
-                    compressed = true;
-                }
-                catch (std::exception &e)
-                {
-                    std::cout << e.what() << std::endl;
-                }
-            }
-        }
-        else if (compressionMethod == "bzip2")
-        {
-            if (IsCompressionAvailable(compressionMethod,
-                                       helper::GetDataType<T>(), varCount))
-            {
-                try
-                {
-                    PutBZip2<T>(metaj, datasize, inputData, varCount,
-                                ops[0].Parameters);
-                    compressed = true;
-                }
-                catch (std::exception &e)
-                {
-                    std::cout << e.what() << std::endl;
-                }
-            }
-        }
-        else if (compressionMethod == "mgard")
-        {
-            if (IsCompressionAvailable(compressionMethod,
-                                       helper::GetDataType<T>(), varCount))
-            {
-                try
-                {
-                    PutMgard<T>(metaj, datasize, inputData, varCount,
-                                ops[0].Parameters);
-                    compressed = true;
-                }
-                catch (std::exception &e)
-                {
-                    std::cout << e.what() << std::endl;
-                }
-            }
-        }
-        else
+        if (compressionMethod != "zfp" and compressionMethod != "sz" and
+            compressionMethod != "bzip2" and compressionMethod != "mgard")
         {
             throw(std::invalid_argument("Compression method " +
                                         compressionMethod + " not supported."));
         }
+        if (IsCompressionAvailable(compressionMethod, helper::GetDataType<T>(),
+                                   varCount))
+        {
+            block->schema.compression = compressionMethod;
+            block->schema.params = ops[0].Parameters;
+            block->compress = [inputData](DataManSerializer &serializer,
+                                          PendingBlock &b) {
+                serializer.CompressBlock(inputData, b);
+            };
+        }
     }
 
-    if (compressed)
+    if (block->compress and m_CompressionThreads > 1)
     {
-        metaj["Z"] = compressionMethod;
-        metaj["ZP"] = ops[0].Parameters;
+        QueueCompression(std::move(block));
     }
     else
     {
-        datasize = std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
-                                   std::multiplies<size_t>());
-    }
-    metaj["I"] = datasize;
-
-    if (localBuffer->capacity() < localBuffer->size() + datasize)
-    {
-        localBuffer->reserve((localBuffer->size() + datasize) * 2);
+        if (block->compress)
+        {
+            CompressBlock(inputData, *block);
+        }
+        PutBlock(*block);
     }
 
-    localBuffer->resize(localBuffer->size() + datasize);
-
-    if (compressed)
-    {
-        std::memcpy(localBuffer->data() + localBuffer->size() - datasize,
-                    m_CompressBuffer.data(), datasize);
-    }
-    else
-    {
-        std::memcpy(localBuffer->data() + localBuffer->size() - datasize,
-                    inputData, datasize);
-    }
+    Log(1,
+        "DataManSerializer::PutData end with Step " + std::to_string(step) +
+            " Var " + varName,
+        true, true);
+}
 
-    if (metadataJson == nullptr)
+template <class T>
+void DataManSerializer::CompressBlock(const T *inputData, PendingBlock &block)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    const std::string &method = block.schema.compression;
+    try
     {
-        m_MetadataJson[std::to_string(step)][std::to_string(rank)].emplace_back(
-            std::move(metaj));
+        if (method == "zfp")
+        {
+            PutZfp<T>(block.compressBuffer, block.datasize, inputData,
+                      block.count, block.schema.params);
+        }
+        else if (method == "sz")
+        {
+            // the SZ and MGARD libraries keep global state
+            std::lock_guard<std::mutex> l(m_SerialCompressionMutex);
+            PutSz<T>(block.compressBuffer, block.datasize, inputData,
+                     block.count, block.schema.params);
+        }
+        else if (method == "bzip2")
+        {
+            PutBZip2<T>(block.compressBuffer, block.datasize, inputData,
+                        block.count, block.schema.params);
+        }
+        else if (method == "mgard")
+        {
+            std::lock_guard<std::mutex> l(m_SerialCompressionMutex);
+            PutMgard<T>(block.compressBuffer, block.datasize, inputData,
+                        block.count, block.schema.params);
+        }
+        block.compressed = true;
     }
-    else
+    catch (std::exception &e)
     {
-        (*metadataJson)[std::to_string(step)][std::to_string(rank)]
-            .emplace_back(std::move(metaj));
+        std::cout << e.what() << std::endl;
+        // send the block uncompressed
+        block.schema.compression.clear();
+        block.schema.params.clear();
+        block.datasize =
+            std::accumulate(block.count.begin(), block.count.end(), sizeof(T),
+                            std::multiplies<size_t>());
     }
-
-    Log(1,
-        "DataManSerializer::PutData end with Step " + std::to_string(step) +
-            " Var " + varName,
-        true, true);
 }
 
 template <class T>
@@ -466,22 +417,21 @@ int DataManSerializer::GetData(T *outputData, const std::string &varName,
 }
 
 template <class T>
-void DataManSerializer::PutZfp(nlohmann::json &metaj, size_t &datasize,
+void DataManSerializer::PutZfp(std::vector<char> &buffer, size_t &datasize,
                                const T *inputData, const Dims &varCount,
                                const Params &params)
 {
     TAU_SCOPED_TIMER_FUNC();
 #ifdef ADIOS2_HAVE_ZFP
     core::compress::CompressZFP compressor(params);
-    m_CompressBuffer.reserve(std::accumulate(varCount.begin(), varCount.end(),
-                                             sizeof(T),
-                                             std::multiplies<size_t>()));
+    buffer.resize(std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
+                                  std::multiplies<size_t>()));
     try
     {
         Params info;
         datasize = compressor.Compress(inputData, varCount, sizeof(T),
                                        helper::GetDataType<T>(),
-                                       m_CompressBuffer.data(), params, info);
+                                       buffer.data(), params, info);
     }
     catch (std::exception &e)
     {
@@ -494,22 +444,21 @@ void DataManSerializer::PutZfp(nlohmann::json &metaj, size_t &datasize,
 }
 
 template <class T>
-void DataManSerializer::PutSz(nlohmann::json &metaj, size_t &datasize,
+void DataManSerializer::PutSz(std::vector<char> &buffer, size_t &datasize,
                               const T *inputData, const Dims &varCount,
                               const Params &params)
 {
     TAU_SCOPED_TIMER_FUNC();
 #ifdef ADIOS2_HAVE_SZ
-    m_CompressBuffer.reserve(std::accumulate(varCount.begin(), varCount.end(),
-                                             sizeof(T),
-                                             std::multiplies<size_t>()));
+    buffer.resize(std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
+                                  std::multiplies<size_t>()));
     core::compress::CompressSZ compressor(params);
     try
     {
         Params info;
         datasize = compressor.Compress(inputData, varCount, sizeof(T),
                                        helper::GetDataType<T>(),
-                                       m_CompressBuffer.data(), params, info);
+                                       buffer.data(), params, info);
     }
     catch (std::exception &e)
     {
@@ -522,22 +471,21 @@ void DataManSerializer::PutSz(nlohmann::json &metaj, size_t &datasize,
 }
 
 template <class T>
-void DataManSerializer::PutBZip2(nlohmann::json &metaj, size_t &datasize,
+void DataManSerializer::PutBZip2(std::vector<char> &buffer, size_t &datasize,
                                  const T *inputData, const Dims &varCount,
                                  const Params &params)
 {
     TAU_SCOPED_TIMER_FUNC();
 #ifdef ADIOS2_HAVE_BZIP2
-    m_CompressBuffer.reserve(std::accumulate(varCount.begin(), varCount.end(),
-                                             sizeof(T),
-                                             std::multiplies<size_t>()));
+    buffer.resize(std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
+                                  std::multiplies<size_t>()));
     core::compress::CompressBZIP2 compressor(params);
     try
     {
         Params info;
         datasize = compressor.Compress(inputData, varCount, sizeof(T),
                                        helper::GetDataType<T>(),
-                                       m_CompressBuffer.data(), params, info);
+                                       buffer.data(), params, info);
     }
     catch (std::exception &e)
     {
@@ -550,22 +498,21 @@ void DataManSerializer::PutBZip2(nlohmann::json &metaj, size_t &datasize,
 }
 
 template <class T>
-void DataManSerializer::PutMgard(nlohmann::json &metaj, size_t &datasize,
+void DataManSerializer::PutMgard(std::vector<char> &buffer, size_t &datasize,
                                  const T *inputData, const Dims &varCount,
                                  const Params &params)
 {
     TAU_SCOPED_TIMER_FUNC();
 #ifdef ADIOS2_HAVE_MGARD
     core::compress::CompressMGARD compressor(params);
-    m_CompressBuffer.reserve(std::accumulate(varCount.begin(), varCount.end(),
-                                             sizeof(T),
-                                             std::multiplies<size_t>()));
+    buffer.resize(std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
+                                  std::multiplies<size_t>()));
     try
     {
         Params info;
         datasize = compressor.Compress(inputData, varCount, sizeof(T),
                                        helper::GetDataType<T>(),
-                                       m_CompressBuffer.data(), params, info);
+                                       buffer.data(), params, info);
     }
     catch (std::exception &e)
     {
@@ -66,6 +66,11 @@ void CP_validateParams(SstStream Stream, SstParams Params, int Writer)
         {
             Params->DataTransport = strdup("rdma");
         }
+        else if ((strcmp(SelectedTransport, "shm") == 0) ||
+                 (strcmp(SelectedTransport, "sharedmemory") == 0))
+        {
+            Params->DataTransport = strdup("shm");
+        }
         free(SelectedTransport);
     }
     if (Params->ControlTransport == NULL)
@@ -213,6 +218,8 @@ extern void CP_dumpParams(SstStream Stream, struct _SstParams *Params,
                 SstMarshalStr[Params->MarshalMethod]);
         fprintf(stderr, "Param -   FirstTimestepPrecious=%s\n",
                 Params->FirstTimestepPrecious ? "True" : "False");
+        fprintf(stderr, "Param -   DeferredPutNoCopy=%s\n",
+                Params->DeferredPutNoCopy ? "True" : "False");
         fprintf(stderr, "Param -   IsRowMajor=%d  (not user settable) \n",
                 Params->IsRowMajor);
     }
@@ -1411,6 +1411,32 @@ extern void *SstReadRemoteMemory(SstStream Stream, int Rank, long Timestep,
         DP_TimestepInfo);
 }
 
+//  SstReadRemoteMemorySelection is only called by the main program thread.
+//  Returns NULL if the data plane cannot pack the selection on the writer
+//  side, the caller then reads the whole block with SstReadRemoteMemory.
+extern void *SstReadRemoteMemorySelection(
+    SstStream Stream, int Rank, long Timestep, size_t Offset, int ElementSize,
+    int DimCount, const size_t *BlockCount, const size_t *SelectionStart,
+    const size_t *SelectionCount, void *Buffer, void *DP_TimestepInfo)
+{
+    void *Ret;
+    size_t Length = ElementSize;
+    if (Stream->ConfigParams->ReaderShortCircuitReads ||
+        !Stream->DP_Interface->readRemoteMemorySelection)
+        return NULL;
+    Ret = Stream->DP_Interface->readRemoteMemorySelection(
+        &Svcs, Stream->DP_Stream, Rank, Timestep, Offset, ElementSize,
+        DimCount, BlockCount, SelectionStart, SelectionCount, Buffer,
+        DP_TimestepInfo);
+    if (!Ret)
+        return NULL;
+    for (int i = 0; i < DimCount; i++)
+        Length *= SelectionCount[i];
+    Stream->Stats.BytesTransferred += Length;
+    AddToReadStats(Stream, Rank, Timestep, Length);
+    return Ret;
+}
+
 static void sendOneToEachWriterRank(SstStream Stream, CMFormat f, void *Msg,
                                     void **WS_StreamPtr)
 {
@@ -1,3 +1,5 @@
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -323,9 +325,15 @@ struct FFSMetadataInfoStruct
     size_t BitFieldCount;
     size_t *BitField;
     size_t DataBlockSize;
+    size_t DataBlockOffsetCount;
+    size_t *DataBlockOffsets; // per FieldID, where the array is in the block
 };
 
 static int FFSBitfieldTest(struct FFSMetadataInfoStruct *MBase, int Bit);
+static void ReverseDimensions(size_t *Dimensions, int count);
+
+#define MAX(x, y) (((x) > (y)) ? (x) : (y))
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
 static void InitMarshalData(SstStream Stream)
 {
@@ -348,6 +356,11 @@ static void InitMarshalData(SstStream Stream)
                    "integer[BitFieldCount]", sizeof(size_t));
     AddSimpleField(&Info->MetaFields, &Info->MetaFieldCount, "DataBlockSize",
                    "integer", sizeof(size_t));
+    AddSimpleField(&Info->MetaFields, &Info->MetaFieldCount,
+                   "DataBlockOffsetCount", "integer", sizeof(size_t));
+    AddSimpleField(&Info->MetaFields, &Info->MetaFieldCount,
+                   "DataBlockOffsets", "integer[DataBlockOffsetCount]",
+                   sizeof(size_t));
     RecalcMarshalStorageSize(Stream);
     MBase = Stream->M;
     MBase->BitFieldCount = 0;
@@ -416,6 +429,7 @@ extern void FFSFreeMarshalData(SstStream Stream)
                 free(Info->VarList[i]->PerWriterCounts);
                 free(Info->VarList[i]->PerWriterIncomingData);
                 free(Info->VarList[i]->PerWriterIncomingSize);
+                free(Info->VarList[i]->PerWriterDataOffset);
                 free(Info->VarList[i]);
             }
             if (Info->VarList)
@@ -456,6 +470,8 @@ static FFSWriterRec CreateWriterRec(SstStream Stream, void *Variable,
     Rec->FieldID = Info->RecCount;
     Rec->DimCount = DimCount;
     Rec->Type = Type;
+    Rec->ElemSize = ElemSize;
+    Rec->DeferredData = 0;
     if (DimCount == 0)
     {
         // simple field, only add base value FMField to metadata
@@ -677,6 +693,7 @@ static FFSVarRec CreateVarRec(SstStream Stream, const char *ArrayName)
         calloc(sizeof(void *), Stream->WriterCohortSize);
     Ret->PerWriterIncomingSize =
         calloc(sizeof(size_t), Stream->WriterCohortSize);
+    Ret->PerWriterDataOffset = calloc(sizeof(size_t), Stream->WriterCohortSize);
     Info->VarList[Info->VarCount++] = Ret;
     return Ret;
 }
@@ -738,6 +755,7 @@ extern int SstFFSGetDeferred(SstStream Stream, void *Variable, const char *Name,
         Req->Count = malloc(sizeof(Count[0]) * Var->DimCount);
         memcpy(Req->Count, Count, sizeof(Count[0]) * Var->DimCount);
         Req->Data = Data;
+        Req->Partials = NULL;
         Req->Next = Info->PendingVarRequests;
         Info->PendingVarRequests = Req;
         return 1; // Later Sync needed
@@ -819,21 +837,159 @@ static int NeedWriter(FFSArrayRequest Req, int i)
     return 1;
 }
 
+/*
+ * A global request can be served with a selection read if the writer sent
+ * its array as a single uncompressed block at a known offset in the data
+ * block, and the data plane supports it.
+ */
+static int PartialReadPossible(SstStream Stream, FFSArrayRequest Req, int i)
+{
+    struct FFSReaderMarshalBase *Info = Stream->ReaderMarshalData;
+    FFSVarRec VarRec = Req->VarRec;
+
+    return Stream->DP_Interface->readRemoteMemorySelection &&
+           (Req->RequestType == Global) &&
+           (Info->WriterInfo[i].Status == Empty) && (VarRec->DimCount > 0) &&
+           (VarRec->PerWriterBlockCount[i] == 1) &&
+           (VarRec->PerWriterDataOffset[i] != 0);
+}
+
+/* intersection of the writer block and the request, 0 if empty */
+static size_t IntersectBlock(FFSArrayRequest Req, int i, size_t *Start,
+                             size_t *Count)
+{
+    FFSVarRec VarRec = Req->VarRec;
+    size_t Bytes = VarRec->ElementSize;
+
+    for (int j = 0; j < VarRec->DimCount; j++)
+    {
+        size_t Left = MAX(VarRec->PerWriterStart[i][j], Req->Start[j]);
+        size_t Right = MIN(VarRec->PerWriterStart[i][j] +
+                               VarRec->PerWriterCounts[i][j],
+                           Req->Start[j] + Req->Count[j]);
+        if (Right <= Left)
+            return 0;
+        Start[j] = Left;
+        Count[j] = Right - Left;
+        Bytes *= Count[j];
+    }
+    return Bytes;
+}
+
+static void IssuePartialRead(SstStream Stream, FFSArrayRequest Req, int i)
+{
+    struct FFSReaderMarshalBase *Info = Stream->ReaderMarshalData;
+    SstFullMetadata Mdata = Stream->CurrentMetadata;
+    FFSVarRec VarRec = Req->VarRec;
+    int DimCount = VarRec->DimCount;
+    void *DP_TimestepInfo =
+        Mdata->DP_TimestepInfo ? Mdata->DP_TimestepInfo[i] : NULL;
+    FFSPartialRead Partial = malloc(sizeof(*Partial));
+    size_t *BlockCount = malloc(DimCount * sizeof(size_t));
+    size_t *SelStart = malloc(DimCount * sizeof(size_t));
+    size_t *SelCount = malloc(DimCount * sizeof(size_t));
+
+    Partial->WriterRank = i;
+    Partial->Start = malloc(DimCount * sizeof(size_t));
+    Partial->Count = malloc(DimCount * sizeof(size_t));
+    size_t Bytes = IntersectBlock(Req, i, Partial->Start, Partial->Count);
+    Partial->Buffer = malloc(Bytes);
+
+    /* the DP packs row-major, in the writer block's own index space */
+    for (int j = 0; j < DimCount; j++)
+    {
+        BlockCount[j] = VarRec->PerWriterCounts[i][j];
+        SelStart[j] = Partial->Start[j] - VarRec->PerWriterStart[i][j];
+        SelCount[j] = Partial->Count[j];
+    }
+    if (!Stream->ConfigParams->IsRowMajor)
+    {
+        ReverseDimensions(BlockCount, DimCount);
+        ReverseDimensions(SelStart, DimCount);
+        ReverseDimensions(SelCount, DimCount);
+    }
+    Partial->ReadHandle = SstReadRemoteMemorySelection(
+        Stream, i, Stream->ReaderTimestep, VarRec->PerWriterDataOffset[i],
+        VarRec->ElementSize, DimCount, BlockCount, SelStart, SelCount,
+        Partial->Buffer, DP_TimestepInfo);
+    free(BlockCount);
+    free(SelStart);
+    free(SelCount);
+
+    if (!Partial->ReadHandle)
+    {
+        /* not possible right now, get the whole block */
+        free(Partial->Start);
+        free(Partial->Count);
+        free(Partial->Buffer);
+        free(Partial);
+        Info->WriterInfo[i].Status = Needed;
+        return;
+    }
+    Partial->Next = Req->Partials;
+    Req->Partials = Partial;
+}
+
 static void IssueReadRequests(SstStream Stream, FFSArrayRequest Reqs)
 {
     struct FFSReaderMarshalBase *Info = Stream->ReaderMarshalData;
     SstFullMetadata Mdata = Stream->CurrentMetadata;
+    FFSArrayRequest Req;
 
-    while (Reqs)
+    for (int i = 0; i < Stream->WriterCohortSize; i++)
+    {
+        Info->WriterInfo[i].PartialBytes = 0;
+    }
+
+    /*
+     * Writers whose blocks are only partly needed get selection reads,
+     * unless the selections add up to a good part of the data block anyway
+     */
+    for (Req = Reqs; Req; Req = Req->Next)
     {
         for (int i = 0; i < Stream->WriterCohortSize; i++)
         {
-            if ((Info->WriterInfo[i].Status != Needed) && (NeedWriter(Reqs, i)))
+            if ((Info->WriterInfo[i].Status != Needed) && (NeedWriter(Req, i)))
+            {
+                if (PartialReadPossible(Stream, Req, i))
+                {
+                    size_t *Tmp = malloc(2 * Req->VarRec->DimCount *
+                                         sizeof(size_t));
+                    Info->WriterInfo[i].PartialBytes += IntersectBlock(
+                        Req, i, Tmp, Tmp + Req->VarRec->DimCount);
+                    free(Tmp);
+                }
+                else
+                {
+                    Info->WriterInfo[i].Status = Needed;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < Stream->WriterCohortSize; i++)
+    {
+        if ((Info->WriterInfo[i].Status != Needed) &&
+            (Info->WriterInfo[i].PartialBytes > 0))
+        {
+            size_t DataSize =
+                ((struct FFSMetadataInfoStruct *)Info->MetadataBaseAddrs[i])
+                    ->DataBlockSize;
+            if (Info->WriterInfo[i].PartialBytes >= DataSize / 2)
             {
                 Info->WriterInfo[i].Status = Needed;
             }
         }
-        Reqs = Reqs->Next;
+    }
+    for (Req = Reqs; Req; Req = Req->Next)
+    {
+        for (int i = 0; i < Stream->WriterCohortSize; i++)
+        {
+            if ((Info->WriterInfo[i].Status == Empty) &&
+                (Info->WriterInfo[i].PartialBytes > 0) && NeedWriter(Req, i))
+            {
+                IssuePartialRead(Stream, Req, i);
+            }
+        }
     }
 
     for (int i = 0; i < Stream->WriterCohortSize; i++)
@@ -869,6 +1025,15 @@ static void ClearReadRequests(SstStream Stream)
     {
         FFSArrayRequest PrevReq = Req;
         Req = Req->Next;
+        while (PrevReq->Partials)
+        {
+            FFSPartialRead Partial = PrevReq->Partials;
+            PrevReq->Partials = Partial->Next;
+            free(Partial->Start);
+            free(Partial->Count);
+            free(Partial->Buffer);
+            free(Partial);
+        }
         free(PrevReq->Count);
         free(PrevReq->Start);
         free(PrevReq);
@@ -973,6 +1138,23 @@ static SstStatusValue WaitForReadRequests(SstStream Stream)
             }
         }
     }
+    for (FFSArrayRequest Req = Info->PendingVarRequests; Req; Req = Req->Next)
+    {
+        for (FFSPartialRead Partial = Req->Partials; Partial;
+             Partial = Partial->Next)
+        {
+            SstStatusValue Result =
+                SstWaitForCompletion(Stream, Partial->ReadHandle);
+            Partial->ReadHandle = NULL;
+            if (Result != SstSuccess)
+            {
+                CP_verbose(Stream, CriticalVerbose,
+                           "Wait for remote selection read completion "
+                           "failed, returning failure\n");
+                return Result;
+            }
+        }
+    }
     CP_verbose(Stream, TraceVerbose, "All remote memory reads completed\n");
     return SstSuccess;
 }
@@ -1019,9 +1201,6 @@ static int FindOffsetCM(size_t Dims, const size_t *Size, const size_t *Index)
     return Offset;
 }
 
-#define MAX(x, y) (((x) > (y)) ? (x) : (y))
-#define MIN(x, y) (((x) < (y)) ? (x) : (y))
-
 /*
  *  - ElementSize is the byte size of the array elements
  *  - Dims is the number of dimensions in the variable
@@ -1329,7 +1508,30 @@ static void FillReadRequests(SstStream Stream, FFSArrayRequest Reqs)
         ImplementGapWarning(Stream, Reqs);
         for (int i = 0; i < Stream->WriterCohortSize; i++)
         {
-            if (NeedWriter(Reqs, i))
+            FFSPartialRead Partial = Reqs->Partials;
+            while (Partial && (Partial->WriterRank != i))
+                Partial = Partial->Next;
+            if (Partial)
+            {
+                /* only the intersection with the selection was pulled */
+                if (Stream->ConfigParams->IsRowMajor)
+                {
+                    ExtractSelectionFromPartialRM(
+                        Reqs->VarRec->ElementSize, Reqs->VarRec->DimCount,
+                        Reqs->VarRec->GlobalDims, Partial->Start,
+                        Partial->Count, Reqs->Start, Reqs->Count,
+                        Partial->Buffer, Reqs->Data);
+                }
+                else
+                {
+                    ExtractSelectionFromPartialCM(
+                        Reqs->VarRec->ElementSize, Reqs->VarRec->DimCount,
+                        Reqs->VarRec->GlobalDims, Partial->Start,
+                        Partial->Count, Reqs->Start, Reqs->Count,
+                        Partial->Buffer, Reqs->Data);
+                }
+            }
+            else if (NeedWriter(Reqs, i))
             {
                 /* if needed this writer fill destination with acquired data */
                 int ElementSize = Reqs->VarRec->ElementSize;
@@ -1445,6 +1647,89 @@ extern SstStatusValue SstFFSPerformGets(SstStream Stream)
     return Ret;
 }
 
+/*
+ * Copies the arrays still referencing application data, so it can be
+ * reused.  Deferred arrays are encoded from application data at EndStep
+ * otherwise.  Either way the timestep keeps a single copy, its data block,
+ * which is queued and released like any other (QueueLimit/QueueFullPolicy).
+ */
+extern void SstFFSWriterPerformPuts(SstStream Stream)
+{
+    struct FFSWriterMarshalBase *Info = Stream->WriterMarshalData;
+    if (!Info)
+        return;
+
+    for (int i = 0; i < Info->RecCount; i++)
+    {
+        FFSWriterRec Rec = &Info->RecList[i];
+        if (!Rec->DeferredData)
+            continue;
+
+        ArrayRec *DataEntry =
+            (ArrayRec *)((char *)(Stream->D) + Rec->DataOffset);
+        void *Tmp = malloc(DataEntry->ElemCount * Rec->ElemSize);
+        memcpy(Tmp, DataEntry->Array, DataEntry->ElemCount * Rec->ElemSize);
+        DataEntry->Array = Tmp;
+        Rec->DeferredData = 0;
+    }
+}
+
+/*
+ * Records where the array of each variable written this step starts in the
+ * encoded data block, so that readers can pull a selection of it instead of
+ * the whole block.  An offset of 0 means unknown, for example for
+ * compressed arrays.
+ */
+static void RecordDataBlockOffsets(SstStream Stream, const char *Block,
+                                   size_t BlockSize)
+{
+    struct FFSWriterMarshalBase *Info = Stream->WriterMarshalData;
+    struct FFSMetadataInfoStruct *MBase = Stream->M;
+    size_t HeaderSize;
+    int IDLength;
+
+    MBase->DataBlockOffsetCount = Info->RecCount;
+    MBase->DataBlockOffsets =
+        calloc(Info->RecCount ? Info->RecCount : 1, sizeof(size_t));
+    if (!Block)
+        return;
+
+    /*
+     * the format has variable arrays, so the FFS header is the format ID
+     * and a length, padded to 8.  Encoded pointers are relative to the end
+     * of the header.
+     */
+    get_server_ID_FMformat(Info->DataFormat, &IDLength);
+    HeaderSize = (IDLength + 4 + 7) & ~((size_t)7);
+
+    for (int i = 0; i < Info->RecCount; i++)
+    {
+        FFSWriterRec Rec = &Info->RecList[i];
+        if ((Rec->DimCount == 0) || !FFSBitfieldTest(MBase, Rec->FieldID))
+            continue;
+        if ((Stream->ConfigParams->CompressionMethod == SstCompressZFP) &&
+            ZFPcompressionPossible(Rec->Type, Rec->DimCount))
+            continue;
+
+        ArrayRec *DataEntry =
+            (ArrayRec *)((char *)(Stream->D) + Rec->DataOffset);
+        size_t Length = DataEntry->ElemCount * Rec->ElemSize;
+        uintptr_t Encoded;
+        size_t Offset;
+        if (!DataEntry->Array || (Length == 0))
+            continue;
+        memcpy(&Encoded,
+               Block + HeaderSize + Rec->DataOffset + offsetof(ArrayRec, Array),
+               sizeof(Encoded));
+        Offset = HeaderSize + Encoded;
+        /* don't hand out an offset we can't vouch for */
+        if ((Offset + Length > BlockSize) ||
+            (memcmp(Block + Offset, DataEntry->Array, MIN(Length, 64)) != 0))
+            continue;
+        MBase->DataBlockOffsets[Rec->FieldID] = Offset;
+    }
+}
+
 extern void SstFFSWriterEndStep(SstStream Stream, size_t Timestep)
 {
     struct FFSWriterMarshalBase *Info;
@@ -1567,6 +1852,7 @@ extern void SstFFSWriterEndStep(SstStream Stream, size_t Timestep)
 
     MBase = Stream->M;
     MBase->DataBlockSize = DataSize;
+    RecordDataBlockOffsets(Stream, DataRec.block, DataSize);
     MetaDataRec.block =
         FFSencode(MetaEncodeBuffer, Info->MetaFormat, Stream->M, &MetaDataSize);
     MetaDataRec.DataSize = MetaDataSize;
@@ -1585,6 +1871,19 @@ extern void SstFFSWriterEndStep(SstStream Stream, size_t Timestep)
         AttributeRec.DataSize = 0;
     }
 
+    /* application data is not ours to free */
+    for (int i = 0; i < Info->RecCount; i++)
+    {
+        FFSWriterRec Rec = &Info->RecList[i];
+        if (Rec->DeferredData)
+        {
+            ArrayRec *DataEntry =
+                (ArrayRec *)((char *)(Stream->D) + Rec->DataOffset);
+            DataEntry->Array = NULL;
+            Rec->DeferredData = 0;
+        }
+    }
+
     /* free all those copied dimensions, etc */
     MBase = Stream->M;
     size_t *tmp = MBase->BitField;
@@ -1765,6 +2064,8 @@ extern void FFSClearTimestepData(SstStream Stream)
     for (int i = 0; i < Info->VarCount; i++)
     {
         Info->VarList[i]->Variable = NULL;
+        memset(Info->VarList[i]->PerWriterDataOffset, 0,
+               sizeof(size_t) * Stream->WriterCohortSize);
     }
 }
 
@@ -1773,15 +2074,24 @@ static struct ControlInfo *BuildControl(SstStream Stream, FMFormat Format)
     struct FFSReaderMarshalBase *Info = Stream->ReaderMarshalData;
     FMStructDescList FormatList = format_list_of_FMFormat(Format);
     FMFieldList FieldList = FormatList[0].field_list;
+    struct ControlInfo *ret = malloc(sizeof(*ret));
+    ret->Format = Format;
+    ret->DataBlockOffsetCountFieldOffset = -1;
+    ret->DataBlockOffsetsFieldOffset = -1;
     while (strncmp(FieldList->field_name, "BitField", 8) == 0)
         FieldList++;
     while (FieldList->field_name &&
            (strncmp(FieldList->field_name, "DataBlockSize", 8) == 0))
+    {
+        /* sent by writers which support selection reads */
+        if (strcmp(FieldList->field_name, "DataBlockOffsetCount") == 0)
+            ret->DataBlockOffsetCountFieldOffset = FieldList->field_offset;
+        else if (strcmp(FieldList->field_name, "DataBlockOffsets") == 0)
+            ret->DataBlockOffsetsFieldOffset = FieldList->field_offset;
         FieldList++;
+    }
     int i = 0;
     int ControlCount = 0;
-    struct ControlInfo *ret = malloc(sizeof(*ret));
-    ret->Format = Format;
     while (FieldList[i].field_name)
     {
         ret = realloc(ret,
@@ -1959,6 +2269,18 @@ static void BuildVarList(SstStream Stream, TSMetadataMsg MetaData,
     }
     ControlArray = &Control->Controls[0];
 
+    size_t DataBlockOffsetCount = 0;
+    size_t *DataBlockOffsets = NULL;
+    if ((Control->DataBlockOffsetCountFieldOffset != -1) &&
+        (Control->DataBlockOffsetsFieldOffset != -1))
+    {
+        DataBlockOffsetCount =
+            *(size_t *)((char *)BaseData +
+                        Control->DataBlockOffsetCountFieldOffset);
+        DataBlockOffsets = *(size_t **)((char *)BaseData +
+                                        Control->DataBlockOffsetsFieldOffset);
+    }
+
     Info->MetadataBaseAddrs[WriterRank] = BaseData;
     for (int i = 0; i < Control->ControlCount; i++)
     {
@@ -1998,6 +2320,8 @@ static void BuildVarList(SstStream Stream, TSMetadataMsg MetaData,
                 meta_base->Dims ? meta_base->DBCount / meta_base->Dims : 1;
             VarRec->PerWriterStart[WriterRank] = meta_base->Offsets;
             VarRec->PerWriterCounts[WriterRank] = meta_base->Count;
+            VarRec->PerWriterDataOffset[WriterRank] =
+                (i < DataBlockOffsetCount) ? DataBlockOffsets[i] : 0;
             if (WriterRank == 0)
             {
                 VarRec->PerWriterBlockStart[WriterRank] = 0;
@@ -2103,7 +2427,8 @@ extern void SstFFSSetZFPParams(SstStream Stream, attr_list Attrs)
 extern void SstFFSMarshal(SstStream Stream, void *Variable, const char *Name,
                           const int Type, size_t ElemSize, size_t DimCount,
                           const size_t *Shape, const size_t *Count,
-                          const size_t *Offsets, const void *Data)
+                          const size_t *Offsets, const void *Data,
+                          const int Deferred)
 {
 
     struct FFSMetadataInfoStruct *MBase;
@@ -2179,17 +2504,42 @@ extern void SstFFSMarshal(SstStream Stream, void *Variable, const char *Name,
                 /* normal array case */
                 size_t ElemCount = CalcSize(DimCount, Count);
                 DataEntry->ElemCount = ElemCount;
-                /* this is PutSync case, so we have to copy the data NOW */
-                DataEntry->Array = malloc(ElemCount * ElemSize);
-                memcpy(DataEntry->Array, Data, ElemCount * ElemSize);
+                if (Deferred)
+                {
+                    /*
+                     * PutDeferred case, Data stays valid until PerformPuts
+                     * or EndStep, FFSencode copies it straight into the
+                     * timestep data block
+                     */
+                    DataEntry->Array = (void *)Data;
+                    Rec->DeferredData = 1;
+                }
+                else
+                {
+                    /* this is PutSync case, so we have to copy the data NOW */
+                    DataEntry->Array = malloc(ElemCount * ElemSize);
+                    memcpy(DataEntry->Array, Data, ElemCount * ElemSize);
+                }
             }
             else
             {
                 size_t ElemCount = CalcSize(DimCount, Count);
-                /* this is PutSync case, so we have to copy the data NOW */
-                DataEntry->Array =
-                    realloc(DataEntry->Array,
-                            (DataEntry->ElemCount + ElemCount) * ElemSize);
+                /* blocks are concatenated, so we have to copy the data NOW */
+                if (Rec->DeferredData)
+                {
+                    void *Tmp = malloc((DataEntry->ElemCount + ElemCount) *
+                                       ElemSize);
+                    memcpy(Tmp, DataEntry->Array,
+                           DataEntry->ElemCount * ElemSize);
+                    DataEntry->Array = Tmp;
+                    Rec->DeferredData = 0;
+                }
+                else
+                {
+                    DataEntry->Array =
+                        realloc(DataEntry->Array,
+                                (DataEntry->ElemCount + ElemCount) * ElemSize);
+                }
                 memcpy((char *)DataEntry->Array +
                            DataEntry->ElemCount * ElemSize,
                        Data, ElemCount * ElemSize);
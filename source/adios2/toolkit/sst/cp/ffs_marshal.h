@@ -26,6 +26,9 @@ typedef struct _FFSWriterRec
     size_t MetaOffset;
     int DimCount;
     int Type;
+    size_t ElemSize;
+    /* Array of this step points to application data until it is encoded */
+    int DeferredData;
 } * FFSWriterRec;
 
 struct FFSWriterMarshalBase
@@ -63,6 +66,7 @@ typedef struct FFSVarRec
     size_t **PerWriterCounts;
     void **PerWriterIncomingData;
     size_t *PerWriterIncomingSize; // important for compression
+    size_t *PerWriterDataOffset;   // array offset in data block, 0 if unknown
 } * FFSVarRec;
 
 enum FFSRequestTypeEnum
@@ -71,6 +75,17 @@ enum FFSRequestTypeEnum
     Local = 1
 };
 
+/* part of a writer block pulled packed with the DP selection read */
+typedef struct FFSPartialRead
+{
+    int WriterRank;
+    size_t *Start; // intersection of the block and the request, global index
+    size_t *Count;
+    char *Buffer;
+    DP_CompletionHandle ReadHandle;
+    struct FFSPartialRead *Next;
+} * FFSPartialRead;
+
 typedef struct FFSArrayRequest
 {
     FFSVarRec VarRec;
@@ -79,6 +94,7 @@ typedef struct FFSArrayRequest
     size_t *Start;
     size_t *Count;
     void *Data;
+    FFSPartialRead Partials;
     struct FFSArrayRequest *Next;
 } * FFSArrayRequest;
 
@@ -95,6 +111,7 @@ typedef struct FFSReaderPerWriterRec
     enum WriterDataStatusEnum Status;
     char *RawBuffer;
     DP_CompletionHandle ReadHandle;
+    size_t PartialBytes;
 } FFSReaderPerWriterRec;
 
 struct ControlStruct
@@ -111,6 +128,8 @@ struct ControlInfo
 {
     FMFormat Format;
     int ControlCount;
+    int DataBlockOffsetCountFieldOffset; // -1 if the writer doesn't send it
+    int DataBlockOffsetsFieldOffset;
     struct ControlInfo *Next;
     struct ControlStruct Controls[1];
 };
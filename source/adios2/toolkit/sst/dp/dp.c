@@ -16,6 +16,9 @@ extern CP_DP_Interface LoadRdmaDP();
 #ifdef SST_HAVE_NVSTREAM
 extern CP_DP_Interface LoadNvstreamDP();
 #endif /* SST_HAVE_LIBFABRIC */
+#ifdef SST_HAVE_SHM
+extern CP_DP_Interface LoadShmDP();
+#endif /* SST_HAVE_SHM */
 extern CP_DP_Interface LoadEVpathDP();
 
 typedef struct _DPElement
@@ -63,6 +66,10 @@ CP_DP_Interface SelectDP(CP_Services Svcs, void *CP_Stream,
         AddDPPossibility(Svcs, CP_Stream, List, LoadRdmaDP(), "rdma", Params);
 #endif /* SST_HAVE_LIBFABRIC */
 
+#ifdef SST_HAVE_SHM
+    List = AddDPPossibility(Svcs, CP_Stream, List, LoadShmDP(), "shm", Params);
+#endif /* SST_HAVE_SHM */
+
 #ifdef SST_HAVE_NVSTREAM
     List = AddDPPossibility(Svcs, CP_Stream, List, LoadNvstreamDP(), "nvstream",
                             Params);
@@ -64,6 +64,7 @@ typedef struct _Evpath_RS_Stream
     CManager cm;
     void *CP_Stream;
     CMFormat ReadRequestFormat;
+    CMFormat SelectionReadRequestFormat;
     pthread_mutex_t DataLock;
     int Rank;
 
@@ -186,6 +187,51 @@ static FMStructDescRec EvpathReadRequestStructs[] = {
      sizeof(struct _EvpathReadRequestMsg), NULL},
     {NULL, NULL, 0, NULL}};
 
+typedef struct _EvpathSelectionReadRequestMsg
+{
+    long Timestep;
+    size_t Offset;
+    int ElementSize;
+    int DimCount;
+    size_t *BlockCount;
+    size_t *SelectionStart;
+    size_t *SelectionCount;
+    void *WS_Stream;
+    void *RS_Stream;
+    int RequestingRank;
+    int NotifyCondition;
+} * EvpathSelectionReadRequestMsg;
+
+static FMField EvpathSelectionReadRequestList[] = {
+    {"Timestep", "integer", sizeof(long),
+     FMOffset(EvpathSelectionReadRequestMsg, Timestep)},
+    {"Offset", "integer", sizeof(size_t),
+     FMOffset(EvpathSelectionReadRequestMsg, Offset)},
+    {"ElementSize", "integer", sizeof(int),
+     FMOffset(EvpathSelectionReadRequestMsg, ElementSize)},
+    {"DimCount", "integer", sizeof(int),
+     FMOffset(EvpathSelectionReadRequestMsg, DimCount)},
+    {"BlockCount", "integer[DimCount]", sizeof(size_t),
+     FMOffset(EvpathSelectionReadRequestMsg, BlockCount)},
+    {"SelectionStart", "integer[DimCount]", sizeof(size_t),
+     FMOffset(EvpathSelectionReadRequestMsg, SelectionStart)},
+    {"SelectionCount", "integer[DimCount]", sizeof(size_t),
+     FMOffset(EvpathSelectionReadRequestMsg, SelectionCount)},
+    {"WS_Stream", "integer", sizeof(void *),
+     FMOffset(EvpathSelectionReadRequestMsg, WS_Stream)},
+    {"RS_Stream", "integer", sizeof(void *),
+     FMOffset(EvpathSelectionReadRequestMsg, RS_Stream)},
+    {"RequestingRank", "integer", sizeof(int),
+     FMOffset(EvpathSelectionReadRequestMsg, RequestingRank)},
+    {"NotifyCondition", "integer", sizeof(int),
+     FMOffset(EvpathSelectionReadRequestMsg, NotifyCondition)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec EvpathSelectionReadRequestStructs[] = {
+    {"EvpathSelectionReadRequest", EvpathSelectionReadRequestList,
+     sizeof(struct _EvpathSelectionReadRequestMsg), NULL},
+    {NULL, NULL, 0, NULL}};
+
 typedef struct _EvpathReadReplyMsg
 {
     long Timestep;
@@ -315,6 +361,8 @@ static DP_RS_Stream EvpathInitReader(CP_Services Svcs, void *CP_Stream,
      * add a handler for read reply messages
      */
     Stream->ReadRequestFormat = CMregister_format(cm, EvpathReadRequestStructs);
+    Stream->SelectionReadRequestFormat =
+        CMregister_format(cm, EvpathSelectionReadRequestStructs);
     F = CMregister_format(cm, EvpathReadReplyStructs);
     CMregister_handler(F, EvpathReadReplyHandler, Svcs);
 
@@ -378,6 +426,55 @@ static void MarkReadRequest(TimestepList TS, DP_WSR_Stream WSR_Stream_v,
     TS->ReaderRequests = ReqTrk;
 }
 
+/*
+ * writer side routine, called by the network handler thread with the
+ * DataLock held, which may be dropped while connecting
+ */
+static CMConnection GetReplyConn(CManager cm, CMConnection incoming_conn,
+                                 Evpath_WSR_Stream WSR_Stream,
+                                 int RequestingRank)
+{
+    Evpath_WS_Stream WS_Stream = WSR_Stream->WS_Stream;
+    CMConnection ReplyConn = WSR_Stream->ReaderContactInfo[RequestingRank].Conn;
+    if (!ReplyConn)
+    {
+        attr_list List = attr_list_from_string(
+            WSR_Stream->ReaderContactInfo[RequestingRank].ContactString);
+        pthread_mutex_unlock(&WS_Stream->DataLock);
+        ReplyConn = CMget_conn(cm, List);
+        free_attr_list(List);
+        if (!ReplyConn)
+        {
+            /* we failed to connect, maybe he's behind a NAT, reuse
+             * incoming */
+            CMConnection_add_reference(incoming_conn);
+            ReplyConn = incoming_conn;
+        }
+        pthread_mutex_lock(&WS_Stream->DataLock);
+        WSR_Stream->ReaderContactInfo[RequestingRank].Conn = ReplyConn;
+    }
+    return ReplyConn;
+}
+
+static void ReportTimestepNotFound(Evpath_WSR_Stream WSR_Stream,
+                                   long Timestep, int RequestingRank)
+{
+    /*
+     * Shouldn't ever get here because we should never get a request for a
+     * timestep that we don't have.
+     */
+    fprintf(stderr, "\n\n\n\n");
+    fprintf(stderr,
+            "Writer rank %d - Failed to read Timestep %ld, not found.  This is "
+            "an internal inconsistency\n",
+            WSR_Stream->WS_Stream->Rank, Timestep);
+    fprintf(stderr,
+            "Writer rank %d - Request came from rank %d, please report this "
+            "error!\n",
+            WSR_Stream->WS_Stream->Rank, RequestingRank);
+    fprintf(stderr, "\n\n\n\n");
+}
+
 // writer side routine, called by the network handler thread
 static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
                                      void *msg_v, void *client_Data,
@@ -418,25 +515,8 @@ static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
                 WS_Stream->CP_Stream, DPTraceVerbose,
                 "Sending a reply to reader rank %d for remote memory read\n",
                 RequestingRank);
-            ReplyConn = WSR_Stream->ReaderContactInfo[RequestingRank].Conn;
-            if (!ReplyConn)
-            {
-                attr_list List = attr_list_from_string(
-                    WSR_Stream->ReaderContactInfo[RequestingRank]
-                        .ContactString);
-                pthread_mutex_unlock(&WS_Stream->DataLock);
-                ReplyConn = CMget_conn(cm, List);
-                free_attr_list(List);
-                if (!ReplyConn)
-                {
-                    /* we failed to connect, maybe he's behind a NAT, reuse
-                     * incoming */
-                    CMConnection_add_reference(incoming_conn);
-                    ReplyConn = incoming_conn;
-                }
-                pthread_mutex_lock(&WS_Stream->DataLock);
-                WSR_Stream->ReaderContactInfo[RequestingRank].Conn = ReplyConn;
-            }
+            ReplyConn =
+                GetReplyConn(cm, incoming_conn, WSR_Stream, RequestingRank);
             CMFormat Format = WS_Stream->ReadReplyFormat;
             pthread_mutex_unlock(&WS_Stream->DataLock);
             CMwrite(ReplyConn, Format, &ReadReplyMsg);
@@ -447,20 +527,8 @@ static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
         tmp = tmp->Next;
     }
     pthread_mutex_unlock(&WS_Stream->DataLock);
-    /*
-     * Shouldn't ever get here because we should never get a request for a
-     * timestep that we don't have.
-     */
-    fprintf(stderr, "\n\n\n\n");
-    fprintf(stderr,
-            "Writer rank %d - Failed to read Timestep %ld, not found.  This is "
-            "an internal inconsistency\n",
-            WSR_Stream->WS_Stream->Rank, ReadRequestMsg->Timestep);
-    fprintf(stderr,
-            "Writer rank %d - Request came from rank %d, please report this "
-            "error!\n",
-            WSR_Stream->WS_Stream->Rank, RequestingRank);
-    fprintf(stderr, "\n\n\n\n");
+    ReportTimestepNotFound(WSR_Stream, ReadRequestMsg->Timestep,
+                           RequestingRank);
 
     /*
      * in the interest of not failing a writer on a reader failure, don't
@@ -470,6 +538,83 @@ static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
     TAU_STOP_FUNC();
 }
 
+// writer side routine, called by the network handler thread
+static void EvpathSelectionReadRequestHandler(CManager cm,
+                                              CMConnection incoming_conn,
+                                              void *msg_v, void *client_Data,
+                                              attr_list attrs)
+{
+    TAU_START_FUNC();
+    EvpathSelectionReadRequestMsg ReadRequestMsg =
+        (EvpathSelectionReadRequestMsg)msg_v;
+    Evpath_WSR_Stream WSR_Stream = ReadRequestMsg->WS_Stream;
+
+    Evpath_WS_Stream WS_Stream = WSR_Stream->WS_Stream;
+    TimestepList tmp;
+    CP_Services Svcs = (CP_Services)client_Data;
+    int RequestingRank = ReadRequestMsg->RequestingRank;
+    const int DimCount = ReadRequestMsg->DimCount;
+    size_t Length = ReadRequestMsg->ElementSize;
+
+    for (int i = 0; i < DimCount; i++)
+    {
+        Length *= ReadRequestMsg->SelectionCount[i];
+    }
+    Svcs->verbose(WS_Stream->CP_Stream, DPTraceVerbose,
+                  "Got a request to read a %d-dimensional selection of remote "
+                  "memory from reader rank %d: timestep %ld, "
+                  "offset %zu, length %zu\n",
+                  DimCount, RequestingRank, ReadRequestMsg->Timestep,
+                  ReadRequestMsg->Offset, Length);
+    pthread_mutex_lock(&WS_Stream->DataLock);
+    tmp = WS_Stream->Timesteps;
+    while (tmp != NULL)
+    {
+        if (tmp->Timestep == ReadRequestMsg->Timestep)
+        {
+            struct _EvpathReadReplyMsg ReadReplyMsg;
+            CMConnection ReplyConn;
+            char *Packed = malloc(Length ? Length : 1);
+            size_t *BlockStart = calloc(DimCount, sizeof(BlockStart[0]));
+
+            MarkReadRequest(tmp, WSR_Stream, RequestingRank);
+            ExtractSelectionFromPartialRM(
+                ReadRequestMsg->ElementSize, DimCount,
+                ReadRequestMsg->BlockCount, BlockStart,
+                ReadRequestMsg->BlockCount, ReadRequestMsg->SelectionStart,
+                ReadRequestMsg->SelectionCount,
+                tmp->Data.block + ReadRequestMsg->Offset, Packed);
+            free(BlockStart);
+
+            /* memset avoids uninit byte warnings from valgrind */
+            memset(&ReadReplyMsg, 0, sizeof(ReadReplyMsg));
+            ReadReplyMsg.Timestep = ReadRequestMsg->Timestep;
+            ReadReplyMsg.DataLength = Length;
+            ReadReplyMsg.Data = Packed;
+            ReadReplyMsg.RS_Stream = ReadRequestMsg->RS_Stream;
+            ReadReplyMsg.NotifyCondition = ReadRequestMsg->NotifyCondition;
+            Svcs->verbose(WS_Stream->CP_Stream, DPTraceVerbose,
+                          "Sending a reply to reader rank %d for remote "
+                          "memory selection read\n",
+                          RequestingRank);
+            ReplyConn =
+                GetReplyConn(cm, incoming_conn, WSR_Stream, RequestingRank);
+            CMFormat Format = WS_Stream->ReadReplyFormat;
+            pthread_mutex_unlock(&WS_Stream->DataLock);
+            CMwrite(ReplyConn, Format, &ReadReplyMsg);
+            free(Packed);
+
+            TAU_STOP_FUNC();
+            return;
+        }
+        tmp = tmp->Next;
+    }
+    pthread_mutex_unlock(&WS_Stream->DataLock);
+    ReportTimestepNotFound(WSR_Stream, ReadRequestMsg->Timestep,
+                           RequestingRank);
+    TAU_STOP_FUNC();
+}
+
 typedef struct _EvpathCompletionHandle
 {
     int CMcondition;
@@ -481,6 +626,8 @@ typedef struct _EvpathCompletionHandle
     int Rank;
     long Offset;
     long Length;
+    /* packed selection, can't be satisfied from a preloaded block */
+    int Selection;
     struct _EvpathCompletionHandle *Next;
 } * EvpathCompletionHandle;
 
@@ -675,6 +822,11 @@ static void EvpathPreloadHandler(CManager cm, CMConnection conn, void *msg_v,
     {
         int HadPreload;
         EvpathCompletionHandle Next = Requests->Next;
+        if (Requests->Selection)
+        {
+            Requests = Next;
+            continue;
+        }
         HadPreload = HandleRequestWithPreloaded(
             Svcs, RS_Stream, Requests->Rank, PreloadMsg->Timestep,
             Requests->Offset, Requests->Length, Requests->Buffer);
@@ -716,6 +868,8 @@ static DP_WS_Stream EvpathInitWriter(CP_Services Svcs, void *CP_Stream,
      */
     F = CMregister_format(cm, EvpathReadRequestStructs);
     CMregister_handler(F, EvpathReadRequestHandler, Svcs);
+    F = CMregister_format(cm, EvpathSelectionReadRequestStructs);
+    CMregister_handler(F, EvpathSelectionReadRequestHandler, Svcs);
 
     /*
      * Register for sending preload messages
@@ -1011,6 +1165,7 @@ static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     ret->Rank = Rank;
     ret->Offset = Offset;
     ret->Length = Length;
+    ret->Selection = 0;
 
     Stream->TotalReadRequests++;
     if (HadPreload)
@@ -1086,6 +1241,76 @@ static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     return ret;
 }
 
+// reader-side routine, called from the main program
+static void *EvpathReadRemoteMemorySelection(
+    CP_Services Svcs, DP_RS_Stream Stream_v, int Rank, long Timestep,
+    size_t Offset, int ElementSize, int DimCount, const size_t *BlockCount,
+    const size_t *SelectionStart, const size_t *SelectionCount, void *Buffer,
+    void *DP_TimestepInfo)
+{
+    Evpath_RS_Stream Stream = (Evpath_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    CManager cm = Svcs->getCManager(Stream->CP_Stream);
+    struct _EvpathSelectionReadRequestMsg ReadRequestMsg;
+    EvpathCompletionHandle ret;
+    size_t Length = ElementSize;
+
+    /* preloads carry whole data blocks, let the caller read those */
+    if (Stream->CurPreloadMode != SstPreloadNone)
+    {
+        return NULL;
+    }
+
+    for (int i = 0; i < DimCount; i++)
+    {
+        Length *= SelectionCount[i];
+    }
+    ret = malloc(sizeof(struct _EvpathCompletionHandle));
+    ret->CPStream = Stream->CP_Stream;
+    ret->DPStream = Stream;
+    ret->Failed = 0;
+    ret->cm = cm;
+    ret->Buffer = Buffer;
+    ret->Rank = Rank;
+    ret->Offset = Offset;
+    ret->Length = Length;
+    ret->Selection = 1;
+
+    pthread_mutex_lock(&Stream->DataLock);
+    Stream->TotalReadRequests++;
+    ret->CMcondition = CMCondition_get(cm, NULL);
+    AddRequestToList(Svcs, Stream, ret);
+    CMCondition_set_client_data(cm, ret->CMcondition, ret);
+    pthread_mutex_unlock(&Stream->DataLock);
+
+    Svcs->verbose(Stream->CP_Stream, DPTraceVerbose,
+                  "Adios requesting to read a %d-dimensional selection of "
+                  "remote memory for Timestep %ld from Rank %d, length %zu\n",
+                  DimCount, Timestep, Rank, Length);
+
+    /* memset avoids uninit byte warnings from valgrind */
+    memset(&ReadRequestMsg, 0, sizeof(ReadRequestMsg));
+    ReadRequestMsg.Timestep = Timestep;
+    ReadRequestMsg.Offset = Offset;
+    ReadRequestMsg.ElementSize = ElementSize;
+    ReadRequestMsg.DimCount = DimCount;
+    ReadRequestMsg.BlockCount = (size_t *)BlockCount;
+    ReadRequestMsg.SelectionStart = (size_t *)SelectionStart;
+    ReadRequestMsg.SelectionCount = (size_t *)SelectionCount;
+    ReadRequestMsg.WS_Stream = Stream->WriterContactInfo[Rank].WS_Stream;
+    ReadRequestMsg.RS_Stream = Stream;
+    ReadRequestMsg.RequestingRank = Stream->Rank;
+    ReadRequestMsg.NotifyCondition = ret->CMcondition;
+    if (!Svcs->sendToPeer(Stream->CP_Stream, Stream->PeerCohort, Rank,
+                          Stream->SelectionReadRequestFormat, &ReadRequestMsg))
+    {
+        ret->Failed = 1;
+        CMCondition_signal(cm, ret->CMcondition);
+    }
+
+    return ret;
+}
+
 // reader-side routine, called from the main program
 static int EvpathWaitForCompletion(CP_Services Svcs, void *Handle_v)
 {
@@ -1538,6 +1763,8 @@ extern NO_SANITIZE_THREAD CP_DP_Interface LoadEVpathDP()
     evpathDPInterface.provideWriterDataToReader =
         EvpathProvideWriterDataToReader;
     evpathDPInterface.readRemoteMemory = EvpathReadRemoteMemory;
+    evpathDPInterface.readRemoteMemorySelection =
+        EvpathReadRemoteMemorySelection;
     evpathDPInterface.waitForCompletion = EvpathWaitForCompletion;
     evpathDPInterface.notifyConnFailure = EvpathNotifyConnFailure;
     evpathDPInterface.provideTimestep = EvpathProvideTimestep;
@@ -0,0 +1,819 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atl.h>
+#include <evpath.h>
+
+#include "sst_data.h"
+
+#include "adios2/toolkit/profiling/taustubs/taustubs.h"
+#include "dp_interface.h"
+
+/*
+ *  The "shm" data plane moves timestep data between a writer and the
+ *  readers running on the same host through POSIX shared memory.
+ *
+ *  It is layered on top of the "evpath" data plane, which it uses for
+ *  everything but the data itself:  contact information, timestep
+ *  registration and release messages all go through evpath unchanged, so
+ *  the two data planes interoperate, and any read that cannot be served
+ *  from shared memory (peer on another host, timestep not placed in a
+ *  slot) falls back to an evpath read request.
+ *
+ *  Each writer rank creates a control segment, "/adios2-sst-<token>-<rank>",
+ *  holding a ring of timestep slots.  A slot owns a data segment,
+ *  "/adios2-sst-<token>-<rank>-<slot>-<generation>", that is recreated
+ *  with a new generation when a timestep does not fit.  Readers on the same
+ *  host map the control segments at connection time and count themselves
+ *  in ReaderCount, timesteps are copied into a slot only if that count is
+ *  non-zero.
+ *
+ *  Slots change state without locks:  the writer claims a free slot with a
+ *  compare-and-swap, fills it and publishes it with a release store of
+ *  SlotReady.  The control plane releases a timestep only after every reader
+ *  is done with it, so a reader that finds its timestep in a ready slot can
+ *  copy from it without further synchronization.
+ *
+ *  While the control plane has a preload mode active, evpath pushes the data
+ *  to the reader (and, for learned preloads, learns the read pattern from
+ *  the reader's requests), so the reader then leaves all reads to evpath.
+ */
+
+#define SHM_MAGIC 0x4144494f53325348UL
+#define SHM_HOSTNAME_LEN 256
+#define SHM_DEFAULT_SLOTS 8
+
+/* chosen over evpath, and over rdma unless its provider was requested */
+#define SHM_ONE_HOST_PRIORITY 50
+
+extern CP_DP_Interface LoadEVpathDP();
+
+enum
+{
+    SlotFree = 0,
+    SlotFilling,
+    SlotReady
+};
+
+typedef struct _ShmSlot
+{
+    int State; /* accessed atomically */
+    long Timestep;
+    size_t DataSize;
+    size_t Capacity;
+    unsigned long Generation;
+} ShmSlot;
+
+typedef struct _ShmHeader
+{
+    uint64_t Magic;
+    uint64_t Token;
+    char Hostname[SHM_HOSTNAME_LEN];
+    int SlotCount;
+    int ReaderCount; /* accessed atomically */
+    ShmSlot Slots[];
+} ShmHeader;
+
+typedef struct _ShmSegments
+{
+    ShmHeader *Header;
+    size_t HeaderSize;
+    /* per slot mapping of the data segment */
+    char **Data;
+    size_t *Size;
+    unsigned long *Generation;
+} ShmSegments;
+
+typedef struct _Shm_RS_Stream
+{
+    DP_RS_Stream Evpath;
+    void *CP_Stream;
+    uint64_t Token;
+    int WriterCohortSize;
+    ShmSegments *Writers; /* NULL if the writer has no shared memory */
+    SstStats Stats;
+    int CurPreloadMode; /* accessed atomically */
+} * Shm_RS_Stream;
+
+typedef struct _Shm_WS_Stream
+{
+    DP_WS_Stream Evpath;
+    void *CP_Stream;
+    int Rank;
+    uint64_t Token;
+    ShmSegments Segments;
+    int NextSlot;
+} * Shm_WS_Stream;
+
+typedef struct _ShmCompletionHandle
+{
+    /* NULL if served from shared memory */
+    DP_CompletionHandle Evpath;
+} * ShmCompletionHandle;
+
+static CP_DP_Interface EvpathDP = NULL;
+
+static void ShmHeaderName(char *Name, size_t Len, uint64_t Token, int Rank)
+{
+    snprintf(Name, Len, "/adios2-sst-%016llx-%d", (unsigned long long)Token,
+             Rank);
+}
+
+static void ShmDataName(char *Name, size_t Len, uint64_t Token, int Rank,
+                        int Slot, unsigned long Generation)
+{
+    snprintf(Name, Len, "/adios2-sst-%016llx-%d-%d-%lu",
+             (unsigned long long)Token, Rank, Slot, Generation);
+}
+
+/*
+ * Collective over the stream's communicator.  Fills Hostname (if not NULL)
+ * and returns true if all ranks run on the same host.
+ */
+static int ShmAllOnOneHost(CP_Services Svcs, void *CP_Stream, char *Hostname)
+{
+    SMPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+    char MyHostname[SHM_HOSTNAME_LEN];
+    char *AllHostnames;
+    int Size, Ret = 1;
+
+    memset(MyHostname, 0, sizeof(MyHostname));
+    gethostname(MyHostname, sizeof(MyHostname) - 1);
+    if (Hostname)
+        memcpy(Hostname, MyHostname, sizeof(MyHostname));
+
+    SMPI_Comm_size(comm, &Size);
+    AllHostnames = malloc(Size * SHM_HOSTNAME_LEN);
+    SMPI_Allgather(MyHostname, SHM_HOSTNAME_LEN, SMPI_CHAR, AllHostnames,
+                   SHM_HOSTNAME_LEN, SMPI_CHAR, comm);
+    for (int i = 0; i < Size; i++)
+    {
+        if (strncmp(MyHostname, &AllHostnames[i * SHM_HOSTNAME_LEN],
+                    SHM_HOSTNAME_LEN) != 0)
+        {
+            Ret = 0;
+            break;
+        }
+    }
+    free(AllHostnames);
+    return Ret;
+}
+
+/* maps size bytes of the named segment, NULL on failure */
+static void *ShmMap(const char *Name, size_t Size, int Create)
+{
+    int fd;
+    void *Addr;
+
+    if (Create)
+    {
+        fd = shm_open(Name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    }
+    else
+    {
+        fd = shm_open(Name, O_RDWR, 0);
+    }
+    if (fd == -1)
+    {
+        return NULL;
+    }
+
+    /* reserve the pages now, a full /dev/shm would SIGBUS later */
+    if (Create && (posix_fallocate(fd, 0, Size) != 0))
+    {
+        close(fd);
+        shm_unlink(Name);
+        return NULL;
+    }
+
+    Addr = mmap(NULL, Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (Addr == MAP_FAILED)
+    {
+        if (Create)
+            shm_unlink(Name);
+        return NULL;
+    }
+    return Addr;
+}
+
+static void ShmAllocSlots(ShmSegments *Segments, int SlotCount)
+{
+    Segments->Data = calloc(SlotCount, sizeof(Segments->Data[0]));
+    Segments->Size = calloc(SlotCount, sizeof(Segments->Size[0]));
+    Segments->Generation = calloc(SlotCount, sizeof(Segments->Generation[0]));
+}
+
+static void ShmUnmapSlots(ShmSegments *Segments)
+{
+    if (!Segments->Header)
+        return;
+
+    for (int i = 0; i < Segments->Header->SlotCount; i++)
+    {
+        if (Segments->Data[i])
+            munmap(Segments->Data[i], Segments->Size[i]);
+    }
+    free(Segments->Data);
+    free(Segments->Size);
+    free(Segments->Generation);
+    munmap(Segments->Header, Segments->HeaderSize);
+    Segments->Header = NULL;
+}
+
+// reader-side routine, called from the main program
+static DP_RS_Stream ShmInitReader(CP_Services Svcs, void *CP_Stream,
+                                  void **ReaderContactInfoPtr,
+                                  struct _SstParams *Params,
+                                  attr_list WriterContactAttributes,
+                                  SstStats Stats)
+{
+    Shm_RS_Stream Stream = malloc(sizeof(struct _Shm_RS_Stream));
+    char Hostname[SHM_HOSTNAME_LEN];
+    char *WriterToken = NULL, *WriterHostname = NULL;
+    int WriterOneHost = 0;
+
+    memset(Stream, 0, sizeof(struct _Shm_RS_Stream));
+    Stream->CP_Stream = CP_Stream;
+    Stream->Stats = Stats;
+    Stream->Evpath =
+        EvpathDP->initReader(Svcs, CP_Stream, ReaderContactInfoPtr, Params,
+                             WriterContactAttributes, Stats);
+
+    const int OneHost = ShmAllOnOneHost(Svcs, CP_Stream, Hostname);
+
+    if (!get_string_attr(WriterContactAttributes,
+                         attr_atom_from_string("SHM_DP_TOKEN"), &WriterToken))
+    {
+        Svcs->verbose(CP_Stream, DPPerStepVerbose,
+                      "Writer has no shared memory, SHM dataplane reads "
+                      "through EVPath\n");
+        return Stream;
+    }
+    Stream->Token = strtoull(WriterToken, NULL, 16);
+
+    get_string_attr(WriterContactAttributes,
+                    attr_atom_from_string("SHM_DP_HOSTNAME"), &WriterHostname);
+    get_int_attr(WriterContactAttributes,
+                 attr_atom_from_string("SHM_DP_ONE_HOST"), &WriterOneHost);
+
+    /*
+     * Speculative preload would push every timestep through the network
+     * anyway, don't choose it when all the data is in shared memory
+     */
+    if (OneHost && WriterOneHost && WriterHostname &&
+        (strcmp(WriterHostname, Hostname) == 0) &&
+        (Params->SpeculativePreloadMode == SpecPreloadAuto))
+    {
+        Svcs->verbose(CP_Stream, DPPerStepVerbose,
+                      "Writer and reader cohorts share host %s, disabling "
+                      "automatic speculative preload\n",
+                      Hostname);
+        Params->SpeculativePreloadMode = SpecPreloadOff;
+    }
+    return Stream;
+}
+
+// reader-side routine, called from the main program
+static void ShmProvideWriterDataToReader(CP_Services Svcs,
+                                         DP_RS_Stream RS_Stream_v,
+                                         int WriterCohortSize,
+                                         CP_PeerCohort PeerCohort,
+                                         void **ProvidedWriterInfo)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)RS_Stream_v;
+    char Hostname[SHM_HOSTNAME_LEN];
+    int Attached = 0;
+
+    EvpathDP->provideWriterDataToReader(Svcs, Stream->Evpath, WriterCohortSize,
+                                        PeerCohort, ProvidedWriterInfo);
+    if (!Stream->Token)
+        return;
+
+    memset(Hostname, 0, sizeof(Hostname));
+    gethostname(Hostname, sizeof(Hostname) - 1);
+
+    Stream->WriterCohortSize = WriterCohortSize;
+    Stream->Writers = calloc(WriterCohortSize, sizeof(Stream->Writers[0]));
+    for (int i = 0; i < WriterCohortSize; i++)
+    {
+        ShmSegments *Writer = &Stream->Writers[i];
+        char Name[64];
+        struct stat Stat;
+        int fd;
+
+        /* segments only exist on the writer's host */
+        ShmHeaderName(Name, sizeof(Name), Stream->Token, i);
+        fd = shm_open(Name, O_RDWR, 0);
+        if (fd == -1)
+            continue;
+        if (fstat(fd, &Stat) != 0 || (size_t)Stat.st_size < sizeof(ShmHeader))
+        {
+            close(fd);
+            continue;
+        }
+        close(fd);
+
+        ShmHeader *Header = ShmMap(Name, Stat.st_size, 0);
+        if (!Header)
+            continue;
+        if ((Header->Magic != SHM_MAGIC) || (Header->Token != Stream->Token) ||
+            (strncmp(Header->Hostname, Hostname, SHM_HOSTNAME_LEN) != 0))
+        {
+            munmap(Header, Stat.st_size);
+            continue;
+        }
+
+        Writer->Header = Header;
+        Writer->HeaderSize = Stat.st_size;
+        ShmAllocSlots(Writer, Header->SlotCount);
+        __atomic_add_fetch(&Header->ReaderCount, 1, __ATOMIC_ACQ_REL);
+        Attached++;
+    }
+    Svcs->verbose(Stream->CP_Stream, DPPerRankVerbose,
+                  "SHM dataplane attached to %d of %d writer ranks\n", Attached,
+                  WriterCohortSize);
+}
+
+// reader-side routine, called from the main program
+static void ShmDestroyReader(CP_Services Svcs, DP_RS_Stream RS_Stream_v)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)RS_Stream_v;
+    for (int i = 0; i < Stream->WriterCohortSize; i++)
+    {
+        ShmSegments *Writer = &Stream->Writers[i];
+        if (Writer->Header)
+        {
+            __atomic_sub_fetch(&Writer->Header->ReaderCount, 1,
+                               __ATOMIC_ACQ_REL);
+            ShmUnmapSlots(Writer);
+        }
+    }
+    free(Stream->Writers);
+    EvpathDP->destroyReader(Svcs, Stream->Evpath);
+    free(Stream);
+}
+
+/*
+ * returns the mapped data of the writer rank's timestep if it is in a slot
+ * and holds Length bytes at Offset, NULL otherwise
+ */
+static char *ShmFindLocal(Shm_RS_Stream Stream, int Rank, long Timestep,
+                          size_t Offset, size_t Length, int *SlotIndex)
+{
+    if (!Stream->Writers || (Rank >= Stream->WriterCohortSize))
+        return NULL;
+
+    if (__atomic_load_n(&Stream->CurPreloadMode, __ATOMIC_ACQUIRE) !=
+        SstPreloadNone)
+        return NULL;
+
+    ShmSegments *Writer = &Stream->Writers[Rank];
+    if (!Writer->Header)
+        return NULL;
+
+    for (int i = 0; i < Writer->Header->SlotCount; i++)
+    {
+        ShmSlot *Slot = &Writer->Header->Slots[i];
+        if ((__atomic_load_n(&Slot->State, __ATOMIC_ACQUIRE) != SlotReady) ||
+            (Slot->Timestep != Timestep))
+        {
+            continue;
+        }
+        if ((Offset + Length > Slot->DataSize) || (Slot->DataSize == 0))
+        {
+            return NULL;
+        }
+
+        if (Writer->Generation[i] != Slot->Generation)
+        {
+            char Name[80];
+            if (Writer->Data[i])
+            {
+                munmap(Writer->Data[i], Writer->Size[i]);
+                Writer->Data[i] = NULL;
+            }
+            ShmDataName(Name, sizeof(Name), Stream->Token, Rank, i,
+                        Slot->Generation);
+            Writer->Data[i] = ShmMap(Name, Slot->Capacity, 0);
+            if (!Writer->Data[i])
+            {
+                Writer->Generation[i] = 0;
+                return NULL;
+            }
+            Writer->Size[i] = Slot->Capacity;
+            Writer->Generation[i] = Slot->Generation;
+        }
+        *SlotIndex = i;
+        return Writer->Data[i];
+    }
+    return NULL;
+}
+
+/* returns true if the read was served from shared memory */
+static int ShmReadLocal(CP_Services Svcs, Shm_RS_Stream Stream, int Rank,
+                        long Timestep, size_t Offset, size_t Length,
+                        void *Buffer)
+{
+    int Slot;
+    char *Data = ShmFindLocal(Stream, Rank, Timestep, Offset, Length, &Slot);
+    if (!Data)
+        return 0;
+
+    memcpy(Buffer, Data + Offset, Length);
+    Stream->Stats->DataBytesReceived += Length;
+    Svcs->verbose(Stream->CP_Stream, DPTraceVerbose,
+                  "Satisfying remote memory read from shared memory slot "
+                  "%d of writer rank %d for timestep %ld\n",
+                  Slot, Rank, Timestep);
+    return 1;
+}
+
+// reader-side routine, called from the main program
+static DP_CompletionHandle ShmReadRemoteMemory(CP_Services Svcs,
+                                               DP_RS_Stream RS_Stream_v,
+                                               int Rank, long Timestep,
+                                               size_t Offset, size_t Length,
+                                               void *Buffer,
+                                               void *DP_TimestepInfo)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)RS_Stream_v;
+    ShmCompletionHandle Handle = malloc(sizeof(struct _ShmCompletionHandle));
+
+    Handle->Evpath = NULL;
+    if (!ShmReadLocal(Svcs, Stream, Rank, Timestep, Offset, Length, Buffer))
+    {
+        Handle->Evpath = EvpathDP->readRemoteMemory(
+            Svcs, Stream->Evpath, Rank, Timestep, Offset, Length, Buffer,
+            DP_TimestepInfo);
+    }
+    return Handle;
+}
+
+// reader-side routine, called from the main program
+static DP_CompletionHandle ShmReadRemoteMemorySelection(
+    CP_Services Svcs, DP_RS_Stream RS_Stream_v, int Rank, long Timestep,
+    size_t Offset, int ElementSize, int DimCount, const size_t *BlockCount,
+    const size_t *SelectionStart, const size_t *SelectionCount, void *Buffer,
+    void *DP_TimestepInfo)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)RS_Stream_v;
+    size_t BlockLength = ElementSize;
+    size_t Length = ElementSize;
+    char *Data;
+    int Slot;
+
+    for (int i = 0; i < DimCount; i++)
+    {
+        BlockLength *= BlockCount[i];
+        Length *= SelectionCount[i];
+    }
+
+    Data = ShmFindLocal(Stream, Rank, Timestep, Offset, BlockLength, &Slot);
+    if (Data)
+    {
+        ShmCompletionHandle Handle =
+            malloc(sizeof(struct _ShmCompletionHandle));
+        size_t *BlockStart = calloc(DimCount, sizeof(BlockStart[0]));
+        ExtractSelectionFromPartialRM(ElementSize, DimCount, BlockCount,
+                                      BlockStart, BlockCount, SelectionStart,
+                                      SelectionCount, Data + Offset, Buffer);
+        free(BlockStart);
+        Stream->Stats->DataBytesReceived += Length;
+        Svcs->verbose(Stream->CP_Stream, DPTraceVerbose,
+                      "Satisfying remote memory selection read from shared "
+                      "memory slot %d of writer rank %d for timestep %ld\n",
+                      Slot, Rank, Timestep);
+        Handle->Evpath = NULL;
+        return Handle;
+    }
+
+    DP_CompletionHandle Evpath = EvpathDP->readRemoteMemorySelection(
+        Svcs, Stream->Evpath, Rank, Timestep, Offset, ElementSize, DimCount,
+        BlockCount, SelectionStart, SelectionCount, Buffer, DP_TimestepInfo);
+    if (!Evpath)
+        return NULL;
+
+    ShmCompletionHandle Handle = malloc(sizeof(struct _ShmCompletionHandle));
+    Handle->Evpath = Evpath;
+    return Handle;
+}
+
+// reader-side routine, called from the main program
+static int ShmWaitForCompletion(CP_Services Svcs, void *Handle_v)
+{
+    ShmCompletionHandle Handle = (ShmCompletionHandle)Handle_v;
+    int Ret = 1;
+    if (Handle->Evpath)
+    {
+        Ret = EvpathDP->waitForCompletion(Svcs, Handle->Evpath);
+    }
+    free(Handle);
+    return Ret;
+}
+
+// reader-side routine, called from the network handler thread
+static void ShmNotifyConnFailure(CP_Services Svcs, DP_RS_Stream RS_Stream_v,
+                                 int FailedPeerRank)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)RS_Stream_v;
+    EvpathDP->notifyConnFailure(Svcs, Stream->Evpath, FailedPeerRank);
+}
+
+// reader-side routine, called from the network handler thread
+static void ShmRSTimestepArrived(CP_Services Svcs, DP_RS_Stream RS_Stream_v,
+                                 long Timestep, SstPreloadModeType PreloadMode)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)RS_Stream_v;
+    EvpathDP->timestepArrived(Svcs, Stream->Evpath, Timestep, PreloadMode);
+    __atomic_store_n(&Stream->CurPreloadMode, (int)PreloadMode,
+                     __ATOMIC_RELEASE);
+}
+
+// writer-side routine, called from the main program
+static DP_WS_Stream ShmInitWriter(CP_Services Svcs, void *CP_Stream,
+                                  struct _SstParams *Params, attr_list DPAttrs,
+                                  SstStats Stats)
+{
+    Shm_WS_Stream Stream = malloc(sizeof(struct _Shm_WS_Stream));
+    SMPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+    char Hostname[SHM_HOSTNAME_LEN];
+    char Name[64];
+
+    memset(Stream, 0, sizeof(struct _Shm_WS_Stream));
+    Stream->CP_Stream = CP_Stream;
+    Stream->Evpath =
+        EvpathDP->initWriter(Svcs, CP_Stream, Params, DPAttrs, Stats);
+
+    SMPI_Comm_rank(comm, &Stream->Rank);
+    const int OneHost = ShmAllOnOneHost(Svcs, CP_Stream, Hostname);
+
+    if (Stream->Rank == 0)
+    {
+        struct timeval Now;
+        gettimeofday(&Now, NULL);
+        Stream->Token = ((uint64_t)getpid() << 40) ^
+                        ((uint64_t)Now.tv_sec << 20) ^ (uint64_t)Now.tv_usec ^
+                        (uint64_t)(uintptr_t)Stream;
+    }
+    SMPI_Bcast(&Stream->Token, sizeof(Stream->Token), SMPI_BYTE, 0, comm);
+
+    const int SlotCount =
+        Params->QueueLimit > 0
+            ? Params->QueueLimit + Params->ReserveQueueLimit + 1
+            : SHM_DEFAULT_SLOTS;
+    const size_t HeaderSize =
+        sizeof(ShmHeader) + SlotCount * sizeof(ShmSlot);
+
+    ShmHeaderName(Name, sizeof(Name), Stream->Token, Stream->Rank);
+    ShmHeader *Header = ShmMap(Name, HeaderSize, 1);
+    if (!Header)
+    {
+        Svcs->verbose(CP_Stream, DPCriticalVerbose,
+                      "Failed to create shared memory segment %s (%s), SHM "
+                      "dataplane falls back to EVPath\n",
+                      Name, strerror(errno));
+    }
+    else
+    {
+        memset(Header, 0, HeaderSize);
+        Header->Magic = SHM_MAGIC;
+        Header->Token = Stream->Token;
+        memcpy(Header->Hostname, Hostname, SHM_HOSTNAME_LEN);
+        Header->SlotCount = SlotCount;
+        Stream->Segments.Header = Header;
+        Stream->Segments.HeaderSize = HeaderSize;
+        ShmAllocSlots(&Stream->Segments, SlotCount);
+    }
+
+    if (Stream->Rank == 0)
+    {
+        char Token[17];
+        snprintf(Token, sizeof(Token), "%016llx",
+                 (unsigned long long)Stream->Token);
+        set_string_attr(DPAttrs, attr_atom_from_string("SHM_DP_TOKEN"),
+                        strdup(Token));
+        set_string_attr(DPAttrs, attr_atom_from_string("SHM_DP_HOSTNAME"),
+                        strdup(Hostname));
+        set_int_attr(DPAttrs, attr_atom_from_string("SHM_DP_ONE_HOST"),
+                     OneHost);
+    }
+    return Stream;
+}
+
+// writer-side routine, called from the main program
+static void ShmDestroyWriter(CP_Services Svcs, DP_WS_Stream WS_Stream_v)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)WS_Stream_v;
+    ShmHeader *Header = Stream->Segments.Header;
+    if (Header)
+    {
+        char Name[80];
+        for (int i = 0; i < Header->SlotCount; i++)
+        {
+            if (Header->Slots[i].Generation)
+            {
+                ShmDataName(Name, sizeof(Name), Stream->Token, Stream->Rank,
+                            i, Header->Slots[i].Generation);
+                shm_unlink(Name);
+            }
+        }
+        ShmUnmapSlots(&Stream->Segments);
+        ShmHeaderName(Name, sizeof(Name), Stream->Token, Stream->Rank);
+        shm_unlink(Name);
+    }
+    EvpathDP->destroyWriter(Svcs, Stream->Evpath);
+    free(Stream);
+}
+
+// writer-side routine, called from the network handler thread
+static DP_WSR_Stream ShmInitWriterPerReader(CP_Services Svcs,
+                                            DP_WS_Stream WS_Stream_v,
+                                            int ReaderCohortSize,
+                                            CP_PeerCohort PeerCohort,
+                                            void **ProvidedReaderInfo_v,
+                                            void **WriterContactInfoPtr)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)WS_Stream_v;
+    /* per-reader state is evpath's, all later calls go to it directly */
+    return EvpathDP->initWriterPerReader(Svcs, Stream->Evpath,
+                                         ReaderCohortSize, PeerCohort,
+                                         ProvidedReaderInfo_v,
+                                         WriterContactInfoPtr);
+}
+
+/* grows slot's data segment to hold Size bytes, returns false on failure */
+static int ShmReserveSlot(CP_Services Svcs, Shm_WS_Stream Stream, int Slot,
+                          size_t Size)
+{
+    ShmSlot *SlotInfo = &Stream->Segments.Header->Slots[Slot];
+    const unsigned long Generation = SlotInfo->Generation + 1;
+    const long PageSize = sysconf(_SC_PAGESIZE);
+    /* some headroom for steps of slowly growing size */
+    size_t Capacity = Size + Size / 8;
+    Capacity = (Capacity + PageSize - 1) / PageSize * PageSize;
+    char Name[80];
+
+    ShmDataName(Name, sizeof(Name), Stream->Token, Stream->Rank, Slot,
+                Generation);
+    char *Data = ShmMap(Name, Capacity, 1);
+    if (!Data)
+    {
+        Svcs->verbose(Stream->CP_Stream, DPPerRankVerbose,
+                      "Failed to create shared memory segment %s of %zu "
+                      "bytes (%s)\n",
+                      Name, Capacity, strerror(errno));
+        return 0;
+    }
+
+    /* readers map the new generation when they find it in the slot */
+    if (Stream->Segments.Data[Slot])
+    {
+        munmap(Stream->Segments.Data[Slot], Stream->Segments.Size[Slot]);
+        ShmDataName(Name, sizeof(Name), Stream->Token, Stream->Rank, Slot,
+                    SlotInfo->Generation);
+        shm_unlink(Name);
+    }
+    Stream->Segments.Data[Slot] = Data;
+    Stream->Segments.Size[Slot] = Capacity;
+    Stream->Segments.Generation[Slot] = Generation;
+    SlotInfo->Capacity = Capacity;
+    SlotInfo->Generation = Generation;
+    return 1;
+}
+
+// writer-side routine, called from the main program
+static void ShmProvideTimestep(CP_Services Svcs, DP_WS_Stream WS_Stream_v,
+                               struct _SstData *Data,
+                               struct _SstData *LocalMetadata, long Timestep,
+                               void **TimestepInfoPtr)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)WS_Stream_v;
+    ShmHeader *Header = Stream->Segments.Header;
+
+    EvpathDP->provideTimestep(Svcs, Stream->Evpath, Data, LocalMetadata,
+                              Timestep, TimestepInfoPtr);
+
+    if (!Header ||
+        (__atomic_load_n(&Header->ReaderCount, __ATOMIC_ACQUIRE) == 0))
+    {
+        return;
+    }
+
+    for (int i = 0; i < Header->SlotCount; i++)
+    {
+        const int Slot = (Stream->NextSlot + i) % Header->SlotCount;
+        ShmSlot *SlotInfo = &Header->Slots[Slot];
+        int Expected = SlotFree;
+        if (!__atomic_compare_exchange_n(&SlotInfo->State, &Expected,
+                                         SlotFilling, 0, __ATOMIC_ACQ_REL,
+                                         __ATOMIC_ACQUIRE))
+        {
+            continue;
+        }
+
+        if ((SlotInfo->Capacity < Data->DataSize) &&
+            !ShmReserveSlot(Svcs, Stream, Slot, Data->DataSize))
+        {
+            __atomic_store_n(&SlotInfo->State, SlotFree, __ATOMIC_RELEASE);
+            return;
+        }
+
+        if (Data->DataSize)
+        {
+            memcpy(Stream->Segments.Data[Slot], Data->block, Data->DataSize);
+        }
+        SlotInfo->Timestep = Timestep;
+        SlotInfo->DataSize = Data->DataSize;
+        __atomic_store_n(&SlotInfo->State, SlotReady, __ATOMIC_RELEASE);
+        Stream->NextSlot = (Slot + 1) % Header->SlotCount;
+        Svcs->verbose(Stream->CP_Stream, DPTraceVerbose,
+                      "Placed timestep %ld in shared memory slot %d\n",
+                      Timestep, Slot);
+        return;
+    }
+    Svcs->verbose(Stream->CP_Stream, DPPerRankVerbose,
+                  "No free shared memory slot for timestep %ld, readers "
+                  "fall back to EVPath\n",
+                  Timestep);
+}
+
+// writer-side routine, called from the network handler thread
+static void ShmReleaseTimestep(CP_Services Svcs, DP_WS_Stream WS_Stream_v,
+                               long Timestep)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)WS_Stream_v;
+    ShmHeader *Header = Stream->Segments.Header;
+
+    EvpathDP->releaseTimestep(Svcs, Stream->Evpath, Timestep);
+
+    if (!Header)
+        return;
+
+    for (int i = 0; i < Header->SlotCount; i++)
+    {
+        ShmSlot *SlotInfo = &Header->Slots[i];
+        if ((__atomic_load_n(&SlotInfo->State, __ATOMIC_ACQUIRE) ==
+             SlotReady) &&
+            (SlotInfo->Timestep == Timestep))
+        {
+            __atomic_store_n(&SlotInfo->State, SlotFree, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+static int ShmGetPriority(CP_Services Svcs, void *CP_Stream,
+                          struct _SstParams *Params)
+{
+    if (ShmAllOnOneHost(Svcs, CP_Stream, NULL))
+    {
+        Svcs->verbose(CP_Stream, DPPerStepVerbose,
+                      "SHM dataplane: all ranks on one host, returning "
+                      "priority %d\n",
+                      SHM_ONE_HOST_PRIORITY);
+        return SHM_ONE_HOST_PRIORITY;
+    }
+    /* usable if requested, peers on other hosts go through evpath */
+    return 0;
+}
+
+static struct _CP_DP_Interface shmDPInterface;
+
+extern CP_DP_Interface LoadShmDP()
+{
+    EvpathDP = LoadEVpathDP();
+
+    /* same contact information as evpath, so either side may use evpath */
+    shmDPInterface.ReaderContactFormats = EvpathDP->ReaderContactFormats;
+    shmDPInterface.WriterContactFormats = EvpathDP->WriterContactFormats;
+    shmDPInterface.TimestepInfoFormats = EvpathDP->TimestepInfoFormats;
+    shmDPInterface.initReader = ShmInitReader;
+    shmDPInterface.initWriter = ShmInitWriter;
+    shmDPInterface.initWriterPerReader = ShmInitWriterPerReader;
+    shmDPInterface.provideWriterDataToReader = ShmProvideWriterDataToReader;
+    shmDPInterface.readRemoteMemory = ShmReadRemoteMemory;
+    shmDPInterface.readRemoteMemorySelection = ShmReadRemoteMemorySelection;
+    shmDPInterface.waitForCompletion = ShmWaitForCompletion;
+    shmDPInterface.notifyConnFailure = ShmNotifyConnFailure;
+    shmDPInterface.provideTimestep = ShmProvideTimestep;
+    shmDPInterface.releaseTimestep = ShmReleaseTimestep;
+    shmDPInterface.readerRegisterTimestep = EvpathDP->readerRegisterTimestep;
+    shmDPInterface.readerReleaseTimestep = EvpathDP->readerReleaseTimestep;
+    shmDPInterface.WSRreadPatternLocked = NULL;
+    shmDPInterface.RSreadPatternLocked = NULL;
+    shmDPInterface.timestepArrived = ShmRSTimestepArrived;
+    shmDPInterface.destroyReader = ShmDestroyReader;
+    shmDPInterface.destroyWriter = ShmDestroyWriter;
+    shmDPInterface.destroyWriterPerReader = EvpathDP->destroyWriterPerReader;
+    shmDPInterface.getPriority = ShmGetPriority;
+    shmDPInterface.unGetPriority = NULL;
+    return &shmDPInterface;
+}
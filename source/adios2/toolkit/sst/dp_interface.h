@@ -185,6 +185,25 @@ typedef DP_CompletionHandle (*CP_DP_ReadRemoteMemoryFunc)(
     CP_Services Svcs, DP_RS_Stream RS_Stream, int Rank, long Timestep,
     size_t Offset, size_t Length, void *Buffer, void *DP_TimestepInfo);
 
+/*!
+ * CP_DP_ReadRemoteMemorySelectionFunc is the type of an optional dataplane
+ * function that reads a hyperslab of an array stored in the data block of
+ * writer `rank` for `timestep`.  The array starts at `Offset` in the data
+ * block and is a row-major block of `BlockCount` elements of `ElementSize`
+ * bytes in each of `DimCount` dimensions.  The writer side extracts the
+ * elements in the box given by `SelectionStart` and `SelectionCount`
+ * (relative to the block), and only those are transferred, packed in
+ * row-major order into `Buffer`.  The function may return NULL if it cannot
+ * satisfy the request now (for example while data is being preloaded), in
+ * which case the caller reads the data block with CP_DP_ReadRemoteMemory.
+ * The returned handle is waited on with CP_DP_WaitForCompletion.
+ */
+typedef DP_CompletionHandle (*CP_DP_ReadRemoteMemorySelectionFunc)(
+    CP_Services Svcs, DP_RS_Stream RS_Stream, int Rank, long Timestep,
+    size_t Offset, int ElementSize, int DimCount, const size_t *BlockCount,
+    const size_t *SelectionStart, const size_t *SelectionCount, void *Buffer,
+    void *DP_TimestepInfo);
+
 /*!
  * CP_DP_WaitForCompletionFunc is the type of a dataplane function that
  * suspends the execution of the current thread until the asynchronous
@@ -349,6 +368,8 @@ struct _CP_DP_Interface
         provideWriterDataToReader; // reader-side call, after writer contact
 
     CP_DP_ReadRemoteMemoryFunc readRemoteMemory;   // reader-side call
+    CP_DP_ReadRemoteMemorySelectionFunc
+        readRemoteMemorySelection; // reader-side call, may be NULL
     CP_DP_WaitForCompletionFunc waitForCompletion; // reader-side call
     CP_DP_NotifyConnFailureFunc
         notifyConnFailure; // only called on reader-side, for terminating
@@ -384,6 +405,20 @@ struct _CP_DP_Interface
         getPriority; // both sides, part of DP selection process.
     CP_DP_UnGetPriorityFunc unGetPriority;
 };
+/*
+ * Copies the part of a block of an array (row-major, at PartialOffsets in
+ * the global array) that lies in a selection into OutData, laid out as the
+ * selection.  Provided by the marshaling code, data planes may use it to
+ * pack selections on the writer side.
+ */
+extern void ExtractSelectionFromPartialRM(int ElementSize, size_t Dims,
+                                          const size_t *GlobalDims,
+                                          const size_t *PartialOffsets,
+                                          const size_t *PartialCounts,
+                                          const size_t *SelectionOffsets,
+                                          const size_t *SelectionCounts,
+                                          const char *InData, char *OutData);
+
 #define DPTraceVerbose 5
 #define DPPerRankVerbose 4
 #define DPPerStepVerbose 3
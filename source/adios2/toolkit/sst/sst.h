@@ -104,6 +104,10 @@ extern SstFullMetadata SstGetCurMetadata(SstStream stream);
 extern void *SstReadRemoteMemory(SstStream s, int rank, long timestep,
                                  size_t offset, size_t length, void *buffer,
                                  void *DP_TimestepInfo);
+extern void *SstReadRemoteMemorySelection(
+    SstStream s, int rank, long timestep, size_t offset, int elementSize,
+    int dimCount, const size_t *blockCount, const size_t *selectionStart,
+    const size_t *selectionCount, void *buffer, void *DP_TimestepInfo);
 extern SstStatusValue SstWaitForCompletion(SstStream stream, void *completion);
 extern void SstReleaseStep(SstStream stream);
 extern SstStatusValue SstAdvanceStep(SstStream stream, const float timeout_sec);
@@ -147,10 +151,12 @@ SstWriterInitMetadataCallback(SstStream stream, void *Writer,
                               AssembleMetadataUpcallFunc AssembleCallback,
                               FreeMetadataUpcallFunc FreeCallback);
 
+/* Deferred arrays reference data until SstFFSWriterPerformPuts or EndStep */
 extern void SstFFSMarshal(SstStream Stream, void *Variable, const char *Name,
                           const int Type, size_t ElemSize, size_t DimCount,
                           const size_t *Shape, const size_t *Count,
-                          const size_t *Offsets, const void *data);
+                          const size_t *Offsets, const void *data,
+                          const int Deferred);
 extern void SstFFSMarshalAttribute(SstStream Stream, const char *Name,
                                    const int Type, size_t ElemSize,
                                    size_t ElemCount, const void *data);
@@ -168,6 +174,7 @@ extern SstStatusValue SstFFSPerformGets(SstStream Stream);
 
 extern int SstFFSWriterBeginStep(SstStream Stream, int mode,
                                  const float timeout_sec);
+extern void SstFFSWriterPerformPuts(SstStream Stream);
 extern void SstFFSWriterEndStep(SstStream Stream, size_t Step);
 
 #include "sst_data.h"
@@ -27,11 +27,30 @@ void Transport::IWrite(const char *buffer, size_t size, Status &status,
     throw std::invalid_argument("ERROR: this class doesn't implement IWrite\n");
 }
 
+void Transport::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
+{
+    if (iovcnt <= 0)
+    {
+        return;
+    }
+
+    Write(static_cast<const char *>(iov[0].iov_base), iov[0].iov_len, start);
+    for (int c = 1; c < iovcnt; ++c)
+    {
+        Write(static_cast<const char *>(iov[c].iov_base), iov[c].iov_len);
+    }
+}
+
 void Transport::IRead(char *buffer, size_t size, Status &status, size_t start)
 {
     throw std::invalid_argument("ERROR: this class doesn't implement IRead\n");
 }
 
+const char *Transport::View(size_t /*size*/, size_t /*start*/)
+{
+    return nullptr;
+}
+
 void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
 {
     m_Profiler.m_IsActive = true;
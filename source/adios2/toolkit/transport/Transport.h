@@ -93,6 +93,17 @@ public:
     virtual void IWrite(const char *buffer, size_t size, Status &status,
                         size_t start = MaxSizeT);
 
+    /**
+     * Writes several buffers to transport, one after the other, as if they
+     * were a single contiguous buffer
+     * @param iov buffers to be written
+     * @param iovcnt number of buffers in iov
+     * @param start starting position for writing (to allow rewind), if not
+     * passed then start at current stream position
+     */
+    virtual void WriteV(const core::iovec *iov, const int iovcnt,
+                        size_t start = MaxSizeT);
+
     /**
      * Reads from transport "size" bytes from a certain position. Note that size
      * and position and non-const due to the nature of underlying transport
@@ -108,6 +119,16 @@ public:
     virtual void IRead(char *buffer, size_t size, Status &status,
                        size_t start = MaxSizeT);
 
+    /**
+     * Returns a pointer to "size" bytes from position "start" without
+     * copying, for transports that can map the file. The pointer is valid
+     * until the next call on this transport.
+     * @param size number of bytes to view
+     * @param start starting position in the file
+     * @return pointer into the mapped file, nullptr if not supported
+     */
+    virtual const char *View(size_t size, size_t start);
+
     /**
      * Returns the size of current data in transport
      * @return size as size_t
@@ -0,0 +1,657 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileIOUring.cpp file I/O using Linux io_uring through raw system calls
+ */
+#include "FileIOUring.h"
+#include "adios2/helper/adiosFunctions.h" // LowerCase, StringTo
+
+#include <cstdio>           // remove
+#include <cstring>          // strerror, memset
+#include <errno.h>          // errno
+#include <fcntl.h>          // open
+#include <linux/io_uring.h> // io_uring_params, io_uring_sqe, io_uring_cqe
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/stat.h>       // open, fstat
+#include <sys/syscall.h>    // __NR_io_uring_*
+#include <sys/types.h>      // open
+#include <sys/uio.h>        // iovec
+#include <unistd.h>         // syscall, close
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min
+#include <ios>       //std::ios_base::failure
+/// \endcond
+
+namespace adios2
+{
+namespace transport
+{
+
+FileIOUring::FileIOUring(helper::Comm const &comm)
+: Transport("File", "IOUring", comm)
+{
+}
+
+FileIOUring::~FileIOUring()
+{
+    if (m_IsOpen)
+    {
+        // the kernel must be done with user buffers before they go away
+        try
+        {
+            WaitAll();
+        }
+        catch (...)
+        {
+        }
+        CloseRing();
+        close(m_FileDescriptor);
+    }
+}
+
+void FileIOUring::Open(const std::string &name, const Mode openMode,
+                       const bool /*async*/)
+{
+    // open is always synchronous, requests are the asynchronous part
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+    m_Offset = 0;
+
+    ProfilerStart("open");
+    errno = 0;
+    switch (m_OpenMode)
+    {
+    case (Mode::Write):
+        m_FileDescriptor =
+            open(m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        break;
+
+    case (Mode::Append):
+        m_FileDescriptor = open(m_Name.c_str(), O_RDWR | O_CREAT, 0777);
+        if (m_FileDescriptor != -1)
+        {
+            const auto end = lseek(m_FileDescriptor, 0, SEEK_END);
+            m_Offset = end > 0 ? static_cast<size_t>(end) : 0;
+        }
+        break;
+
+    case (Mode::Read):
+        m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+        break;
+
+    default:
+        CheckFile("unknown open mode for file " + m_Name +
+                  ", in call to IOUring open");
+    }
+    m_Errno = errno;
+    ProfilerStop("open");
+
+    CheckFile("couldn't open file " + m_Name + ", in call to IOUring open");
+
+    try
+    {
+        InitRing();
+    }
+    catch (...)
+    {
+        close(m_FileDescriptor);
+        m_FileDescriptor = -1;
+        throw;
+    }
+    m_IsOpen = true;
+}
+
+void FileIOUring::SetBuffer(char *buffer, size_t size)
+{
+    if (m_RingDescriptor != -1)
+    {
+        WaitAll();
+        if (m_FixedBufferRegistered)
+        {
+            syscall(__NR_io_uring_register, m_RingDescriptor,
+                    IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            m_FixedBufferRegistered = false;
+        }
+    }
+
+    m_FixedBuffer = buffer;
+    m_FixedBufferSize = buffer == nullptr ? 0 : size;
+
+    if (m_RingDescriptor != -1)
+    {
+        RegisterBuffer();
+    }
+}
+
+void FileIOUring::SetParameters(const Params &parameters)
+{
+    for (const auto &pair : parameters)
+    {
+        const std::string key = helper::LowerCase(pair.first);
+        const std::string value = helper::LowerCase(pair.second);
+
+        if (key == "queuedepth")
+        {
+            const uint32_t queueDepth = helper::StringTo<uint32_t>(
+                value, " in Parameter key=QueueDepth");
+            if (queueDepth == 0 || queueDepth > 4096)
+            {
+                throw std::invalid_argument(
+                    "ERROR: QueueDepth must be in [1,4096], in call to "
+                    "IOUring SetParameters\n");
+            }
+            m_QueueDepth = queueDepth;
+        }
+        else if (key == "chunksize")
+        {
+            const size_t chunkSize = helper::StringToByteUnits(
+                value, "for Parameter key=ChunkSize, in call to IOUring "
+                       "SetParameters");
+            if (chunkSize == 0 || chunkSize > DefaultMaxFileBatchSize)
+            {
+                throw std::invalid_argument(
+                    "ERROR: ChunkSize must be > 0 and < 2GB, in call to "
+                    "IOUring SetParameters\n");
+            }
+            m_ChunkSize = chunkSize;
+        }
+    }
+}
+
+void FileIOUring::Write(const char *buffer, size_t size, size_t start)
+{
+    const size_t offset = start != MaxSizeT ? start : m_Offset;
+
+    ProfilerStart("write");
+    Request request;
+    ++request.Pending; // held until all chunks are queued
+    Queue(request, const_cast<char *>(buffer), size, offset, true);
+    Complete(request);
+    Wait(request);
+    ProfilerStop("write");
+
+    CheckRequest(request, "couldn't write to file " + m_Name +
+                              ", in call to IOUring Write");
+    m_Offset = offset + size;
+}
+
+void FileIOUring::IWrite(const char *buffer, size_t size, Status &status,
+                         size_t start)
+{
+    const size_t offset = start != MaxSizeT ? start : m_Offset;
+
+    status.Bytes = 0;
+    status.Running = true;
+    status.Successful = false;
+
+    m_Requests.emplace_back();
+    Request &request = m_Requests.back();
+    request.AsyncStatus = &status;
+    ++request.Pending;
+    Queue(request, const_cast<char *>(buffer), size, offset, true);
+    Complete(request);
+    Enter(0);
+    Reap();
+
+    m_Offset = offset + size;
+}
+
+void FileIOUring::WriteV(const core::iovec *iov, const int iovcnt,
+                         size_t start)
+{
+    size_t offset = start != MaxSizeT ? start : m_Offset;
+
+    ProfilerStart("write");
+    Request request;
+    ++request.Pending;
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        Queue(request,
+              static_cast<char *>(const_cast<void *>(iov[i].iov_base)),
+              iov[i].iov_len, offset, true);
+        offset += iov[i].iov_len;
+    }
+    Complete(request);
+    Wait(request);
+    ProfilerStop("write");
+
+    CheckRequest(request, "couldn't write to file " + m_Name +
+                              ", in call to IOUring WriteV");
+    m_Offset = offset;
+}
+
+void FileIOUring::Read(char *buffer, size_t size, size_t start)
+{
+    const size_t offset = start != MaxSizeT ? start : m_Offset;
+
+    ProfilerStart("read");
+    Request request;
+    ++request.Pending;
+    Queue(request, buffer, size, offset, false);
+    Complete(request);
+    Wait(request);
+    ProfilerStop("read");
+
+    CheckRequest(request, "couldn't read from file " + m_Name +
+                              ", in call to IOUring Read");
+    m_Offset = offset + size;
+}
+
+void FileIOUring::IRead(char *buffer, size_t size, Status &status,
+                        size_t start)
+{
+    const size_t offset = start != MaxSizeT ? start : m_Offset;
+
+    status.Bytes = 0;
+    status.Running = true;
+    status.Successful = false;
+
+    m_Requests.emplace_back();
+    Request &request = m_Requests.back();
+    request.AsyncStatus = &status;
+    ++request.Pending;
+    Queue(request, buffer, size, offset, false);
+    Complete(request);
+    Enter(0);
+    Reap();
+
+    m_Offset = offset + size;
+}
+
+size_t FileIOUring::GetSize()
+{
+    WaitAll();
+    struct stat fileStat;
+    errno = 0;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        m_Errno = errno;
+        throw std::ios_base::failure("ERROR: couldn't get size of file " +
+                                     m_Name + SysErrMsg());
+    }
+    m_Errno = errno;
+    return static_cast<size_t>(fileStat.st_size);
+}
+
+void FileIOUring::Flush() { WaitAll(); }
+
+void FileIOUring::Close()
+{
+    WaitAll();
+    CloseRing();
+
+    ProfilerStart("close");
+    errno = 0;
+    const int status = close(m_FileDescriptor);
+    m_Errno = errno;
+    ProfilerStop("close");
+
+    if (status == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't close file " + m_Name +
+                                     ", in call to IOUring close" +
+                                     SysErrMsg());
+    }
+
+    m_IsOpen = false;
+}
+
+void FileIOUring::Delete()
+{
+    if (m_IsOpen)
+    {
+        Close();
+    }
+    std::remove(m_Name.c_str());
+}
+
+void FileIOUring::SeekToEnd() { m_Offset = GetSize(); }
+
+void FileIOUring::SeekToBegin() { m_Offset = 0; }
+
+// PRIVATE
+void FileIOUring::InitRing()
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    errno = 0;
+    const int ring = static_cast<int>(
+        syscall(__NR_io_uring_setup, m_QueueDepth, &params));
+    m_Errno = errno;
+    if (ring < 0)
+    {
+        throw std::ios_base::failure(
+            "ERROR: couldn't create io_uring for file " + m_Name +
+            ", in call to io_uring_setup" + SysErrMsg());
+    }
+    m_RingDescriptor = ring;
+
+    m_SQRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_CQRingSize =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap)
+    {
+        m_SQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+        m_CQRingSize = m_SQRingSize;
+    }
+
+    auto lf_Map = [&](const size_t size, const off_t offset) -> void * {
+        errno = 0;
+        void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring, offset);
+        m_Errno = errno;
+        if (address == MAP_FAILED)
+        {
+            CloseRing();
+            throw std::ios_base::failure(
+                "ERROR: couldn't map io_uring queues for file " + m_Name +
+                ", in call to mmap" + SysErrMsg());
+        }
+        return address;
+    };
+
+    m_SQRing = lf_Map(m_SQRingSize, IORING_OFF_SQ_RING);
+    m_CQRing =
+        singleMap ? m_SQRing : lf_Map(m_CQRingSize, IORING_OFF_CQ_RING);
+    m_SQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_SQEs = static_cast<io_uring_sqe *>(lf_Map(m_SQEsSize, IORING_OFF_SQES));
+
+    char *sq = static_cast<char *>(m_SQRing);
+    m_SQHead = reinterpret_cast<unsigned int *>(sq + params.sq_off.head);
+    m_SQTail = reinterpret_cast<unsigned int *>(sq + params.sq_off.tail);
+    m_SQMask = *reinterpret_cast<unsigned int *>(sq + params.sq_off.ring_mask);
+    m_SQArray = reinterpret_cast<unsigned int *>(sq + params.sq_off.array);
+
+    char *cq = static_cast<char *>(m_CQRing);
+    m_CQHead = reinterpret_cast<unsigned int *>(cq + params.cq_off.head);
+    m_CQTail = reinterpret_cast<unsigned int *>(cq + params.cq_off.tail);
+    m_CQMask = *reinterpret_cast<unsigned int *>(cq + params.cq_off.ring_mask);
+    m_CQEs = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    // registration is an optimization, plain descriptors work if it fails
+    m_FixedFile = syscall(__NR_io_uring_register, ring, IORING_REGISTER_FILES,
+                          &m_FileDescriptor, 1) == 0;
+    RegisterBuffer();
+}
+
+void FileIOUring::CloseRing() noexcept
+{
+    if (m_SQEs != nullptr)
+    {
+        munmap(m_SQEs, m_SQEsSize);
+    }
+    if (m_CQRing != nullptr && m_CQRing != m_SQRing)
+    {
+        munmap(m_CQRing, m_CQRingSize);
+    }
+    if (m_SQRing != nullptr)
+    {
+        munmap(m_SQRing, m_SQRingSize);
+    }
+    if (m_RingDescriptor != -1)
+    {
+        close(m_RingDescriptor);
+    }
+
+    m_SQEs = nullptr;
+    m_CQRing = nullptr;
+    m_SQRing = nullptr;
+    m_RingDescriptor = -1;
+    m_FixedFile = false;
+    m_FixedBufferRegistered = false;
+    m_ToSubmit = 0;
+    m_InFlight = 0;
+    m_Operations.clear();
+}
+
+void FileIOUring::RegisterBuffer()
+{
+    if (m_FixedBuffer == nullptr || m_FixedBufferSize == 0)
+    {
+        return;
+    }
+
+    struct ::iovec iov;
+    iov.iov_base = m_FixedBuffer;
+    iov.iov_len = m_FixedBufferSize;
+    m_FixedBufferRegistered =
+        syscall(__NR_io_uring_register, m_RingDescriptor,
+                IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+}
+
+void FileIOUring::Queue(Request &request, char *buffer, size_t size,
+                        size_t offset, const bool isWrite)
+{
+    while (size > 0)
+    {
+        while (m_InFlight + m_ToSubmit >= m_QueueDepth)
+        {
+            Enter(1);
+            Reap();
+        }
+
+        const size_t chunk = std::min(size, m_ChunkSize);
+        const uint64_t id = m_NextOperationID++;
+        const Operation &operation =
+            m_Operations
+                .emplace(id,
+                         Operation{&request, buffer, chunk, offset, isWrite})
+                .first->second;
+        ++request.Pending;
+        Push(id, operation);
+
+        buffer += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+}
+
+void FileIOUring::Push(const uint64_t id, const Operation &operation)
+{
+    const unsigned int tail = *m_SQTail;
+    const unsigned int index = tail & m_SQMask;
+
+    io_uring_sqe *sqe = &m_SQEs[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+
+    const bool fixedBuffer =
+        m_FixedBufferRegistered && operation.Buffer >= m_FixedBuffer &&
+        operation.Buffer + operation.Size <= m_FixedBuffer + m_FixedBufferSize;
+    if (fixedBuffer)
+    {
+        sqe->opcode = static_cast<uint8_t>(
+            operation.IsWrite ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED);
+        sqe->buf_index = 0;
+    }
+    else
+    {
+        sqe->opcode = static_cast<uint8_t>(operation.IsWrite ? IORING_OP_WRITE
+                                                             : IORING_OP_READ);
+    }
+
+    if (m_FixedFile)
+    {
+        sqe->fd = 0;
+        sqe->flags = IOSQE_FIXED_FILE;
+    }
+    else
+    {
+        sqe->fd = m_FileDescriptor;
+    }
+    sqe->addr = reinterpret_cast<uint64_t>(operation.Buffer);
+    sqe->len = static_cast<uint32_t>(operation.Size);
+    sqe->off = static_cast<uint64_t>(operation.Offset);
+    sqe->user_data = id;
+
+    m_SQArray[index] = index;
+    __atomic_store_n(m_SQTail, tail + 1, __ATOMIC_RELEASE);
+    ++m_ToSubmit;
+}
+
+void FileIOUring::Enter(const unsigned int minComplete)
+{
+    if (m_ToSubmit == 0 && (minComplete == 0 || m_InFlight == 0))
+    {
+        return;
+    }
+
+    const unsigned int flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true)
+    {
+        errno = 0;
+        const int submitted = static_cast<int>(
+            syscall(__NR_io_uring_enter, m_RingDescriptor, m_ToSubmit,
+                    minComplete, flags, nullptr, 0));
+        m_Errno = errno;
+
+        if (submitted >= 0)
+        {
+            m_ToSubmit -= static_cast<unsigned int>(submitted);
+            m_InFlight += static_cast<unsigned int>(submitted);
+            return;
+        }
+
+        if (m_Errno == EINTR)
+        {
+            continue;
+        }
+        if (m_Errno == EAGAIN || m_Errno == EBUSY)
+        {
+            // completion queue is full, make room and try again
+            Reap();
+            continue;
+        }
+
+        throw std::ios_base::failure(
+            "ERROR: couldn't submit requests for file " + m_Name +
+            ", in call to io_uring_enter" + SysErrMsg());
+    }
+}
+
+void FileIOUring::Reap()
+{
+    unsigned int head = *m_CQHead;
+    const unsigned int tail = __atomic_load_n(m_CQTail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; ++head)
+    {
+        const io_uring_cqe &cqe = m_CQEs[head & m_CQMask];
+        const uint64_t id = cqe.user_data;
+        const int result = cqe.res;
+        --m_InFlight;
+
+        auto itOperation = m_Operations.find(id);
+        if (itOperation == m_Operations.end())
+        {
+            continue;
+        }
+        Operation &operation = itOperation->second;
+        Request &request = *operation.Parent;
+
+        if (result == -EINTR || result == -EAGAIN)
+        {
+            Push(id, operation);
+            continue;
+        }
+
+        if (result < 0 || (result == 0 && operation.Size > 0))
+        {
+            // result == 0 is an unexpected end of file on read
+            request.Error = result < 0 ? -result : EIO;
+            m_Operations.erase(itOperation);
+            Complete(request);
+            continue;
+        }
+
+        const size_t done = static_cast<size_t>(result);
+        request.Bytes += done;
+        if (done < operation.Size)
+        {
+            // short read or write, resubmit the remainder
+            operation.Buffer += done;
+            operation.Size -= done;
+            operation.Offset += done;
+            Push(id, operation);
+            continue;
+        }
+
+        m_Operations.erase(itOperation);
+        Complete(request);
+    }
+
+    __atomic_store_n(m_CQHead, head, __ATOMIC_RELEASE);
+
+    m_Requests.remove_if(
+        [](const Request &request) { return request.Pending == 0; });
+}
+
+void FileIOUring::Complete(Request &request)
+{
+    --request.Pending;
+    if (request.Pending == 0 && request.AsyncStatus != nullptr)
+    {
+        request.AsyncStatus->Bytes = request.Bytes;
+        request.AsyncStatus->Successful = request.Error == 0;
+        request.AsyncStatus->Running = false;
+    }
+}
+
+void FileIOUring::Wait(const Request &request)
+{
+    Enter(0);
+    Reap();
+    while (request.Pending > 0)
+    {
+        Enter(1);
+        Reap();
+    }
+}
+
+void FileIOUring::WaitAll()
+{
+    if (m_RingDescriptor == -1)
+    {
+        return;
+    }
+
+    Enter(0);
+    Reap();
+    while (!m_Requests.empty())
+    {
+        Enter(1);
+        Reap();
+    }
+}
+
+void FileIOUring::CheckRequest(const Request &request,
+                               const std::string &hint) const
+{
+    if (request.Error != 0)
+    {
+        throw std::ios_base::failure("ERROR: " + hint + ": errno = " +
+                                     std::to_string(request.Error) + ": " +
+                                     strerror(request.Error));
+    }
+}
+
+void FileIOUring::CheckFile(const std::string hint) const
+{
+    if (m_FileDescriptor == -1)
+    {
+        throw std::ios_base::failure("ERROR: " + hint + SysErrMsg());
+    }
+}
+
+std::string FileIOUring::SysErrMsg() const
+{
+    return std::string(": errno = " + std::to_string(m_Errno) + ": " +
+                       strerror(m_Errno));
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,171 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileIOUring.h wrapper of Linux io_uring submission/completion queues for
+ * file I/O
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEIOURING_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEIOURING_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "adios2/common/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace adios2
+{
+namespace helper
+{
+class Comm;
+}
+namespace transport
+{
+
+/**
+ * File transport using Linux io_uring. Requests are split in chunks that are
+ * queued up to QueueDepth at a time and submitted in batches with a single
+ * io_uring_enter call. The file descriptor and the buffer passed to SetBuffer
+ * are registered with the kernel.
+ */
+class FileIOUring : public Transport
+{
+
+public:
+    FileIOUring(helper::Comm const &comm);
+
+    ~FileIOUring();
+
+    void Open(const std::string &name, const Mode openMode,
+              const bool async = false) final;
+
+    /** Registers buffer with the ring, nullptr unregisters */
+    void SetBuffer(char *buffer, size_t size) final;
+
+    /** QueueDepth: max requests in flight, ChunkSize: max bytes per request */
+    void SetParameters(const Params &parameters) final;
+
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** status is updated by later calls on this transport, Flush waits */
+    void IWrite(const char *buffer, size_t size, Status &status,
+                size_t start = MaxSizeT) final;
+
+    /** Queues all buffers before waiting for any of them */
+    void WriteV(const core::iovec *iov, const int iovcnt,
+                size_t start = MaxSizeT) final;
+
+    void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** status is updated by later calls on this transport, Flush waits */
+    void IRead(char *buffer, size_t size, Status &status,
+               size_t start = MaxSizeT) final;
+
+    size_t GetSize() final;
+
+    /** Waits for all pending IWrite/IRead requests */
+    void Flush() final;
+
+    void Close() final;
+
+    void Delete() final;
+
+    void SeekToEnd() final;
+
+    void SeekToBegin() final;
+
+private:
+    /** one Write/Read/IWrite/IRead call, possibly split in several chunks */
+    struct Request
+    {
+        Status *AsyncStatus = nullptr;
+        size_t Pending = 0;
+        size_t Bytes = 0;
+        int Error = 0;
+    };
+
+    /** one submission queue entry in flight */
+    struct Operation
+    {
+        Request *Parent;
+        char *Buffer;
+        size_t Size;
+        size_t Offset;
+        bool IsWrite;
+    };
+
+    /** POSIX file handle returned by Open */
+    int m_FileDescriptor = -1;
+    int m_Errno = 0;
+    /** io_uring handle returned by io_uring_setup */
+    int m_RingDescriptor = -1;
+
+    unsigned int m_QueueDepth = 32;
+    size_t m_ChunkSize = 4 * 1024 * 1024;
+    /** file position used when start is not passed */
+    size_t m_Offset = 0;
+
+    void *m_SQRing = nullptr;
+    size_t m_SQRingSize = 0;
+    void *m_CQRing = nullptr;
+    size_t m_CQRingSize = 0;
+    io_uring_sqe *m_SQEs = nullptr;
+    size_t m_SQEsSize = 0;
+
+    unsigned int *m_SQHead = nullptr;
+    unsigned int *m_SQTail = nullptr;
+    unsigned int m_SQMask = 0;
+    unsigned int *m_SQArray = nullptr;
+    unsigned int *m_CQHead = nullptr;
+    unsigned int *m_CQTail = nullptr;
+    unsigned int m_CQMask = 0;
+    io_uring_cqe *m_CQEs = nullptr;
+
+    /** entries queued but not yet passed to io_uring_enter */
+    unsigned int m_ToSubmit = 0;
+    /** entries submitted but not yet completed */
+    unsigned int m_InFlight = 0;
+
+    bool m_FixedFile = false;
+    char *m_FixedBuffer = nullptr;
+    size_t m_FixedBufferSize = 0;
+    bool m_FixedBufferRegistered = false;
+
+    uint64_t m_NextOperationID = 0;
+    std::unordered_map<uint64_t, Operation> m_Operations;
+    /** IWrite/IRead requests not yet completed */
+    std::list<Request> m_Requests;
+
+    void InitRing();
+    void CloseRing() noexcept;
+    void RegisterBuffer();
+
+    /** splits buffer in ChunkSize pieces and queues them */
+    void Queue(Request &request, char *buffer, size_t size, size_t offset,
+               const bool isWrite);
+    /** fills a submission queue entry, there must be a free one */
+    void Push(const uint64_t id, const Operation &operation);
+    /** submits queued entries, waits for minComplete completions */
+    void Enter(const unsigned int minComplete);
+    /** consumes all available completion queue entries */
+    void Reap();
+    /** drops one pending count, updates an IWrite/IRead status at zero */
+    void Complete(Request &request);
+    void Wait(const Request &request);
+    void WaitAll();
+
+    void CheckRequest(const Request &request, const std::string &hint) const;
+    void CheckFile(const std::string hint) const;
+    std::string SysErrMsg() const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEIOURING_H_ */
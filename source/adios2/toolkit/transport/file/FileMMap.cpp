@@ -0,0 +1,227 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMap.cpp file reads using a POSIX memory mapping
+ */
+#include "FileMMap.h"
+
+#include <cstdio>      // remove
+#include <cstring>     // strerror, memcpy
+#include <errno.h>     // errno
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // open, fstat
+#include <sys/types.h> // open
+#include <unistd.h>    // close, sysconf
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <ios>       //std::ios_base::failure
+#include <stdexcept> //std::invalid_argument
+/// \endcond
+
+namespace adios2
+{
+namespace transport
+{
+
+FileMMap::FileMMap(helper::Comm const &comm) : Transport("File", "MMap", comm)
+{
+}
+
+FileMMap::~FileMMap()
+{
+    if (m_IsOpen)
+    {
+        Unmap();
+        close(m_FileDescriptor);
+    }
+}
+
+void FileMMap::Open(const std::string &name, const Mode openMode,
+                    const bool /*async*/)
+{
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+
+    if (m_OpenMode != Mode::Read)
+    {
+        throw std::invalid_argument("ERROR: MMap transport only supports "
+                                    "Mode::Read, in call to Open file " +
+                                    m_Name + "\n");
+    }
+
+    ProfilerStart("open");
+    errno = 0;
+    m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+    m_Errno = errno;
+    ProfilerStop("open");
+
+    CheckFile("couldn't open file " + m_Name + ", in call to MMap open");
+    m_Position = 0;
+    m_IsOpen = true;
+}
+
+void FileMMap::Write(const char * /*buffer*/, size_t /*size*/,
+                     size_t /*start*/)
+{
+    throw std::invalid_argument("ERROR: MMap transport is read-only, in call "
+                                "to Write file " +
+                                m_Name + "\n");
+}
+
+void FileMMap::Read(char *buffer, size_t size, size_t start)
+{
+    if (start == MaxSizeT)
+    {
+        start = m_Position;
+    }
+
+    CheckMapped(size, start, "in call to MMap Read");
+
+    ProfilerStart("read");
+    if (size > 0)
+    {
+        std::memcpy(buffer, m_Data + start, size);
+    }
+    ProfilerStop("read");
+
+    m_Position = start + size;
+}
+
+const char *FileMMap::View(size_t size, size_t start)
+{
+    CheckMapped(size, start, "in call to MMap View");
+    if (m_Data == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (size > 0)
+    {
+        // madvise needs a page aligned address
+        static const size_t pageSize =
+            static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t first = start - start % pageSize;
+        madvise(m_Data + first, size + start - first, MADV_WILLNEED);
+    }
+
+    m_Position = start + size;
+    return m_Data + start;
+}
+
+size_t FileMMap::GetSize()
+{
+    struct stat fileStat;
+    errno = 0;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        m_Errno = errno;
+        throw std::ios_base::failure("ERROR: couldn't get size of file " +
+                                     m_Name + SysErrMsg());
+    }
+    m_Errno = errno;
+    return static_cast<size_t>(fileStat.st_size);
+}
+
+void FileMMap::Flush() {}
+
+void FileMMap::Close()
+{
+    Unmap();
+
+    ProfilerStart("close");
+    errno = 0;
+    const int status = close(m_FileDescriptor);
+    m_Errno = errno;
+    ProfilerStop("close");
+
+    if (status == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't close file " + m_Name +
+                                     ", in call to MMap close" + SysErrMsg());
+    }
+
+    m_IsOpen = false;
+}
+
+void FileMMap::Delete()
+{
+    if (m_IsOpen)
+    {
+        Close();
+    }
+    std::remove(m_Name.c_str());
+}
+
+void FileMMap::SeekToEnd() { m_Position = GetSize(); }
+
+void FileMMap::SeekToBegin() { m_Position = 0; }
+
+// PRIVATE
+void FileMMap::CheckMapped(const size_t size, const size_t start,
+                           const std::string &hint)
+{
+    if (start + size <= m_MapSize)
+    {
+        return;
+    }
+
+    // the file grew since it was mapped, or this is the first access
+    const size_t fileSize = GetSize();
+    if (start + size > fileSize)
+    {
+        throw std::ios_base::failure(
+            "ERROR: couldn't read " + std::to_string(size) +
+            " bytes from position " + std::to_string(start) + " in file " +
+            m_Name + " of size " + std::to_string(fileSize) + ", " + hint);
+    }
+
+    Unmap();
+    if (fileSize == 0)
+    {
+        return;
+    }
+
+    errno = 0;
+    void *data =
+        mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+    m_Errno = errno;
+
+    if (data == MAP_FAILED)
+    {
+        throw std::ios_base::failure("ERROR: couldn't map file " + m_Name +
+                                     ", " + hint + SysErrMsg());
+    }
+
+    m_Data = static_cast<char *>(data);
+    m_MapSize = fileSize;
+}
+
+void FileMMap::Unmap() noexcept
+{
+    if (m_Data != nullptr)
+    {
+        munmap(m_Data, m_MapSize);
+    }
+    m_Data = nullptr;
+    m_MapSize = 0;
+}
+
+void FileMMap::CheckFile(const std::string hint) const
+{
+    if (m_FileDescriptor == -1)
+    {
+        throw std::ios_base::failure("ERROR: " + hint + SysErrMsg());
+    }
+}
+
+std::string FileMMap::SysErrMsg() const
+{
+    return std::string(": errno = " + std::to_string(m_Errno) + ": " +
+                       strerror(m_Errno));
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,84 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMap.h read-only file transport on top of a POSIX memory mapping
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+
+#include "adios2/common/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace helper
+{
+class Comm;
+}
+namespace transport
+{
+
+/**
+ * Maps the whole file read-only. Read copies from the mapping and View
+ * returns a pointer into it, so readers can decode straight from the page
+ * cache. The mapping grows when a read goes past its end, which happens
+ * while streaming files that are still being written.
+ */
+class FileMMap : public Transport
+{
+
+public:
+    FileMMap(helper::Comm const &comm);
+
+    ~FileMMap();
+
+    /** Only Mode::Read is supported */
+    void Open(const std::string &name, const Mode openMode,
+              const bool async = false) final;
+
+    /** Throws, the transport is read-only */
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** Also asks the kernel to read ahead the viewed pages */
+    const char *View(size_t size, size_t start) final;
+
+    size_t GetSize() final;
+
+    /** Does nothing, nothing is ever written */
+    void Flush() final;
+
+    void Close() final;
+
+    void Delete() final;
+
+    void SeekToEnd() final;
+
+    void SeekToBegin() final;
+
+private:
+    /** POSIX file handle returned by Open */
+    int m_FileDescriptor = -1;
+    int m_Errno = 0;
+    /** start of the mapping, nullptr if the file was empty */
+    char *m_Data = nullptr;
+    size_t m_MapSize = 0;
+    /** position used when start is not passed */
+    size_t m_Position = 0;
+
+    /** remaps if [start, start + size) is past the mapped size */
+    void CheckMapped(const size_t size, const size_t start,
+                     const std::string &hint);
+    void Unmap() noexcept;
+
+    void CheckFile(const std::string hint) const;
+    std::string SysErrMsg() const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_ */
@@ -8,18 +8,24 @@
  *      Author: William F Godoy godoywf@ornl.gov
  */
 #include "FilePOSIX.h"
+#include "adios2/helper/adiosFunctions.h" // LowerCase, StringTo
 
+#include <climits>     // IOV_MAX
+#include <cstdint>     // uintptr_t
 #include <cstdio>      // remove
-#include <cstring>     // strerror
+#include <cstring>     // strerror, memcpy
 #include <errno.h>     // errno
 #include <fcntl.h>     // open
 #include <stddef.h>    // write output
 #include <sys/stat.h>  // open, fstat
 #include <sys/types.h> // open
+#include <sys/uio.h>   // writev
 #include <unistd.h>    // write, close
 
 /// \cond EXCLUDE_FROM_DOXYGEN
-#include <ios> //std::ios_base::failure
+#include <algorithm> //std::min
+#include <ios>       //std::ios_base::failure
+#include <vector>
 /// \endcond
 
 namespace adios2
@@ -27,6 +33,14 @@ namespace adios2
 namespace transport
 {
 
+namespace
+{
+/** O_DIRECT offset, size and memory alignment, covers 512B and 4KB sectors */
+constexpr size_t DirectAlignment = 4096;
+/** staging buffer for O_DIRECT writes from unaligned memory */
+constexpr size_t DirectBufferSize = 8 * 1024 * 1024;
+}
+
 FilePOSIX::FilePOSIX(helper::Comm const &comm)
 : Transport("File", "POSIX", comm)
 {
@@ -38,6 +52,10 @@ FilePOSIX::~FilePOSIX()
     {
         close(m_FileDescriptor);
     }
+    if (m_DirectFileDescriptor != -1)
+    {
+        close(m_DirectFileDescriptor);
+    }
 }
 
 void FilePOSIX::WaitForOpen()
@@ -62,6 +80,10 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
         errno = 0;
         int FD = open(m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
         m_Errno = errno;
+        if (FD != -1)
+        {
+            OpenDirect();
+        }
         ProfilerStop("open");
         return FD;
     };
@@ -69,6 +91,7 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
     m_Name = name;
     CheckName();
     m_OpenMode = openMode;
+    m_DirectFill = 0;
     switch (m_OpenMode)
     {
 
@@ -86,6 +109,10 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
             m_FileDescriptor =
                 open(m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
             m_Errno = errno;
+            if (m_FileDescriptor != -1)
+            {
+                OpenDirect();
+            }
             ProfilerStop("open");
         }
         break;
@@ -97,6 +124,10 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
         m_FileDescriptor = open(m_Name.c_str(), O_RDWR | O_CREAT, 0777);
         lseek(m_FileDescriptor, 0, SEEK_END);
         m_Errno = errno;
+        if (m_FileDescriptor != -1)
+        {
+            OpenDirect();
+        }
         ProfilerStop("open");
         break;
 
@@ -120,6 +151,21 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
     }
 }
 
+void FilePOSIX::SetParameters(const Params &parameters)
+{
+    for (const auto &pair : parameters)
+    {
+        const std::string key = helper::LowerCase(pair.first);
+        const std::string value = helper::LowerCase(pair.second);
+
+        if (key == "directio")
+        {
+            m_DirectIO =
+                helper::StringTo<bool>(value, " in Parameter key=DirectIO");
+        }
+    }
+}
+
 void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
 {
     auto lf_Write = [&](const char *buffer, size_t size) {
@@ -149,6 +195,12 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     };
 
     WaitForOpen();
+    if (m_DirectFileDescriptor != -1)
+    {
+        WriteDirect(buffer, size, start);
+        return;
+    }
+
     if (start != MaxSizeT)
     {
         errno = 0;
@@ -183,6 +235,84 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     }
 }
 
+void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt,
+                       size_t start)
+{
+#ifdef IOV_MAX
+    const size_t maxIOVCount = IOV_MAX;
+#else
+    const size_t maxIOVCount = 1024;
+#endif
+
+    WaitForOpen();
+    if (m_DirectFileDescriptor != -1)
+    {
+        // one call per buffer, WriteDirect carries the unaligned tails over
+        Transport::WriteV(iov, iovcnt, start);
+        return;
+    }
+
+    if (start != MaxSizeT)
+    {
+        errno = 0;
+        const auto newPosition = lseek(m_FileDescriptor, start, SEEK_SET);
+        m_Errno = errno;
+
+        if (static_cast<size_t>(newPosition) != start)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't move to start position " +
+                std::to_string(start) + " in file " + m_Name +
+                ", in call to POSIX lseek" + SysErrMsg());
+        }
+    }
+
+    std::vector<struct ::iovec> iovs(iovcnt > 0 ? iovcnt : 0);
+    for (size_t i = 0; i < iovs.size(); ++i)
+    {
+        iovs[i].iov_base = const_cast<void *>(iov[i].iov_base);
+        iovs[i].iov_len = iov[i].iov_len;
+    }
+
+    size_t first = 0;
+    while (first < iovs.size())
+    {
+        const int count =
+            static_cast<int>(std::min(iovs.size() - first, maxIOVCount));
+        ProfilerStart("write");
+        errno = 0;
+        const auto writtenSize = writev(m_FileDescriptor, &iovs[first], count);
+        m_Errno = errno;
+        ProfilerStop("write");
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure(
+                "ERROR: couldn't write to file " + m_Name +
+                ", in call to POSIX writev" + SysErrMsg());
+        }
+
+        // skip the buffers written entirely, continue a partial one
+        size_t remainder = static_cast<size_t>(writtenSize);
+        while (first < iovs.size() && remainder >= iovs[first].iov_len)
+        {
+            remainder -= iovs[first].iov_len;
+            ++first;
+        }
+        if (remainder > 0)
+        {
+            iovs[first].iov_base =
+                static_cast<char *>(iovs[first].iov_base) + remainder;
+            iovs[first].iov_len -= remainder;
+        }
+    }
+}
+
 void FilePOSIX::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
@@ -268,6 +398,11 @@ void FilePOSIX::Close()
 {
     WaitForOpen();
     ProfilerStart("close");
+    if (m_DirectFileDescriptor != -1)
+    {
+        close(m_DirectFileDescriptor);
+        m_DirectFileDescriptor = -1;
+    }
     errno = 0;
     const int status = close(m_FileDescriptor);
     m_Errno = errno;
@@ -307,6 +442,156 @@ std::string FilePOSIX::SysErrMsg() const
                        strerror(m_Errno));
 }
 
+void FilePOSIX::OpenDirect()
+{
+#ifdef O_DIRECT
+    if (m_DirectIO &&
+        (m_OpenMode == Mode::Write || m_OpenMode == Mode::Append))
+    {
+        // stays -1 on file systems without direct I/O, e.g. tmpfs
+        m_DirectFileDescriptor = open(m_Name.c_str(), O_WRONLY | O_DIRECT);
+    }
+#endif
+}
+
+char *FilePOSIX::DirectBuffer() noexcept
+{
+    if (m_DirectBuffer.empty())
+    {
+        m_DirectBuffer.resize(DirectBufferSize + DirectAlignment);
+    }
+    char *data = m_DirectBuffer.data();
+    const size_t misalignment =
+        reinterpret_cast<uintptr_t>(data) % DirectAlignment;
+    return misalignment == 0 ? data : data + DirectAlignment - misalignment;
+}
+
+void FilePOSIX::WriteAt(const int descriptor, const char *buffer, size_t size,
+                        size_t offset, const std::string &hint)
+{
+    while (size > 0)
+    {
+        ProfilerStart("write");
+        errno = 0;
+        const auto writtenSize =
+            pwrite(descriptor, buffer, std::min(size, DefaultMaxFileBatchSize),
+                   static_cast<off_t>(offset));
+        m_Errno = errno;
+        ProfilerStop("write");
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure("ERROR: couldn't write to file " +
+                                         m_Name + ", in call to " + hint +
+                                         SysErrMsg());
+        }
+
+        buffer += writtenSize;
+        size -= writtenSize;
+        offset += writtenSize;
+    }
+}
+
+void FilePOSIX::WriteDirect(const char *buffer, size_t size, size_t start)
+{
+    size_t offset = start;
+    if (offset == MaxSizeT)
+    {
+        errno = 0;
+        const auto position = lseek(m_FileDescriptor, 0, SEEK_CUR);
+        m_Errno = errno;
+        if (position == -1)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't get current position in file " + m_Name +
+                ", in call to POSIX lseek" + SysErrMsg());
+        }
+        offset = static_cast<size_t>(position);
+    }
+
+    char *staging = DirectBuffer();
+
+    if (m_DirectFill == 0 || offset != m_DirectBlockStart + m_DirectFill)
+    {
+        // not continuing the staged tail (already on file), bring the
+        // offset to the next aligned block with a buffered write
+        m_DirectFill = 0;
+        const size_t head =
+            std::min(size, (DirectAlignment - offset % DirectAlignment) %
+                               DirectAlignment);
+        WriteAt(m_FileDescriptor, buffer, head, offset, "POSIX pwrite");
+        buffer += head;
+        size -= head;
+        offset += head;
+        m_DirectBlockStart = offset;
+    }
+
+    if (m_DirectBlockStart % DirectAlignment == 0)
+    {
+        while (size > 0)
+        {
+            if (m_DirectFill == 0 && size >= DirectAlignment &&
+                reinterpret_cast<uintptr_t>(buffer) % DirectAlignment == 0)
+            {
+                // aligned user memory goes to file without staging
+                const size_t blocks = size - size % DirectAlignment;
+                WriteAt(m_DirectFileDescriptor, buffer, blocks,
+                        m_DirectBlockStart, "POSIX O_DIRECT pwrite");
+                buffer += blocks;
+                size -= blocks;
+                m_DirectBlockStart += blocks;
+                continue;
+            }
+
+            const size_t copySize =
+                std::min(size, DirectBufferSize - m_DirectFill);
+            std::memcpy(staging + m_DirectFill, buffer, copySize);
+            buffer += copySize;
+            size -= copySize;
+            m_DirectFill += copySize;
+
+            if (m_DirectFill == DirectBufferSize)
+            {
+                WriteAt(m_DirectFileDescriptor, staging, DirectBufferSize,
+                        m_DirectBlockStart, "POSIX O_DIRECT pwrite");
+                m_DirectBlockStart += DirectBufferSize;
+                m_DirectFill = 0;
+            }
+        }
+
+        // whole blocks go direct, the tail stays staged for the next call
+        // and is written buffered now so the file is complete on return
+        const size_t blocks = m_DirectFill - m_DirectFill % DirectAlignment;
+        if (blocks > 0)
+        {
+            WriteAt(m_DirectFileDescriptor, staging, blocks,
+                    m_DirectBlockStart, "POSIX O_DIRECT pwrite");
+            std::memmove(staging, staging + blocks, m_DirectFill - blocks);
+            m_DirectBlockStart += blocks;
+            m_DirectFill -= blocks;
+        }
+        WriteAt(m_FileDescriptor, staging, m_DirectFill, m_DirectBlockStart,
+                "POSIX pwrite");
+        offset = m_DirectBlockStart + m_DirectFill;
+    }
+
+    errno = 0;
+    const auto newPosition =
+        lseek(m_FileDescriptor, static_cast<off_t>(offset), SEEK_SET);
+    m_Errno = errno;
+    if (static_cast<size_t>(newPosition) != offset)
+    {
+        throw std::ios_base::failure(
+            "ERROR: couldn't move to position " + std::to_string(offset) +
+            " in file " + m_Name + ", in call to POSIX lseek" + SysErrMsg());
+    }
+}
+
 void FilePOSIX::SeekToEnd()
 {
     WaitForOpen();
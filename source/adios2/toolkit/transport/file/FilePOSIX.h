@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEDESCRIPTOR_H_
 
 #include <future> //std::async, std::future
+#include <vector>
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/toolkit/transport/Transport.h"
@@ -37,8 +38,15 @@ public:
     void Open(const std::string &name, const Mode openMode,
               const bool async = false) final;
 
+    /** DirectIO: write data through O_DIRECT in Write and Append modes */
+    void SetParameters(const Params &parameters) final;
+
     void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /** Writes all buffers with as few writev calls as possible */
+    void WriteV(const core::iovec *iov, const int iovcnt,
+                size_t start = MaxSizeT) final;
+
     void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
 
     size_t GetSize() final;
@@ -61,6 +69,19 @@ private:
     bool m_IsOpening = false;
     std::future<int> m_OpenFuture;
 
+    /** DirectIO parameter, silently off if the file system rejects it */
+    bool m_DirectIO = false;
+    /** second handle to the same file opened with O_DIRECT */
+    int m_DirectFileDescriptor = -1;
+    /** staging memory for unaligned user buffers, holds DirectBufferSize
+     * bytes aligned to DirectAlignment */
+    std::vector<char> m_DirectBuffer;
+    /** aligned file offset of the first byte in the staging buffer */
+    size_t m_DirectBlockStart = 0;
+    /** bytes in the staging buffer, the tail past the last full block is
+     * also on file through the buffered handle */
+    size_t m_DirectFill = 0;
+
     /**
      * Check if m_FileDescriptor is -1 after an operation
      * @param hint exception message
@@ -68,6 +89,17 @@ private:
     void CheckFile(const std::string hint) const;
     void WaitForOpen();
     std::string SysErrMsg() const;
+
+    /** opens m_DirectFileDescriptor next to an open m_FileDescriptor */
+    void OpenDirect();
+    /** Write replacement when m_DirectFileDescriptor is open: whole
+     * aligned blocks go through O_DIRECT, the unaligned head and tail of
+     * each call through the buffered handle */
+    void WriteDirect(const char *buffer, size_t size, size_t start);
+    char *DirectBuffer() noexcept;
+    /** pwrite loop on descriptor, hint names the call for errors */
+    void WriteAt(const int descriptor, const char *buffer, size_t size,
+                 size_t offset, const std::string &hint);
 };
 
 } // end namespace transport
@@ -17,11 +17,15 @@
 
 /// transports
 #ifndef _WIN32
+#include "adios2/toolkit/transport/file/FileMMap.h"
 #include "adios2/toolkit/transport/file/FilePOSIX.h"
 #endif
 #ifdef ADIOS2_HAVE_IME
 #include "adios2/toolkit/transport/file/FileIME.h"
 #endif
+#ifdef ADIOS2_HAVE_IOURING
+#include "adios2/toolkit/transport/file/FileIOUring.h"
+#endif
 
 #ifdef _WIN32
 #pragma warning(disable : 4503) // length of std::function inside std::async
@@ -198,6 +202,29 @@ void TransportMan::WriteFiles(const char *buffer, const size_t size,
     }
 }
 
+void TransportMan::WriteFiles(const core::iovec *iov, const size_t iovcnt,
+                              const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+            if (transport->m_Type == "File")
+            {
+                transport->WriteV(iov, static_cast<int>(iovcnt));
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to WriteFiles with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->WriteV(iov, static_cast<int>(iovcnt));
+    }
+}
+
 void TransportMan::WriteFileAt(const char *buffer, const size_t size,
                                const size_t start, const int transportIndex)
 {
@@ -282,6 +309,15 @@ void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
     itTransport->second->Read(buffer, size, start);
 }
 
+const char *TransportMan::ViewFile(const size_t size, const size_t start,
+                                   const size_t transportIndex)
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to ViewFile with index " +
+                               std::to_string(transportIndex));
+    return itTransport->second->View(size, start);
+}
+
 void TransportMan::FlushFiles(const int transportIndex)
 {
     if (transportIndex == -1)
@@ -437,12 +473,34 @@ TransportMan::OpenFileTransport(const std::string &fileName,
                     " transport does not support buffered I/O.");
             }
         }
+        else if (library == "MMap" || library == "mmap")
+        {
+            transport = std::make_shared<transport::FileMMap>(m_Comm);
+            if (lf_GetBuffered("false"))
+            {
+                throw std::invalid_argument(
+                    "ERROR: " + library +
+                    " transport does not support buffered I/O.");
+            }
+        }
 #endif
 #ifdef ADIOS2_HAVE_IME
         else if (library == "IME" || library == "ime")
         {
             transport = std::make_shared<transport::FileIME>(m_Comm);
         }
+#endif
+#ifdef ADIOS2_HAVE_IOURING
+        else if (library == "IOUring" || library == "iouring")
+        {
+            transport = std::make_shared<transport::FileIOUring>(m_Comm);
+            if (lf_GetBuffered("false"))
+            {
+                throw std::invalid_argument(
+                    "ERROR: " + library +
+                    " transport does not support buffered I/O.");
+            }
+        }
 #endif
         else if (library == "NULL" || library == "null")
         {
@@ -118,6 +118,15 @@ public:
     void WriteFiles(const char *buffer, const size_t size,
                     const int transportIndex = -1);
 
+    /**
+     * Write several buffers, one after the other, to file transports
+     * @param iov
+     * @param iovcnt
+     * @param transportIndex
+     */
+    void WriteFiles(const core::iovec *iov, const size_t iovcnt,
+                    const int transportIndex = -1);
+
     /**
      * Write data to a specific location in files
      * @param transportIndex
@@ -139,6 +148,17 @@ public:
     void ReadFile(char *buffer, const size_t size, const size_t start = 0,
                   const size_t transportIndex = 0);
 
+    /**
+     * View contents from a single file without copying, see Transport::View
+     * @param size
+     * @param start
+     * @param transportIndex
+     * @return pointer into the file mapping, nullptr if the transport
+     * doesn't map files and ReadFile must be used
+     */
+    const char *ViewFile(const size_t size, const size_t start = 0,
+                         const size_t transportIndex = 0);
+
     /**
      * Flush file or files depending on transport index. Throws an exception
      * if transport is not a file when transportIndex > -1.
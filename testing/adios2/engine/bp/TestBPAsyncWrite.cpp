@@ -0,0 +1,166 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPAsyncWriteTest : public ::testing::Test
+{
+public:
+    BPAsyncWriteTest() = default;
+};
+
+namespace
+{
+const std::size_t NSteps = 6;
+const std::size_t Nx = 5000;
+
+std::vector<double> StepData(const size_t step, const int mpiRank,
+                             const double offset)
+{
+    std::vector<double> data(Nx);
+    std::iota(data.begin(), data.end(),
+              static_cast<double>(step * Nx + mpiRank * 10 * Nx) + offset);
+    return data;
+}
+
+void WriteFile(const std::string &fname, const adios2::Params &parameters)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine("BP4");
+    io.SetParameters(parameters);
+    // one aggregator per process, aggregated data is written synchronously
+    io.SetParameter("NumAggregators", std::to_string(mpiSize));
+
+    const adios2::Dims shape{static_cast<size_t>(mpiSize) * Nx};
+    const adios2::Dims start{static_cast<size_t>(mpiRank) * Nx};
+    const adios2::Dims count{Nx};
+
+    auto varA = io.DefineVariable<double>("a", shape, start, count);
+    auto varB = io.DefineVariable<double>("b", shape, start, count);
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        const std::vector<double> dataA = StepData(step, mpiRank, 0.);
+        const std::vector<double> dataB = StepData(step, mpiRank, 0.5);
+        bpWriter.BeginStep();
+        bpWriter.Put(varA, dataA.data(), adios2::Mode::Sync);
+        bpWriter.Put(varB, dataB.data(), adios2::Mode::Sync);
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+void ReadFile(const std::string &fname)
+{
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("BP4");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    auto varA = io.InquireVariable<double>("a");
+    auto varB = io.InquireVariable<double>("b");
+    ASSERT_TRUE(varA);
+    ASSERT_TRUE(varB);
+
+    const adios2::Box<adios2::Dims> selection{{mpiRank * Nx}, {Nx}};
+    varA.SetSelection(selection);
+    varB.SetSelection(selection);
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        varA.SetStepSelection({step, 1});
+        varB.SetStepSelection({step, 1});
+        std::vector<double> dataA, dataB;
+        bpReader.Get(varA, dataA, adios2::Mode::Sync);
+        bpReader.Get(varB, dataB, adios2::Mode::Sync);
+        EXPECT_EQ(dataA, StepData(step, mpiRank, 0.));
+        EXPECT_EQ(dataB, StepData(step, mpiRank, 0.5));
+    }
+    bpReader.Close();
+}
+}
+
+TEST_F(BPAsyncWriteTest, WriteRead)
+{
+    const std::string fname("BPAsyncWrite.bp");
+    WriteFile(fname, {{"AsyncWrite", "On"}});
+    ReadFile(fname);
+}
+
+TEST_F(BPAsyncWriteTest, WriteReadMaxBufferSize)
+{
+    // each Put fills the buffer and triggers a flush in the middle of a step
+    const std::string fname("BPAsyncWriteMaxBufferSize.bp");
+    WriteFile(fname, {{"AsyncWrite", "On"}, {"MaxBufferSize", "48Kb"}});
+    ReadFile(fname);
+}
+
+TEST_F(BPAsyncWriteTest, ProfilingOverlap)
+{
+    const std::string fname("BPAsyncWriteProfiling.bp");
+    WriteFile(fname, {{"AsyncWrite", "On"}, {"Profile", "On"}});
+
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+    if (mpiRank == 0)
+    {
+        std::ifstream profilingJSONFile(fname + "/profiling.json");
+        ASSERT_TRUE(profilingJSONFile.good());
+        const std::string profilingJSON(
+            (std::istreambuf_iterator<char>(profilingJSONFile)),
+            std::istreambuf_iterator<char>());
+        EXPECT_NE(profilingJSON.find("\"async_write_mus\""), std::string::npos);
+        EXPECT_NE(profilingJSON.find("\"async_write_wait_mus\""),
+                  std::string::npos);
+        EXPECT_NE(profilingJSON.find("\"async_write_overlap_mus\""),
+                  std::string::npos);
+    }
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
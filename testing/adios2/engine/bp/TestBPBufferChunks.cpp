@@ -0,0 +1,165 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPBufferChunksTest : public ::testing::Test
+{
+public:
+    BPBufferChunksTest() = default;
+};
+
+namespace
+{
+const std::size_t NSteps = 4;
+const std::size_t NVariables = 10;
+const std::size_t Nx = 500;
+
+std::vector<double> StepData(const size_t step, const size_t v,
+                             const int mpiRank)
+{
+    std::vector<double> data(Nx);
+    std::iota(data.begin(), data.end(),
+              static_cast<double>((step * NVariables + v) * Nx +
+                                  mpiRank * 1000 * Nx));
+    return data;
+}
+
+void WriteFile(const std::string &fname, const adios2::Params &parameters)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine("BP4");
+    io.SetParameters(parameters);
+    // chunks are used without aggregation
+    io.SetParameter("NumAggregators", std::to_string(mpiSize));
+
+    const adios2::Dims shape{static_cast<size_t>(mpiSize) * Nx};
+    const adios2::Dims start{static_cast<size_t>(mpiRank) * Nx};
+    const adios2::Dims count{Nx};
+
+    std::vector<adios2::Variable<double>> variables;
+    for (size_t v = 0; v < NVariables; ++v)
+    {
+        variables.push_back(io.DefineVariable<double>(
+            "v" + std::to_string(v), shape, start, count));
+    }
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        std::vector<std::vector<double>> data;
+        for (size_t v = 0; v < NVariables; ++v)
+        {
+            data.push_back(StepData(step, v, mpiRank));
+        }
+
+        bpWriter.BeginStep();
+        // half sync, half deferred
+        for (size_t v = 0; v < NVariables; ++v)
+        {
+            bpWriter.Put(variables[v], data[v].data(),
+                         v % 2 == 0 ? adios2::Mode::Sync
+                                    : adios2::Mode::Deferred);
+        }
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+void ReadFile(const std::string &fname)
+{
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("BP4");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    const adios2::Box<adios2::Dims> selection{{mpiRank * Nx}, {Nx}};
+    for (size_t v = 0; v < NVariables; ++v)
+    {
+        auto var = io.InquireVariable<double>("v" + std::to_string(v));
+        ASSERT_TRUE(var);
+        var.SetSelection(selection);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            std::vector<double> data;
+            bpReader.Get(var, data, adios2::Mode::Sync);
+            EXPECT_EQ(data, StepData(step, v, mpiRank));
+        }
+    }
+    bpReader.Close();
+}
+}
+
+TEST_F(BPBufferChunksTest, WriteRead)
+{
+    const std::string fname("BPBufferChunks.bp");
+    WriteFile(fname, {{"BufferChunkSize", "16Kb"}});
+    ReadFile(fname);
+}
+
+TEST_F(BPBufferChunksTest, WriteReadFlushStepsCount)
+{
+    // steps stay in memory across EndStep and are written every 3 steps
+    const std::string fname("BPBufferChunksFlushStepsCount.bp");
+    WriteFile(fname, {{"BufferChunkSize", "16Kb"}, {"FlushStepsCount", "3"}});
+    ReadFile(fname);
+}
+
+TEST_F(BPBufferChunksTest, WriteReadMaxBufferSize)
+{
+    // chunks are written in the middle of a step when they reach the limit
+    const std::string fname("BPBufferChunksMaxBufferSize.bp");
+    WriteFile(fname, {{"BufferChunkSize", "16Kb"}, {"MaxBufferSize", "40Kb"}});
+    ReadFile(fname);
+}
+
+TEST_F(BPBufferChunksTest, WriteReadAsyncWrite)
+{
+    const std::string fname("BPBufferChunksAsyncWrite.bp");
+    WriteFile(fname, {{"BufferChunkSize", "16Kb"}, {"AsyncWrite", "On"}});
+    ReadFile(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
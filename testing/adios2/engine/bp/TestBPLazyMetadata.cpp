@@ -0,0 +1,179 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPLazyMetadataTest : public ::testing::Test
+{
+public:
+    BPLazyMetadataTest() = default;
+};
+
+namespace
+{
+const std::size_t NSteps = 5;
+const std::size_t Nx = 10;
+
+std::vector<int32_t> StepData(const size_t step, const int mpiRank)
+{
+    std::vector<int32_t> data(Nx);
+    std::iota(data.begin(), data.end(),
+              static_cast<int32_t>(step * 100 + mpiRank * Nx));
+    return data;
+}
+
+void WriteFile(const std::string &fname)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine("BP4");
+
+    const adios2::Dims shape{static_cast<size_t>(mpiSize) * Nx};
+    const adios2::Dims start{static_cast<size_t>(mpiRank) * Nx};
+    const adios2::Dims count{Nx};
+
+    auto var = io.DefineVariable<int32_t>("v", shape, start, count);
+    // only written in odd steps
+    auto varOdd = io.DefineVariable<int32_t>("odd", shape, start, count);
+    auto varStep = io.DefineVariable<uint64_t>("step");
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        const std::vector<int32_t> data = StepData(step, mpiRank);
+        bpWriter.BeginStep();
+        bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+        if (step % 2 == 1)
+        {
+            bpWriter.Put(varOdd, data.data(), adios2::Mode::Sync);
+        }
+        bpWriter.Put(varStep, static_cast<uint64_t>(step));
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+}
+
+TEST_F(BPLazyMetadataTest, ReadSteps)
+{
+    const std::string fname("BPLazyMetadataSteps.bp");
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+
+    WriteFile(fname);
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("BP4");
+    io.SetParameter("LazyMetadata", "On");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    // no metadata is parsed until BeginStep
+    EXPECT_FALSE(io.InquireVariable<int32_t>("v"));
+
+    size_t step = 0;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        EXPECT_EQ(bpReader.CurrentStep(), step);
+
+        auto varStep = io.InquireVariable<uint64_t>("step");
+        ASSERT_TRUE(varStep);
+        uint64_t readStep = 0;
+        bpReader.Get(varStep, readStep, adios2::Mode::Sync);
+        EXPECT_EQ(readStep, step);
+
+        auto var = io.InquireVariable<int32_t>("v");
+        ASSERT_TRUE(var);
+        var.SetSelection({{mpiRank * Nx}, {Nx}});
+        std::vector<int32_t> data;
+        bpReader.Get(var, data, adios2::Mode::Sync);
+        EXPECT_EQ(data, StepData(step, mpiRank));
+
+        auto varOdd = io.InquireVariable<int32_t>("odd");
+        EXPECT_EQ(static_cast<bool>(varOdd), step % 2 == 1);
+
+        bpReader.EndStep();
+        ++step;
+    }
+    EXPECT_EQ(step, NSteps);
+    bpReader.Close();
+}
+
+TEST_F(BPLazyMetadataTest, ReadSelectedSteps)
+{
+    const std::string fname("BPLazyMetadataSelectedSteps.bp");
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+
+    WriteFile(fname);
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("BP4");
+    io.SetParameter("LazyMetadata", "On");
+    io.SetParameter(fname, "1,3");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    auto var = io.InquireVariable<int32_t>("v");
+    ASSERT_TRUE(var);
+    EXPECT_EQ(var.Steps(), 2);
+
+    var.SetSelection({{mpiRank * Nx}, {Nx}});
+    for (size_t s = 0; s < 2; ++s)
+    {
+        std::vector<int32_t> data;
+        var.SetStepSelection({s, 1});
+        bpReader.Get(var, data, adios2::Mode::Sync);
+        EXPECT_EQ(data, StepData(2 * s + 1, mpiRank));
+    }
+    bpReader.Close();
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
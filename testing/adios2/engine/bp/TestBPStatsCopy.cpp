@@ -0,0 +1,236 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <cstdint>
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPStatsCopyTest : public ::testing::Test
+{
+public:
+    BPStatsCopyTest() = default;
+};
+
+namespace
+{
+const std::size_t NSteps = 3;
+const std::size_t Ny = 40;
+const std::size_t Nx = 50;
+
+std::vector<int32_t> IntData(const size_t step, const int mpiRank)
+{
+    std::vector<int32_t> data(Ny * Nx);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<int32_t>((i * 7919 + step * 31) % 1000) -
+                  500 * mpiRank;
+    }
+    return data;
+}
+
+std::vector<double> DoubleData(const size_t step, const int mpiRank)
+{
+    std::vector<double> data(Ny * Nx);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = std::sin(static_cast<double>(i + step)) * (mpiRank + 1);
+    }
+    // a leading NaN does not hide the min/max of the other values
+    data[0] = std::numeric_limits<double>::quiet_NaN();
+    return data;
+}
+
+void WriteFile(const std::string &fname, const adios2::Params &parameters)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine("BP4");
+    io.SetParameters(parameters);
+    io.SetParameter("NumAggregators", std::to_string(mpiSize));
+    io.SetParameter("Profile", "Off");
+
+    const size_t ny = static_cast<size_t>(mpiSize) * Ny;
+    const size_t y0 = static_cast<size_t>(mpiRank) * Ny;
+    auto varI32 =
+        io.DefineVariable<int32_t>("i32", {ny, Nx}, {y0, 0}, {Ny, Nx});
+    auto varF64 =
+        io.DefineVariable<double>("f64", {ny, Nx}, {y0, 0}, {Ny, Nx});
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        const std::vector<int32_t> dataI32 = IntData(step, mpiRank);
+        const std::vector<double> dataF64 = DoubleData(step, mpiRank);
+        bpWriter.BeginStep();
+        bpWriter.Put(varI32, dataI32.data());
+        bpWriter.Put(varF64, dataF64.data());
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+template <class T>
+void ExpectBounds(const std::vector<T> &data, const T min, const T max)
+{
+    T expectedMin = std::numeric_limits<T>::max();
+    T expectedMax = std::numeric_limits<T>::lowest();
+    for (const T value : data)
+    {
+        if (value == value)
+        {
+            expectedMin = std::min(expectedMin, value);
+            expectedMax = std::max(expectedMax, value);
+        }
+    }
+    EXPECT_EQ(min, expectedMin);
+    EXPECT_EQ(max, expectedMax);
+}
+
+void ReadFile(const std::string &fname)
+{
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("BP4");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    auto varI32 = io.InquireVariable<int32_t>("i32");
+    auto varF64 = io.InquireVariable<double>("f64");
+    ASSERT_TRUE(varI32);
+    ASSERT_TRUE(varF64);
+    const adios2::Box<adios2::Dims> selection = {
+        {static_cast<size_t>(mpiRank) * Ny, 0}, {Ny, Nx}};
+    varI32.SetSelection(selection);
+    varF64.SetSelection(selection);
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        varI32.SetStepSelection({step, 1});
+        varF64.SetStepSelection({step, 1});
+
+        std::vector<int32_t> dataI32;
+        std::vector<double> dataF64;
+        bpReader.Get(varI32, dataI32, adios2::Mode::Sync);
+        bpReader.Get(varF64, dataF64, adios2::Mode::Sync);
+        EXPECT_EQ(dataI32, IntData(step, mpiRank));
+        const std::vector<double> expectedF64 = DoubleData(step, mpiRank);
+        ASSERT_EQ(dataF64.size(), expectedF64.size());
+        EXPECT_TRUE(std::isnan(dataF64[0]));
+        for (size_t i = 1; i < dataF64.size(); ++i)
+        {
+            EXPECT_EQ(dataF64[i], expectedF64[i]);
+        }
+
+        const auto blocksI32 = bpReader.BlocksInfo(varI32, step);
+        const auto blocksF64 = bpReader.BlocksInfo(varF64, step);
+        ASSERT_GT(blocksI32.size(), static_cast<size_t>(mpiRank));
+        ASSERT_GT(blocksF64.size(), static_cast<size_t>(mpiRank));
+        ExpectBounds(dataI32, blocksI32[mpiRank].Min, blocksI32[mpiRank].Max);
+        ExpectBounds(dataF64, blocksF64[mpiRank].Min, blocksF64[mpiRank].Max);
+    }
+    bpReader.Close();
+}
+
+std::string FileContents(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+}
+
+void ExpectSameFiles(const std::string &fname1, const std::string &fname2)
+{
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+    const std::string dataFile = "/data." + std::to_string(mpiRank);
+    const std::string contents = FileContents(fname1 + dataFile);
+    EXPECT_FALSE(contents.empty());
+    EXPECT_TRUE(contents == FileContents(fname2 + dataFile));
+    if (mpiRank == 0)
+    {
+        EXPECT_TRUE(FileContents(fname1 + "/md.0") ==
+                    FileContents(fname2 + "/md.0"));
+    }
+}
+}
+
+TEST_F(BPStatsCopyTest, WriteRead)
+{
+    // the statistics are computed while copying the payloads, with and
+    // without non-temporal stores
+    const std::string fname("BPStatsCopy.bp");
+    const std::string fnameNonTemporal("BPStatsCopyNonTemporal.bp");
+    WriteFile(fname, {{"NonTemporalThreshold", "0"}});
+    WriteFile(fnameNonTemporal, {{"NonTemporalThreshold", "1"}});
+    ReadFile(fname);
+    ReadFile(fnameNonTemporal);
+    ExpectSameFiles(fname, fnameNonTemporal);
+}
+
+TEST_F(BPStatsCopyTest, WriteReadSubBlocks)
+{
+    // 7 sub-blocks of 300 elements per block
+    const std::string fname("BPStatsCopySubBlocks.bp");
+    const std::string fnameNonTemporal("BPStatsCopySubBlocksNonTemporal.bp");
+    WriteFile(fname, {{"StatsBlockSize", "300"}, {"Threads", "2"}});
+    WriteFile(fnameNonTemporal, {{"StatsBlockSize", "300"},
+                                 {"NonTemporalThreshold", "1"}});
+    ReadFile(fname);
+    ReadFile(fnameNonTemporal);
+    ExpectSameFiles(fname, fnameNonTemporal);
+}
+
+TEST_F(BPStatsCopyTest, WriteReadZeroCopy)
+{
+    // payloads written from application memory are not copied, their
+    // statistics are computed separately
+    const std::string fname("BPStatsCopyZeroCopy.bp");
+    const std::string fnameCopy("BPStatsCopyZeroCopyOff.bp");
+    WriteFile(fname, {{"ZeroCopyThreshold", "1Kb"}});
+    WriteFile(fnameCopy, {});
+    ReadFile(fname);
+    ExpectSameFiles(fname, fnameCopy);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <tuple>
 
 #include <adios2.h>
 
@@ -17,11 +18,13 @@
 std::string engineName; // comes from command line
 
 // ADIOS2 BP write
-void WriteAggRead1D8(const std::string substreams)
+void WriteAggRead1D8(const std::string substreams,
+                     const std::string aggregationType)
 {
     // Each process would write a 1x8 array and all processes would
     // form a mpiSize * Nx 1D array
-    const std::string fname("BPWriteAggregateRead1D8_" + substreams + ".bp");
+    const std::string fname("BPWriteAggregateRead1D8_" + aggregationType +
+                            substreams + ".bp");
 
     int mpiRank = 0, mpiSize = 1;
     // Number of rows
@@ -41,6 +44,7 @@ void WriteAggRead1D8(const std::string substreams)
         if (mpiSize > 1)
         {
             io.SetParameter("NumAggregators", substreams);
+            io.SetParameter("AggregationType", aggregationType);
         }
 
         // Declare 1D variables (NumOfProcesses * Nx)
@@ -325,11 +329,13 @@ void WriteAggRead1D8(const std::string substreams)
     }
 }
 
-void WriteAggRead2D4x2(const std::string substreams)
+void WriteAggRead2D4x2(const std::string substreams,
+                       const std::string aggregationType)
 {
     // Each process would write a 2x4 array and all processes would
     // form a 2D 2 * (numberOfProcess*Nx) matrix where Nx is 4 here
-    const std::string fname("BPWriteAggregateRead2D2x4_" + substreams + ".bp");
+    const std::string fname("BPWriteAggregateRead2D2x4_" + aggregationType +
+                            substreams + ".bp");
 
     int mpiRank = 0, mpiSize = 1;
     // Number of rows
@@ -354,6 +360,7 @@ void WriteAggRead2D4x2(const std::string substreams)
         {
             const int subStreams = mpiSize / 2;
             io.SetParameter("Substreams", std::to_string(subStreams));
+            io.SetParameter("AggregationType", aggregationType);
         }
 
         // Declare 2D variables (Ny * (NumOfProcesses * Nx))
@@ -636,11 +643,13 @@ void WriteAggRead2D4x2(const std::string substreams)
     }
 }
 
-void WriteAggRead2D2x4(const std::string substreams)
+void WriteAggRead2D2x4(const std::string substreams,
+                       const std::string aggregationType)
 {
     // Each process would write a 4x2 array and all processes would
     // form a 2D 4 * (NumberOfProcess * Nx) matrix where Nx is 2 here
-    const std::string fname("BPWriteAggregateRead2D4x2_" + substreams + ".bp");
+    const std::string fname("BPWriteAggregateRead2D4x2_" + aggregationType +
+                            substreams + ".bp");
 
     int mpiRank = 0, mpiSize = 1;
     // Number of rows
@@ -662,6 +671,12 @@ void WriteAggRead2D2x4(const std::string substreams)
         if (mpiSize > 1)
         {
             io.SetParameter("Substreams", substreams);
+            io.SetParameter("AggregationType", aggregationType);
+            if (substreams == "0")
+            {
+                // two aggregators on each node
+                io.SetParameter("AggregatorsPerNode", "2");
+            }
         }
 
         // Declare 2D variables (4 * (NumberOfProcess * Nx))
@@ -935,7 +950,8 @@ void WriteAggRead2D2x4(const std::string substreams)
     }
 }
 
-class BPWriteAggregateReadTest : public ::testing::TestWithParam<std::string>
+class BPWriteAggregateReadTest
+: public ::testing::TestWithParam<std::tuple<std::string, std::string>>
 {
 public:
     BPWriteAggregateReadTest() = default;
@@ -948,21 +964,24 @@ public:
 
 TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateRead1D8)
 {
-    WriteAggRead1D8(GetParam());
+    WriteAggRead1D8(std::get<0>(GetParam()), std::get<1>(GetParam()));
 }
 
 TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateRead2D2x4)
 {
-    WriteAggRead2D2x4(GetParam());
+    WriteAggRead2D2x4(std::get<0>(GetParam()), std::get<1>(GetParam()));
 }
 
 TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateRead2D4x2)
 {
-    WriteAggRead2D4x2(GetParam());
+    WriteAggRead2D4x2(std::get<0>(GetParam()), std::get<1>(GetParam()));
 }
 
-INSTANTIATE_TEST_SUITE_P(Substreams, BPWriteAggregateReadTest,
-                         ::testing::Values("1", "2", "3", "4", "5", "0"));
+INSTANTIATE_TEST_SUITE_P(
+    Substreams, BPWriteAggregateReadTest,
+    ::testing::Combine(::testing::Values("1", "2", "3", "4", "5", "0",
+                                         "auto"),
+                       ::testing::Values("Chain", "Tree", "Shm")));
 
 int main(int argc, char **argv)
 {
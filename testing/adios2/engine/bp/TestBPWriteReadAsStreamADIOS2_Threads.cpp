@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 #include <adios2.h>
 
@@ -393,6 +394,8 @@ TEST_F(BPWriteReadAsStreamTestADIOS2_Threads, ADIOS2BPWriteRead2D2x4)
         }
 
         io.SetParameter("Threads", "2");
+        // merge the reads of blocks of different variables
+        io.SetParameter("ReadGapSize", "4Kb");
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
         auto var_i8 = io.InquireVariable<int8_t>("i8");
@@ -662,6 +665,7 @@ TEST_F(BPWriteReadAsStreamTestADIOS2_Threads, ADIOS2BPWriteRead2D4x2)
         }
 
         io.SetParameter("Threads", "2");
+        io.SetParameter("PrefetchBufferSize", "1Mb");
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
         auto var_i8 = io.InquireVariable<int8_t>("i8");
@@ -1612,6 +1616,124 @@ TEST_F(BPWriteReadAsStreamTestADIOS2_Threads,
     }
 }
 
+//******************************************************************************
+// 2D blocks of 1100x1000 doubles, large enough to be clipped in parallel
+//******************************************************************************
+
+TEST_F(BPWriteReadAsStreamTestADIOS2_Threads, ADIOS2BPWriteReadLargeBlocks)
+{
+    // Each process writes two 1100x1000 blocks stacked along the rows,
+    // the reader selects all but the outer rows and columns
+    const std::string fname("ADIOS2BPWriteReadAsStream_ThreadsLarge.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows of each block
+    const size_t Ny = 1100;
+    // Number of columns
+    const size_t Nx = 1000;
+
+    // Number of steps
+    const size_t NSteps = 2;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t rows = 2 * Ny * static_cast<size_t>(mpiSize);
+    auto lf_Value = [&](const size_t step, const size_t row, const size_t col) {
+        return static_cast<double>(row * Nx + col) +
+               0.5 * static_cast<double>(step);
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        auto var_r64 = io.DefineVariable<double>("r64", {rows, Nx}, {0, 0},
+                                                 {Ny, Nx});
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("File");
+        }
+        io.SetParameter("Threads", "2");
+        io.AddTransport("file");
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<std::vector<double>> blocks(2,
+                                                std::vector<double>(Ny * Nx));
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t b = 0; b < blocks.size(); ++b)
+            {
+                const size_t row0 =
+                    (2 * static_cast<size_t>(mpiRank) + b) * Ny;
+                for (size_t i = 0; i < Ny * Nx; ++i)
+                {
+                    blocks[b][i] = lf_Value(step, row0 + i / Nx, i % Nx);
+                }
+                var_r64.SetSelection({{row0, 0}, {Ny, Nx}});
+                bpWriter.Put(var_r64, blocks[b].data());
+            }
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        io.SetParameter("Threads", "4");
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> r64((rows - 2) * (Nx - 2));
+        size_t step = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_r64 = io.InquireVariable<double>("r64");
+            EXPECT_TRUE(var_r64);
+            ASSERT_EQ(var_r64.Shape()[0], rows);
+            ASSERT_EQ(var_r64.Shape()[1], Nx);
+
+            var_r64.SetSelection({{1, 1}, {rows - 2, Nx - 2}});
+            bpReader.Get(var_r64, r64.data());
+            bpReader.EndStep();
+
+            size_t mismatches = 0;
+            for (size_t i = 0; i < r64.size(); ++i)
+            {
+                const size_t row = 1 + i / (Nx - 2);
+                const size_t col = 1 + i % (Nx - 2);
+                if (r64[i] != lf_Value(step, row, col))
+                {
+                    ++mismatches;
+                }
+            }
+            EXPECT_EQ(mismatches, 0u) << "step " << step;
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+
+        bpReader.Close();
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
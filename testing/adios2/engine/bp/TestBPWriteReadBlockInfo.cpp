@@ -258,6 +258,10 @@ TEST_F(BPWriteReadBlockInfo, BPWriteReadBlockInfo1D8)
         CheckAllStepsBlockInfo1D<std::complex<double>>(allStepsBlocksInfoCR64,
                                                        NSteps, Nx);
 
+        // repeated queries are served from the reader's block index
+        CheckAllStepsBlockInfo1D<double>(var_r64.AllStepsBlocksInfo(), NSteps,
+                                         Nx);
+
         // TODO: other types
 
         SmallTestData testData;
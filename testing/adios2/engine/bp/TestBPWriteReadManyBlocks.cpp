@@ -0,0 +1,170 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadManyBlocks : public ::testing::Test
+{
+public:
+    BPWriteReadManyBlocks() = default;
+};
+
+namespace
+{
+// blocks per rank in each dimension and block size
+const size_t NBy = 6;
+const size_t NBx = 7;
+const size_t By = 3;
+const size_t Bx = 5;
+const size_t NSteps = 2;
+
+double GlobalValue(const size_t step, const size_t row, const size_t column)
+{
+    return static_cast<double>(step * 1000000 + row * NBx * Bx + column);
+}
+}
+
+// Many small blocks per step, read back through many small boxes crossing
+// block boundaries
+TEST_F(BPWriteReadManyBlocks, ReadBoxes2D)
+{
+    const std::string fname("BPWriteReadManyBlocks2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t ny = static_cast<size_t>(mpiSize) * NBy * By;
+    const size_t nx = NBx * Bx;
+
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        auto var = io.DefineVariable<double>("r64", {ny, nx}, {0, 0}, {By, Bx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> block(By * Bx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t by = 0; by < NBy; ++by)
+            {
+                for (size_t bx = 0; bx < NBx; ++bx)
+                {
+                    const size_t row0 =
+                        (static_cast<size_t>(mpiRank) * NBy + by) * By;
+                    const size_t column0 = bx * Bx;
+                    for (size_t i = 0; i < By; ++i)
+                    {
+                        for (size_t j = 0; j < Bx; ++j)
+                        {
+                            block[i * Bx + j] =
+                                GlobalValue(step, row0 + i, column0 + j);
+                        }
+                    }
+                    var.SetSelection({{row0, column0}, {By, Bx}});
+                    bpWriter.Put(var, block.data(), adios2::Mode::Sync);
+                }
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var);
+        ASSERT_EQ(var.Shape(), adios2::Dims({ny, nx}));
+
+        // single elements, boxes inside one block, across block corners,
+        // whole rows and the entire array
+        const std::vector<adios2::Box<adios2::Dims>> boxes = {
+            {{0, 0}, {1, 1}},
+            {{ny - 1, nx - 1}, {1, 1}},
+            {{1, 1}, {1, 3}},
+            {{By - 1, Bx - 1}, {2, 2}},
+            {{2, 3}, {By * 2 + 1, Bx * 3}},
+            {{ny / 2, 0}, {1, nx}},
+            {{0, nx / 2}, {ny, 1}},
+            {{0, 0}, {ny, nx}}};
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            for (const auto &box : boxes)
+            {
+                var.SetSelection(box);
+                std::vector<double> data;
+                bpReader.Get(var, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), box.second[0] * box.second[1]);
+
+                for (size_t i = 0; i < box.second[0]; ++i)
+                {
+                    for (size_t j = 0; j < box.second[1]; ++j)
+                    {
+                        ASSERT_EQ(data[i * box.second[1] + j],
+                                  GlobalValue(step, box.first[0] + i,
+                                              box.first[1] + j));
+                    }
+                }
+            }
+        }
+        bpReader.Close();
+    }
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,190 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class BPZeroCopyTest : public ::testing::Test
+{
+public:
+    BPZeroCopyTest() = default;
+};
+
+namespace
+{
+const std::size_t NSteps = 4;
+const std::size_t NxLarge = 2000;
+const std::size_t NxSmall = 10;
+
+std::vector<double> StepData(const size_t nx, const size_t step,
+                             const int mpiRank, const double offset)
+{
+    std::vector<double> data(nx);
+    std::iota(data.begin(), data.end(),
+              static_cast<double>(step * nx + mpiRank * 100 * nx) + offset);
+    return data;
+}
+
+void WriteFile(const std::string &fname, const adios2::Params &parameters)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine("BP4");
+    io.SetParameters(parameters);
+    // payload references are used without aggregation
+    io.SetParameter("NumAggregators", std::to_string(mpiSize));
+    io.SetParameter("Profile", "Off");
+
+    auto varA = io.DefineVariable<double>(
+        "a", {static_cast<size_t>(mpiSize) * NxLarge},
+        {static_cast<size_t>(mpiRank) * NxLarge}, {NxLarge});
+    auto varB = io.DefineVariable<double>(
+        "b", {static_cast<size_t>(mpiSize) * NxLarge},
+        {static_cast<size_t>(mpiRank) * NxLarge}, {NxLarge});
+    auto varSmall = io.DefineVariable<double>(
+        "small", {static_cast<size_t>(mpiSize) * NxSmall},
+        {static_cast<size_t>(mpiRank) * NxSmall}, {NxSmall});
+    auto varSync = io.DefineVariable<double>(
+        "sync", {static_cast<size_t>(mpiSize) * NxLarge},
+        {static_cast<size_t>(mpiRank) * NxLarge}, {NxLarge});
+
+    // the same memory is reused at every step
+    std::vector<double> dataA, dataB, dataSmall, dataSync;
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        dataA = StepData(NxLarge, step, mpiRank, 0.);
+        dataB = StepData(NxLarge, step, mpiRank, 0.25);
+        dataSmall = StepData(NxSmall, step, mpiRank, 0.5);
+        dataSync = StepData(NxLarge, step, mpiRank, 0.75);
+
+        bpWriter.BeginStep();
+        bpWriter.Put(varA, dataA.data());
+        bpWriter.Put(varSmall, dataSmall.data());
+        bpWriter.Put(varSync, dataSync.data(), adios2::Mode::Sync);
+        std::fill(dataSync.begin(), dataSync.end(), -1.);
+        bpWriter.Put(varB, dataB.data());
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+void ReadFile(const std::string &fname)
+{
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("BP4");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+    EXPECT_EQ(bpReader.Steps(), NSteps);
+
+    auto lf_Check = [&](const std::string &name, const size_t nx,
+                        const double offset) {
+        auto var = io.InquireVariable<double>(name);
+        ASSERT_TRUE(var);
+        var.SetSelection({{mpiRank * nx}, {nx}});
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            std::vector<double> data;
+            bpReader.Get(var, data, adios2::Mode::Sync);
+            EXPECT_EQ(data, StepData(nx, step, mpiRank, offset));
+        }
+    };
+
+    lf_Check("a", NxLarge, 0.);
+    lf_Check("b", NxLarge, 0.25);
+    lf_Check("small", NxSmall, 0.5);
+    lf_Check("sync", NxLarge, 0.75);
+    bpReader.Close();
+}
+
+std::string FileContents(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+}
+
+void ExpectSameDataFile(const std::string &fname1, const std::string &fname2)
+{
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+    const std::string dataFile = "/data." + std::to_string(mpiRank);
+    const std::string contents = FileContents(fname1 + dataFile);
+    EXPECT_FALSE(contents.empty());
+    EXPECT_TRUE(contents == FileContents(fname2 + dataFile));
+}
+}
+
+TEST_F(BPZeroCopyTest, WriteRead)
+{
+    const std::string fname("BPZeroCopy.bp");
+    const std::string fnameCopy("BPZeroCopyOff.bp");
+    WriteFile(fname, {{"ZeroCopyThreshold", "4Kb"}});
+    WriteFile(fnameCopy, {});
+    ReadFile(fname);
+    ExpectSameDataFile(fname, fnameCopy);
+}
+
+TEST_F(BPZeroCopyTest, WriteReadBufferChunks)
+{
+    // referenced payloads do not fill chunks, so chunks are closed at
+    // different positions than without references
+    const std::string fname("BPZeroCopyBufferChunks.bp");
+    WriteFile(fname,
+              {{"ZeroCopyThreshold", "4Kb"}, {"BufferChunkSize", "16Kb"}});
+    ReadFile(fname);
+}
+
+TEST_F(BPZeroCopyTest, WriteReadFlushStepsCount)
+{
+    // steps that are not flushed at EndStep copy their data
+    const std::string fname("BPZeroCopyFlushStepsCount.bp");
+    WriteFile(fname,
+              {{"ZeroCopyThreshold", "4Kb"}, {"FlushStepsCount", "3"}});
+    ReadFile(fname);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
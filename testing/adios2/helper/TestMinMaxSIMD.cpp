@@ -0,0 +1,322 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <adios2/helper/adiosMath.h>
+#include <adios2/helper/adiosMathSIMD.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using adios2::helper::SIMDLevel;
+
+std::vector<SIMDLevel> Levels()
+{
+    std::vector<SIMDLevel> levels;
+    for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SIMD128,
+                            SIMDLevel::AVX2, SIMDLevel::AVX512})
+    {
+        if (level <= adios2::helper::GetMaxSIMDLevel())
+        {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+/** restores the detected level at the end of a test */
+struct LevelGuard
+{
+    ~LevelGuard()
+    {
+        adios2::helper::SetSIMDLevel(adios2::helper::GetMaxSIMDLevel());
+    }
+};
+
+template <class T>
+std::vector<T> RandomValues(const size_t size, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<long long> distribution(
+        static_cast<long long>(
+            std::max<double>(std::numeric_limits<T>::lowest(), -1e9)),
+        static_cast<long long>(
+            std::min<double>(std::numeric_limits<T>::max(), 1e9)));
+    std::vector<T> values(size);
+    for (auto &value : values)
+    {
+        value = static_cast<T>(distribution(generator));
+        if (!std::numeric_limits<T>::is_integer)
+        {
+            value /= static_cast<T>(7);
+        }
+    }
+    return values;
+}
+
+template <class T>
+void CheckType()
+{
+    LevelGuard guard;
+    std::mt19937 generator(42);
+    const std::vector<size_t> sizes = {1, 2, 3, 15, 16, 17, 63, 64, 65, 127,
+                                       128, 129, 1000, 100003};
+
+    for (const size_t size : sizes)
+    {
+        const std::vector<T> random = RandomValues<T>(size, generator);
+        double sum = 0;
+        double sumSquares = 0;
+        for (const T value : random)
+        {
+            sum += static_cast<double>(value);
+            sumSquares += static_cast<double>(value) * value;
+        }
+
+        // extremes in the middle and at the end of the vectors
+        std::vector<T> values(random);
+        values[size / 2] = std::numeric_limits<T>::lowest();
+        values[size - 1] = std::numeric_limits<T>::max();
+        const auto bounds = std::minmax_element(values.begin(), values.end());
+
+        for (const SIMDLevel level : Levels())
+        {
+            adios2::helper::SetSIMDLevel(level);
+            T min = 0, max = 0;
+            adios2::helper::GetMinMax(values.data(), size, min, max);
+            EXPECT_EQ(min, *bounds.first)
+                << adios2::helper::ToString(level) << " size " << size;
+            EXPECT_EQ(max, *bounds.second)
+                << adios2::helper::ToString(level) << " size " << size;
+
+            double simdSum, simdSumSquares;
+            size_t count;
+            adios2::helper::GetSumSquares(random.data(), size, simdSum,
+                                          simdSumSquares, count);
+            EXPECT_EQ(count, size);
+            // only the summation order differs
+            EXPECT_NEAR(simdSum, sum, 1e-10 * std::sqrt(size * sumSquares));
+            EXPECT_NEAR(simdSumSquares, sumSquares, 1e-10 * sumSquares);
+        }
+    }
+}
+
+template <class T>
+void CheckNaN()
+{
+    LevelGuard guard;
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+
+    for (const SIMDLevel level : Levels())
+    {
+        adios2::helper::SetSIMDLevel(level);
+        const std::string hint = adios2::helper::ToString(level);
+
+        for (const size_t size : {1, 7, 64, 1000})
+        {
+            // leading NaN, previously returned as min and max
+            std::vector<T> values(size, static_cast<T>(3));
+            values[0] = nan;
+            if (size > 1)
+            {
+                values[size - 1] = static_cast<T>(-2);
+            }
+            T min, max;
+            adios2::helper::GetMinMax(values.data(), size, min, max);
+            if (size == 1)
+            {
+                EXPECT_TRUE(std::isnan(min)) << hint;
+                EXPECT_TRUE(std::isnan(max)) << hint;
+            }
+            else
+            {
+                EXPECT_EQ(min, static_cast<T>(-2)) << hint << " " << size;
+                EXPECT_EQ(max, static_cast<T>(3)) << hint << " " << size;
+            }
+
+            // all NaN
+            std::vector<T> nans(size, nan);
+            adios2::helper::GetMinMax(nans.data(), size, min, max);
+            EXPECT_TRUE(std::isnan(min)) << hint << " " << size;
+            EXPECT_TRUE(std::isnan(max)) << hint << " " << size;
+
+            double sum, sumSquares;
+            size_t count;
+            adios2::helper::GetSumSquares(values.data(), size, sum,
+                                          sumSquares, count);
+            EXPECT_EQ(count, size - 1) << hint;
+            if (size > 1)
+            {
+                EXPECT_EQ(sum, 3. * (size - 2) - 2.) << hint;
+                EXPECT_EQ(sumSquares, 9. * (size - 2) + 4.) << hint;
+            }
+        }
+
+        // infinities are values
+        std::vector<T> values(100, nan);
+        values[10] = std::numeric_limits<T>::infinity();
+        values[90] = -std::numeric_limits<T>::infinity();
+        T min, max;
+        adios2::helper::GetMinMax(values.data(), values.size(), min, max);
+        EXPECT_EQ(min, -std::numeric_limits<T>::infinity()) << hint;
+        EXPECT_EQ(max, std::numeric_limits<T>::infinity()) << hint;
+    }
+}
+
+template <class T>
+void CheckCopy()
+{
+    LevelGuard guard;
+    std::mt19937 generator(7);
+
+    for (const size_t size : {1, 17, 129, 100003})
+    {
+        const std::vector<T> values = RandomValues<T>(size, generator);
+        const auto bounds = std::minmax_element(values.begin(), values.end());
+        const size_t bytes = size * sizeof(T);
+
+        for (const SIMDLevel level : Levels())
+        {
+            adios2::helper::SetSIMDLevel(level);
+            const std::string hint = adios2::helper::ToString(level);
+            for (const bool nonTemporal : {false, true})
+            {
+                // unaligned and misaligned to T destinations
+                for (const size_t offset : {size_t(0), size_t(1), sizeof(T)})
+                {
+                    std::vector<char> buffer(bytes + offset + 1, 'x');
+                    T min = 0, max = 0;
+                    adios2::helper::CopyMinMax(values.data(), size,
+                                               buffer.data() + offset, min,
+                                               max, nonTemporal);
+                    EXPECT_EQ(min, *bounds.first) << hint << " " << size;
+                    EXPECT_EQ(max, *bounds.second) << hint << " " << size;
+                    EXPECT_EQ(std::memcmp(buffer.data() + offset,
+                                          values.data(), bytes),
+                              0)
+                        << hint << " " << size << " " << offset;
+                    EXPECT_EQ(buffer[offset + bytes], 'x') << hint;
+                }
+            }
+        }
+    }
+}
+
+} // end anonymous namespace
+
+TEST(ADIOS2MinMaxSIMD, Integers)
+{
+    CheckType<int8_t>();
+    CheckType<int16_t>();
+    CheckType<int32_t>();
+    CheckType<int64_t>();
+    CheckType<uint8_t>();
+    CheckType<uint16_t>();
+    CheckType<uint32_t>();
+    CheckType<uint64_t>();
+}
+
+TEST(ADIOS2MinMaxSIMD, FloatingPoint)
+{
+    CheckType<float>();
+    CheckType<double>();
+}
+
+TEST(ADIOS2MinMaxSIMD, NaN)
+{
+    CheckNaN<float>();
+    CheckNaN<double>();
+}
+
+TEST(ADIOS2MinMaxSIMD, Threads)
+{
+    // merging the chunk results keeps the NaN semantics
+    std::vector<float> values(2000000, std::numeric_limits<float>::quiet_NaN());
+    values[1999999] = 5.f;
+    values[1500000] = -5.f;
+    float min, max;
+    adios2::helper::GetMinMaxThreads(values.data(), values.size(), min, max,
+                                     4);
+    EXPECT_EQ(min, -5.f);
+    EXPECT_EQ(max, 5.f);
+}
+
+TEST(ADIOS2MinMaxSIMD, Copy)
+{
+    CheckCopy<int8_t>();
+    CheckCopy<int32_t>();
+    CheckCopy<uint16_t>();
+    CheckCopy<uint64_t>();
+    CheckCopy<float>();
+    CheckCopy<double>();
+}
+
+TEST(ADIOS2MinMaxSIMD, CopySubblocks)
+{
+    const adios2::Dims count = {40, 50};
+    std::vector<double> values(40 * 50);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = std::cos(static_cast<double>(i) * 0.1) * i;
+    }
+    values[0] = std::numeric_limits<double>::quiet_NaN();
+    std::vector<char> buffer(values.size() * sizeof(double) + 1);
+
+    for (const size_t subblockSize : {size_t(300), size_t(7), size_t(10000)})
+    {
+        const adios2::helper::BlockDivisionInfo info =
+            adios2::helper::DivideBlock(
+                count, subblockSize,
+                adios2::helper::BlockDivisionMethod::Contiguous);
+
+        std::vector<double> minMaxs, copyMinMaxs;
+        double min, max, copyMin, copyMax;
+        adios2::helper::GetMinMaxSubblocks(values.data(), count, info, minMaxs,
+                                           min, max, 1);
+        adios2::helper::CopyMinMaxSubblocks(values.data(), count, info,
+                                            buffer.data() + 1, copyMinMaxs,
+                                            copyMin, copyMax, 2, true);
+        EXPECT_EQ(copyMin, min);
+        EXPECT_EQ(copyMax, max);
+        ASSERT_EQ(copyMinMaxs.size(), minMaxs.size());
+        for (size_t i = 0; i < minMaxs.size(); ++i)
+        {
+            EXPECT_EQ(copyMinMaxs[i], minMaxs[i]) << subblockSize;
+        }
+        EXPECT_EQ(std::memcmp(buffer.data() + 1, values.data(),
+                              values.size() * sizeof(double)),
+                  0);
+    }
+}
+
+TEST(ADIOS2MinMaxSIMD, SetLevel)
+{
+    LevelGuard guard;
+    EXPECT_EQ(adios2::helper::GetSIMDLevel(),
+              adios2::helper::GetMaxSIMDLevel());
+    adios2::helper::SetSIMDLevel(SIMDLevel::Scalar);
+    EXPECT_EQ(adios2::helper::GetSIMDLevel(), SIMDLevel::Scalar);
+    if (adios2::helper::GetMaxSIMDLevel() < SIMDLevel::AVX512)
+    {
+        EXPECT_THROW(adios2::helper::SetSIMDLevel(SIMDLevel::AVX512),
+                     std::invalid_argument);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,321 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <algorithm>
+#include <complex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <adios2/helper/adiosMemory.h>
+#include <adios2/helper/adiosThreadPool.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using adios2::Dims;
+
+/** linear index of point in a box of memory */
+size_t LinearIndex(const Dims &point, const Dims &memStart,
+                   const Dims &memCount, const bool isRowMajor)
+{
+    size_t index = 0;
+    size_t stride = 1;
+    const size_t dimensions = point.size();
+    for (size_t i = 0; i < dimensions; ++i)
+    {
+        const size_t d = isRowMajor ? dimensions - 1 - i : i;
+        index += (point[d] - memStart[d]) * stride;
+        stride *= memCount[d];
+    }
+    return index;
+}
+
+/** NdCopy reference, element by element */
+template <class T>
+void ReferenceCopy(const char *in, const Dims &inStart, const Dims &inCount,
+                   const bool inIsRowMajor, const Dims &inMemStart,
+                   const Dims &inMemCount, char *out, const Dims &outStart,
+                   const Dims &outCount, const bool outIsRowMajor,
+                   const Dims &outMemStart, const Dims &outMemCount,
+                   const bool reverseEndian)
+{
+    const size_t dimensions = inStart.size();
+    Dims start(dimensions);
+    Dims end(dimensions);
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+        start[d] = std::max(inStart[d], outStart[d]);
+        end[d] = std::min(inStart[d] + inCount[d], outStart[d] + outCount[d]);
+        if (end[d] <= start[d])
+        {
+            return;
+        }
+    }
+
+    Dims point(start);
+    while (true)
+    {
+        const char *inElement =
+            in + LinearIndex(point, inMemStart, inMemCount, inIsRowMajor) *
+                     sizeof(T);
+        char *outElement =
+            out + LinearIndex(point, outMemStart, outMemCount, outIsRowMajor) *
+                      sizeof(T);
+        for (size_t b = 0; b < sizeof(T); ++b)
+        {
+            outElement[b] =
+                reverseEndian ? inElement[sizeof(T) - 1 - b] : inElement[b];
+        }
+
+        size_t d = dimensions;
+        while (true)
+        {
+            if (d == 0)
+            {
+                return;
+            }
+            --d;
+            if (++point[d] < end[d])
+            {
+                break;
+            }
+            point[d] = start[d];
+        }
+    }
+}
+
+/** random boxes of 1 to 5 dimensions in every major and endianness */
+template <class T>
+void CheckRandomCopies()
+{
+    std::mt19937 generator(42);
+    for (size_t c = 0; c < 2000; ++c)
+    {
+        const size_t dimensions = 1 + generator() % 5;
+        const bool inIsRowMajor = generator() % 2 != 0;
+        const bool outIsRowMajor = generator() % 2 != 0;
+        const bool inIsLittleEndian = generator() % 2 != 0;
+        const bool outIsLittleEndian = generator() % 2 != 0;
+        const bool memorySelection = generator() % 3 == 0;
+
+        Dims inStart(dimensions), inCount(dimensions);
+        Dims outStart(dimensions), outCount(dimensions);
+        for (size_t d = 0; d < dimensions; ++d)
+        {
+            inStart[d] = generator() % 4;
+            inCount[d] = 1 + generator() % 5;
+            outStart[d] = generator() % 4;
+            outCount[d] = 1 + generator() % 5;
+        }
+        Dims inMemStart(inStart), inMemCount(inCount);
+        Dims outMemStart(outStart), outMemCount(outCount);
+        if (memorySelection)
+        {
+            // boxes inside larger buffers
+            for (size_t d = 0; d < dimensions; ++d)
+            {
+                inMemStart[d] -= std::min<size_t>(inStart[d], generator() % 2);
+                inMemCount[d] += inStart[d] - inMemStart[d] + generator() % 2;
+                outMemStart[d] -=
+                    std::min<size_t>(outStart[d], generator() % 2);
+                outMemCount[d] +=
+                    outStart[d] - outMemStart[d] + generator() % 2;
+            }
+        }
+
+        std::vector<char> in(adios2::helper::GetTotalSize(inMemCount) *
+                             sizeof(T));
+        for (char &byte : in)
+        {
+            byte = static_cast<char>(generator());
+        }
+        std::vector<char> expected(
+            adios2::helper::GetTotalSize(outMemCount) * sizeof(T), 0);
+        std::vector<char> out(expected);
+
+        ReferenceCopy<T>(in.data(), inStart, inCount, inIsRowMajor,
+                         inMemStart, inMemCount, expected.data(), outStart,
+                         outCount, outIsRowMajor, outMemStart, outMemCount,
+                         inIsLittleEndian != outIsLittleEndian);
+        if (memorySelection)
+        {
+            adios2::helper::NdCopy<T>(
+                in.data(), inStart, inCount, inIsRowMajor, inIsLittleEndian,
+                out.data(), outStart, outCount, outIsRowMajor,
+                outIsLittleEndian, inMemStart, inMemCount, outMemStart,
+                outMemCount);
+        }
+        else
+        {
+            adios2::helper::NdCopy<T>(in.data(), inStart, inCount,
+                                      inIsRowMajor, inIsLittleEndian,
+                                      out.data(), outStart, outCount,
+                                      outIsRowMajor, outIsLittleEndian);
+        }
+        ASSERT_EQ(out, expected) << "copy " << c << " of " << dimensions
+                                 << " dimensions";
+    }
+}
+
+} // end anonymous namespace
+
+TEST(ADIOS2NdCopy, Random)
+{
+    CheckRandomCopies<int8_t>();
+    CheckRandomCopies<int16_t>();
+    CheckRandomCopies<float>();
+    CheckRandomCopies<double>();
+    CheckRandomCopies<std::complex<double>>();
+}
+
+TEST(ADIOS2NdCopy, NoOverlap)
+{
+    const std::vector<float> in(4, 1);
+    std::vector<float> out(4, 0);
+    EXPECT_EQ(adios2::helper::NdCopy<float>(
+                  reinterpret_cast<const char *>(in.data()), {0, 0}, {2, 2},
+                  true, true, reinterpret_cast<char *>(out.data()), {2, 0},
+                  {2, 2}, true, true),
+              1);
+    EXPECT_EQ(out, std::vector<float>(4, 0));
+}
+
+TEST(ADIOS2NdCopy, PlanCache)
+{
+    // a 4x4 array assembled from four 2x2 blocks, two "steps"
+    const std::vector<int32_t> block = {1, 2, 3, 4};
+    const Dims blockCount = {2, 2};
+    const std::vector<Dims> blockStarts = {{0, 0}, {0, 2}, {2, 0}, {2, 2}};
+    const std::vector<int32_t> expected = {1, 2, 1, 2, 3, 4, 3, 4,
+                                           1, 2, 1, 2, 3, 4, 3, 4};
+
+    adios2::helper::NdCopyPlanCache cache;
+    for (size_t step = 0; step < 2; ++step)
+    {
+        std::vector<int32_t> out(16, 0);
+        cache.Rewind();
+        for (const Dims &blockStart : blockStarts)
+        {
+            const adios2::helper::NdCopyPlan &plan =
+                cache.Get(blockStart, blockCount, true, true, {0, 0}, {4, 4},
+                          true, true, sizeof(int32_t));
+            EXPECT_TRUE(plan.HasOverlap());
+            plan.Execute(reinterpret_cast<const char *>(block.data()),
+                         reinterpret_cast<char *>(out.data()));
+        }
+        EXPECT_EQ(out, expected);
+    }
+
+    // a different selection at the same position builds a new plan
+    std::vector<int32_t> out(4, 0);
+    cache.Rewind();
+    cache
+        .Get({0, 2}, blockCount, true, true, {0, 2}, {2, 2}, true, true,
+             sizeof(int32_t))
+        .Execute(reinterpret_cast<const char *>(block.data()),
+                 reinterpret_cast<char *>(out.data()));
+    EXPECT_EQ(out, block);
+}
+
+TEST(ADIOS2NdCopy, Threads)
+{
+    auto pool = adios2::helper::ThreadPool::Acquire(4);
+
+    // clips of 2M elements, above the threshold for threads, in every major
+    // and endianness, with a single run or loops to split
+    const std::vector<Dims> inCounts = {{2000002}, {130, 130, 130}};
+    for (const Dims &inCount : inCounts)
+    {
+        const Dims inStart(inCount.size(), 0);
+        const Dims outStart(inCount.size(), 1);
+        Dims outCount(inCount);
+        for (size_t &count : outCount)
+        {
+            count -= 2;
+        }
+
+        std::vector<float> in(adios2::helper::GetTotalSize(inCount));
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            in[i] = static_cast<float>(i);
+        }
+        const char *inData = reinterpret_cast<const char *>(in.data());
+
+        for (const bool outIsRowMajor : {true, false})
+        {
+            for (const bool outIsLittleEndian : {true, false})
+            {
+                std::vector<float> expected(
+                    adios2::helper::GetTotalSize(outCount));
+                std::vector<float> out(expected.size());
+                adios2::helper::NdCopy<float>(
+                    inData, inStart, inCount, true, true,
+                    reinterpret_cast<char *>(expected.data()), outStart,
+                    outCount, outIsRowMajor, outIsLittleEndian);
+                adios2::helper::NdCopy<float>(
+                    inData, inStart, inCount, true, true,
+                    reinterpret_cast<char *>(out.data()), outStart, outCount,
+                    outIsRowMajor, outIsLittleEndian, Dims(), Dims(), Dims(),
+                    Dims(), false, 4);
+                EXPECT_EQ(out, expected);
+            }
+        }
+    }
+}
+
+TEST(ADIOS2NdCopy, ClipThreads)
+{
+    auto pool = adios2::helper::ThreadPool::Acquire(4);
+
+    // a 130^3 block clipped by one element on each side into a selection,
+    // the payload holds the intersection as BP files do
+    const Dims blockStart = {0, 0, 0};
+    const Dims blockCount = {130, 130, 130};
+    const Dims selectionStart = {1, 1, 1};
+    const Dims selectionCount = {128, 128, 128};
+    const adios2::Box<Dims> blockBox =
+        adios2::helper::StartEndBox(blockStart, blockCount);
+
+    for (const bool isRowMajor : {true, false})
+    {
+        const adios2::Box<Dims> intersectionBox =
+            adios2::helper::IntersectionBox(
+                blockBox,
+                adios2::helper::StartEndBox(selectionStart, selectionCount));
+
+        std::vector<double> block(adios2::helper::GetTotalSize(blockCount));
+        for (size_t i = 0; i < block.size(); ++i)
+        {
+            block[i] = static_cast<double>(i);
+        }
+        const char *payload =
+            reinterpret_cast<const char *>(block.data()) +
+            adios2::helper::LinearIndex(blockBox, intersectionBox.first,
+                                        isRowMajor) *
+                sizeof(double);
+
+        std::vector<double> expected(
+            adios2::helper::GetTotalSize(selectionCount));
+        std::vector<double> out(expected.size());
+        adios2::helper::ClipContiguousMemory(
+            expected.data(), selectionStart, selectionCount, payload, blockBox,
+            intersectionBox, isRowMajor);
+        adios2::helper::ClipContiguousMemory(
+            out.data(), selectionStart, selectionCount, payload, blockBox,
+            intersectionBox, isRowMajor, false, false, 4);
+        EXPECT_EQ(expected.front(), 1 + 130 + 130 * 130);
+        EXPECT_EQ(out, expected);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
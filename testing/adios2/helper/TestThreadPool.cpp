@@ -0,0 +1,167 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <adios2.h>
+#include <adios2/helper/adiosMath.h>
+#include <adios2/helper/adiosMemory.h>
+#include <adios2/helper/adiosThreadPool.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+void CheckCoverage(adios2::helper::ThreadPool &pool, const size_t size,
+                   const size_t chunks)
+{
+    std::vector<std::atomic<int>> visits(size);
+    for (auto &visit : visits)
+    {
+        visit = 0;
+    }
+    std::vector<std::atomic<int>> chunkVisits(chunks);
+    for (auto &visit : chunkVisits)
+    {
+        visit = 0;
+    }
+
+    const size_t n = std::min(chunks, size);
+    pool.ParallelFor(
+        size, chunks, [&](const size_t chunk, const size_t begin,
+                          const size_t end) {
+            EXPECT_LT(chunk, n);
+            EXPECT_EQ(begin, chunk * size / n);
+            EXPECT_EQ(end, (chunk + 1) * size / n);
+            ++chunkVisits[chunk];
+            for (size_t i = begin; i < end; ++i)
+            {
+                ++visits[i];
+            }
+        });
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+    for (size_t c = 0; c < chunks; ++c)
+    {
+        EXPECT_EQ(chunkVisits[c].load(), c < n ? 1 : 0) << "chunk " << c;
+    }
+}
+} // end anonymous namespace
+
+TEST(ADIOS2ThreadPool, ParallelForCoverage)
+{
+    adios2::helper::ThreadPool pool(4);
+    EXPECT_EQ(pool.Size(), 4u);
+
+    CheckCoverage(pool, 1000, 7);
+    CheckCoverage(pool, 5, 16);
+    CheckCoverage(pool, 0, 4);
+    CheckCoverage(pool, 100, 1);
+
+    adios2::helper::ThreadPool serial(1);
+    CheckCoverage(serial, 1000, 7);
+}
+
+TEST(ADIOS2ThreadPool, NestedParallelFor)
+{
+    adios2::helper::ThreadPool pool(3);
+    std::atomic<size_t> sum(0);
+
+    pool.ParallelFor(8, 8, [&](const size_t, const size_t begin,
+                               const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            pool.ParallelFor(100, 8, [&](const size_t, const size_t innerBegin,
+                                         const size_t innerEnd) {
+                for (size_t j = innerBegin; j < innerEnd; ++j)
+                {
+                    sum += i * 100 + j;
+                }
+            });
+        }
+    });
+
+    EXPECT_EQ(sum.load(), 799 * 800 / 2);
+}
+
+TEST(ADIOS2ThreadPool, Exception)
+{
+    adios2::helper::ThreadPool pool(4);
+    std::atomic<int> chunks(0);
+
+    EXPECT_THROW(pool.ParallelFor(
+                     100, 10,
+                     [&](const size_t chunk, const size_t, const size_t) {
+                         ++chunks;
+                         if (chunk == 5)
+                         {
+                             throw std::runtime_error("chunk 5 failed");
+                         }
+                     }),
+                 std::runtime_error);
+
+    // all other chunks still ran
+    EXPECT_EQ(chunks.load(), 10);
+}
+
+TEST(ADIOS2ThreadPool, ProcessPool)
+{
+    const std::string configFile("TestThreadPool.xml");
+    {
+        std::ofstream config(configFile);
+        config << "<?xml version=\"1.0\"?>\n"
+               << "<adios-config>\n"
+               << "    <parameter key=\"ThreadPoolSize\" value=\"3\"/>\n"
+               << "</adios-config>\n";
+    }
+
+    EXPECT_EQ(adios2::helper::ThreadPool::Current(), nullptr);
+    {
+        adios2::ADIOS adios(configFile);
+        auto pool = adios2::helper::ThreadPool::Current();
+        ASSERT_NE(pool, nullptr);
+        EXPECT_EQ(pool->Size(), 3u);
+
+        // shared with the next ADIOS object
+        adios2::ADIOS other;
+        EXPECT_EQ(adios2::helper::ThreadPool::Current(), pool);
+
+        std::vector<double> values(2000000);
+        std::iota(values.begin(), values.end(), -1000000.);
+        values[1234567] = 1e9;
+        values[765] = -1e9;
+
+        double min, max, serialMin, serialMax;
+        adios2::helper::GetMinMax(values.data(), values.size(), serialMin,
+                                  serialMax);
+        adios2::helper::GetMinMaxThreads(values.data(), values.size(), min,
+                                         max, 4);
+        EXPECT_EQ(min, serialMin);
+        EXPECT_EQ(max, serialMax);
+
+        std::vector<char> buffer(values.size() * sizeof(double));
+        size_t position = 0;
+        adios2::helper::CopyToBufferThreads(buffer, position, values.data(),
+                                            values.size(), 4);
+        EXPECT_EQ(position, buffer.size());
+        EXPECT_EQ(std::memcmp(buffer.data(), values.data(), buffer.size()), 0);
+    }
+    // released with the last ADIOS object
+    EXPECT_EQ(adios2::helper::ThreadPool::Current(), nullptr);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Measures the time BP4 EndStep spends writing a step with aggregation, for
+ * each AggregationType, to compare how they scale with the number of
+ * processes per aggregator:
+ *   mpirun -n 128 ./PerfAggregation --num_aggregators 1 --size_kb 1024
+ */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <mpi.h>
+
+int NSteps = 10;
+size_t SizeKB = 1024;
+std::string NumAggregators = "1";
+std::vector<std::string> AggregationTypes = {"Chain", "Tree", "Shm"};
+
+static void Usage()
+{
+    std::cout << "PerfAggregation <opt args> " << std::endl;
+    std::cout << "  --num_steps <steps>" << std::endl;
+    std::cout << "  --size_kb <KB written per process and step>" << std::endl;
+    std::cout << "  --num_aggregators <aggregators, 0: one per node>"
+              << std::endl;
+    std::cout << "  --aggregation_type <Chain|Tree|Shm, default: all>"
+              << std::endl;
+}
+
+static void ParseArgs(int argc, char **argv, int rank)
+{
+    while (argc > 2)
+    {
+        const std::string arg(argv[1]);
+        std::istringstream ss(argv[2]);
+        if (arg == "--num_steps")
+        {
+            if (!(ss >> NSteps))
+                std::cerr << "Invalid number for num_steps " << argv[2]
+                          << '\n';
+        }
+        else if (arg == "--size_kb")
+        {
+            if (!(ss >> SizeKB))
+                std::cerr << "Invalid number for size_kb " << argv[2] << '\n';
+        }
+        else if (arg == "--num_aggregators")
+        {
+            NumAggregators = std::string(argv[2]);
+        }
+        else if (arg == "--aggregation_type")
+        {
+            AggregationTypes = {std::string(argv[2])};
+        }
+        else
+        {
+            if (rank == 0)
+                Usage();
+            throw std::invalid_argument("Unknown argument \"" + arg + "\"");
+        }
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc > 1)
+    {
+        if (rank == 0)
+            Usage();
+        exit(0);
+    }
+}
+
+/** @return slowest process EndStep time per step in seconds */
+double DoWriter(const std::string &aggregationType)
+{
+    int mpiRank = 0, mpiSize = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+
+    const size_t Nx = SizeKB * 1024 / sizeof(double);
+    std::vector<double> data(Nx, static_cast<double>(mpiRank));
+
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    adios2::IO io = adios.DeclareIO("PerfAggregation");
+    io.SetEngine("BP4");
+    io.SetParameter("NumAggregators", NumAggregators);
+    io.SetParameter("AggregationType", aggregationType);
+    io.SetParameter("Profile", "Off");
+
+    auto var = io.DefineVariable<double>(
+        "data", {static_cast<size_t>(mpiSize) * Nx},
+        {static_cast<size_t>(mpiRank) * Nx}, {Nx});
+
+    adios2::Engine writer = io.Open(
+        "PerfAggregation_" + aggregationType + ".bp", adios2::Mode::Write);
+
+    std::chrono::duration<double> elapsed(0);
+    for (int step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        writer.Put(var, data.data());
+        MPI_Barrier(MPI_COMM_WORLD);
+        const auto start = std::chrono::steady_clock::now();
+        writer.EndStep();
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+    writer.Close();
+
+    double local = elapsed.count() / NSteps;
+    double slowest = 0.;
+    MPI_Reduce(&local, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    return slowest;
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int rank = 0, size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    ParseArgs(argc, argv, rank);
+
+    for (const std::string &aggregationType : AggregationTypes)
+    {
+        const double seconds = DoWriter(aggregationType);
+        if (rank == 0)
+        {
+            std::cout << "AggregationType=" << aggregationType
+                      << ", Processes=" << size
+                      << ", NumAggregators=" << NumAggregators
+                      << ", SizeKB=" << SizeKB << ", EndStep Time "
+                      << seconds << " seconds per step." << std::endl;
+        }
+    }
+
+    MPI_Finalize();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Measures the throughput of the statistics kernels of adiosMathSIMD.h at
+ * each SIMD level supported by the CPU, for each vectorized type. The copy
+ * columns compare a memcpy followed by GetMinMax with the fused CopyMinMax,
+ * with and without non-temporal stores:
+ *   ./PerfMinMax --size_mb 256 --repeat 10
+ */
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <adios2/helper/adiosMath.h>
+#include <adios2/helper/adiosMathSIMD.h>
+
+size_t SizeMB = 256;
+int Repeat = 10;
+
+static void Usage()
+{
+    std::cout << "PerfMinMax <opt args> " << std::endl;
+    std::cout << "  --size_mb <MB of values per type>" << std::endl;
+    std::cout << "  --repeat <calls per measurement>" << std::endl;
+}
+
+static void ParseArgs(int argc, char **argv)
+{
+    while (argc > 2)
+    {
+        const std::string arg(argv[1]);
+        std::istringstream ss(argv[2]);
+        if (arg == "--size_mb")
+        {
+            if (!(ss >> SizeMB))
+                std::cerr << "Invalid number for size_mb " << argv[2] << '\n';
+        }
+        else if (arg == "--repeat")
+        {
+            if (!(ss >> Repeat))
+                std::cerr << "Invalid number for repeat " << argv[2] << '\n';
+        }
+        else
+        {
+            Usage();
+            exit(1);
+        }
+        argv += 2;
+        argc -= 2;
+    }
+}
+
+/** best of Repeat calls, in GB/s */
+template <class F>
+static double Throughput(const size_t bytes, F &&function)
+{
+    double best = 0;
+    for (int r = 0; r < Repeat; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::max(best, bytes / elapsed.count() / 1e9);
+    }
+    return best;
+}
+
+template <class T>
+static void Measure(const std::string &type)
+{
+    const size_t size = SizeMB * 1024 * 1024 / sizeof(T);
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<T>((i * 2654435761u) % 1000);
+    }
+    const size_t bytes = size * sizeof(T);
+    std::vector<char> destination(bytes);
+
+    // reference: the generic std::minmax_element used before
+    volatile T sink;
+    const double reference = Throughput(bytes, [&]() {
+        const auto bounds = std::minmax_element(values.begin(), values.end());
+        sink = *bounds.first;
+    });
+    std::cout << std::setw(10) << type << std::setw(10) << "minmax_el"
+              << std::fixed << std::setprecision(2) << std::setw(12)
+              << reference << std::setw(12) << "-" << std::setw(12) << "-"
+              << std::setw(12) << "-" << std::setw(12) << "-" << std::endl;
+
+    for (const auto level :
+         {adios2::helper::SIMDLevel::Scalar, adios2::helper::SIMDLevel::SIMD128,
+          adios2::helper::SIMDLevel::AVX2, adios2::helper::SIMDLevel::AVX512})
+    {
+        if (level > adios2::helper::GetMaxSIMDLevel())
+        {
+            break;
+        }
+        adios2::helper::SetSIMDLevel(level);
+
+        T min, max;
+        const double minMax = Throughput(bytes, [&]() {
+            adios2::helper::GetMinMax(values.data(), size, min, max);
+        });
+
+        double sum, sumSquares;
+        size_t count;
+        const double sums = Throughput(bytes, [&]() {
+            adios2::helper::GetSumSquares(values.data(), size, sum, sumSquares,
+                                          count);
+        });
+
+        const double copyThenMinMax = Throughput(bytes, [&]() {
+            std::memcpy(destination.data(), values.data(), bytes);
+            adios2::helper::GetMinMax(values.data(), size, min, max);
+        });
+
+        const double copyMinMax = Throughput(bytes, [&]() {
+            adios2::helper::CopyMinMax(values.data(), size, destination.data(),
+                                       min, max, false);
+        });
+
+        const double copyMinMaxNT = Throughput(bytes, [&]() {
+            adios2::helper::CopyMinMax(values.data(), size, destination.data(),
+                                       min, max, true);
+        });
+
+        std::cout << std::setw(10) << type << std::setw(10)
+                  << adios2::helper::ToString(level) << std::setw(12) << minMax
+                  << std::setw(12) << sums << std::setw(12) << copyThenMinMax
+                  << std::setw(12) << copyMinMax << std::setw(12)
+                  << copyMinMaxNT << std::endl;
+    }
+    adios2::helper::SetSIMDLevel(adios2::helper::GetMaxSIMDLevel());
+}
+
+int main(int argc, char **argv)
+{
+    ParseArgs(argc, argv);
+
+    std::cout << "Best of " << Repeat << " calls on " << SizeMB
+              << " MB, in GB/s" << std::endl;
+    std::cout << std::setw(10) << "type" << std::setw(10) << "level"
+              << std::setw(12) << "min/max" << std::setw(12) << "sum/sq"
+              << std::setw(12) << "memcpy+mm" << std::setw(12) << "copy_mm"
+              << std::setw(12) << "copy_mm_nt" << std::endl;
+
+    Measure<int8_t>("int8_t");
+    Measure<int16_t>("int16_t");
+    Measure<int32_t>("int32_t");
+    Measure<int64_t>("int64_t");
+    Measure<uint8_t>("uint8_t");
+    Measure<uint16_t>("uint16_t");
+    Measure<uint32_t>("uint32_t");
+    Measure<uint64_t>("uint64_t");
+    Measure<float>("float");
+    Measure<double>("double");
+
+    return 0;
+}
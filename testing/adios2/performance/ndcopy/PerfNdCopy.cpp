@@ -0,0 +1,292 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Measures the throughput of helper::NdCopy for 1 to 5 dimensions, clipping
+ * a large block by one element on each side, and copying many small blocks
+ * into one array as readers do. Columns: NdCopy building its plan at each
+ * call, a NdCopyPlan built once, reversed endianness, column-major output and
+ * NdCopy on Threads threads, splitting clips or sharing blocks as BP4 does:
+ *   ./PerfNdCopy --size_mb 256 --repeat 10 --block 8 --threads 4
+ */
+#include <cmath>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <adios2/helper/adiosMemory.h>
+#include <adios2/helper/adiosThreadPool.h>
+
+size_t SizeMB = 256;
+int Repeat = 10;
+size_t Block = 8;
+unsigned int Threads = 4;
+
+using adios2::Dims;
+
+static void Usage()
+{
+    std::cout << "PerfNdCopy <opt args> " << std::endl;
+    std::cout << "  --size_mb <MB of the copied array>" << std::endl;
+    std::cout << "  --repeat <calls per measurement>" << std::endl;
+    std::cout << "  --block <elements per dimension of small blocks>"
+              << std::endl;
+    std::cout << "  --threads <threads of the threaded copies>" << std::endl;
+}
+
+static void ParseArgs(int argc, char **argv)
+{
+    while (argc > 2)
+    {
+        const std::string arg(argv[1]);
+        std::istringstream ss(argv[2]);
+        if (arg == "--size_mb")
+        {
+            if (!(ss >> SizeMB))
+                std::cerr << "Invalid number for size_mb " << argv[2] << '\n';
+        }
+        else if (arg == "--repeat")
+        {
+            if (!(ss >> Repeat))
+                std::cerr << "Invalid number for repeat " << argv[2] << '\n';
+        }
+        else if (arg == "--block")
+        {
+            if (!(ss >> Block) || Block == 0)
+                std::cerr << "Invalid number for block " << argv[2] << '\n';
+        }
+        else if (arg == "--threads")
+        {
+            if (!(ss >> Threads) || Threads == 0)
+                std::cerr << "Invalid number for threads " << argv[2] << '\n';
+        }
+        else
+        {
+            Usage();
+            exit(1);
+        }
+        argv += 2;
+        argc -= 2;
+    }
+}
+
+/** best of Repeat calls, in GB/s */
+template <class F>
+static double Throughput(const size_t bytes, F &&function)
+{
+    double best = 0;
+    for (int r = 0; r < Repeat; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::max(best, bytes / elapsed.count() / 1e9);
+    }
+    return best;
+}
+
+static size_t Product(const Dims &dimensions)
+{
+    size_t product = 1;
+    for (const size_t d : dimensions)
+    {
+        product *= d;
+    }
+    return product;
+}
+
+static void Print(const std::string &copy, const size_t dimensions,
+                  const double ndCopy, const double plan, const double swap,
+                  const double columnMajor, const double threaded)
+{
+    std::cout << std::setw(8) << copy << std::setw(6) << dimensions
+              << std::fixed << std::setprecision(2) << std::setw(12) << ndCopy
+              << std::setw(12) << plan << std::setw(12) << swap
+              << std::setw(12) << columnMajor << std::setw(12) << threaded
+              << std::endl;
+}
+
+/** a block of about SizeMB clipped by one element on each side */
+static void MeasureClip(const size_t dimensions)
+{
+    typedef float T;
+    const size_t elements = SizeMB * 1024 * 1024 / sizeof(T);
+    const size_t side = std::max(static_cast<size_t>(std::pow(
+                                     static_cast<double>(elements),
+                                     1.0 / static_cast<double>(dimensions))),
+                                 static_cast<size_t>(3));
+    const Dims inStart(dimensions, 0);
+    const Dims inCount(dimensions, side);
+    const Dims outStart(dimensions, 1);
+    const Dims outCount(dimensions, side - 2);
+
+    std::vector<T> in(Product(inCount), 1);
+    std::vector<T> out(Product(outCount));
+    const char *inData = reinterpret_cast<const char *>(in.data());
+    char *outData = reinterpret_cast<char *>(out.data());
+    const size_t bytes = out.size() * sizeof(T);
+
+    const double ndCopy = Throughput(bytes, [&]() {
+        adios2::helper::NdCopy<T>(inData, inStart, inCount, true, true,
+                                  outData, outStart, outCount, true, true);
+    });
+
+    const adios2::helper::NdCopyPlan plan(inStart, inCount, true, true,
+                                          outStart, outCount, true, true,
+                                          sizeof(T));
+    const double planned =
+        Throughput(bytes, [&]() { plan.Execute(inData, outData); });
+
+    const double swap = Throughput(bytes, [&]() {
+        adios2::helper::NdCopy<T>(inData, inStart, inCount, true, true,
+                                  outData, outStart, outCount, true, false);
+    });
+
+    const double columnMajor = Throughput(bytes, [&]() {
+        adios2::helper::NdCopy<T>(inData, inStart, inCount, true, true,
+                                  outData, outStart, outCount, false, true);
+    });
+
+    const double threaded = Throughput(bytes, [&]() {
+        adios2::helper::NdCopy<T>(inData, inStart, inCount, true, true,
+                                  outData, outStart, outCount, true, true,
+                                  Dims(), Dims(), Dims(), Dims(), false,
+                                  Threads);
+    });
+
+    Print("clip", dimensions, ndCopy, planned, swap, columnMajor, threaded);
+}
+
+/** an array of about SizeMB assembled from blocks of Block^dimensions */
+static void MeasureBlocks(const size_t dimensions)
+{
+    typedef float T;
+    const size_t elements = SizeMB * 1024 * 1024 / sizeof(T);
+    const size_t blockElements = static_cast<size_t>(
+        std::pow(static_cast<double>(Block), static_cast<double>(dimensions)));
+    const size_t blocksPerSide = std::max(
+        static_cast<size_t>(std::pow(
+            static_cast<double>(elements / std::max(blockElements,
+                                                    static_cast<size_t>(1))),
+            1.0 / static_cast<double>(dimensions))),
+        static_cast<size_t>(1));
+
+    const Dims outStart(dimensions, 0);
+    const Dims outCount(dimensions, Block * blocksPerSide);
+    const Dims blockCount(dimensions, Block);
+    std::vector<Dims> blockStarts;
+    Dims position(dimensions, 0);
+    while (true)
+    {
+        Dims start(dimensions);
+        for (size_t d = 0; d < dimensions; ++d)
+        {
+            start[d] = position[d] * Block;
+        }
+        blockStarts.push_back(start);
+
+        size_t d = dimensions;
+        while (d > 0 && ++position[d - 1] == blocksPerSide)
+        {
+            position[--d] = 0;
+        }
+        if (d == 0)
+        {
+            break;
+        }
+    }
+
+    std::vector<T> in(blockElements, 1);
+    std::vector<T> out(Product(outCount));
+    const char *inData = reinterpret_cast<const char *>(in.data());
+    char *outData = reinterpret_cast<char *>(out.data());
+    const size_t bytes = out.size() * sizeof(T);
+
+    const double ndCopy = Throughput(bytes, [&]() {
+        for (const Dims &start : blockStarts)
+        {
+            adios2::helper::NdCopy<T>(inData, start, blockCount, true, true,
+                                      outData, outStart, outCount, true, true);
+        }
+    });
+
+    // plans cached across "steps", as with locked selections
+    adios2::helper::NdCopyPlanCache cache;
+    const double planned = Throughput(bytes, [&]() {
+        cache.Rewind();
+        for (const Dims &start : blockStarts)
+        {
+            cache
+                .Get(start, blockCount, true, true, outStart, outCount, true,
+                     true, sizeof(T))
+                .Execute(inData, outData);
+        }
+    });
+
+    const double swap = Throughput(bytes, [&]() {
+        for (const Dims &start : blockStarts)
+        {
+            adios2::helper::NdCopy<T>(inData, start, blockCount, true, true,
+                                      outData, outStart, outCount, true,
+                                      false);
+        }
+    });
+
+    const double columnMajor = Throughput(bytes, [&]() {
+        for (const Dims &start : blockStarts)
+        {
+            adios2::helper::NdCopy<T>(inData, start, blockCount, true, true,
+                                      outData, outStart, outCount, false,
+                                      true);
+        }
+    });
+
+    // blocks of a merged read, as in BP4Reader::PerformBlockReads
+    const double threaded = Throughput(bytes, [&]() {
+        adios2::helper::ParallelFor(
+            blockStarts.size(), Threads,
+            [&](const size_t, const size_t begin, const size_t end) {
+                for (size_t b = begin; b < end; ++b)
+                {
+                    adios2::helper::NdCopy<T>(inData, blockStarts[b],
+                                              blockCount, true, true, outData,
+                                              outStart, outCount, true, true);
+                }
+            });
+    });
+
+    Print("blocks", dimensions, ndCopy, planned, swap, columnMajor, threaded);
+}
+
+int main(int argc, char **argv)
+{
+    ParseArgs(argc, argv);
+    auto pool = adios2::helper::ThreadPool::Acquire(Threads);
+
+    std::cout << "Best of " << Repeat << " calls on " << SizeMB
+              << " MB of float, blocks of " << Block
+              << " per dimension, " << Threads << " threads, in GB/s"
+              << std::endl;
+    std::cout << std::setw(8) << "copy" << std::setw(6) << "dims"
+              << std::setw(12) << "ndcopy" << std::setw(12) << "plan"
+              << std::setw(12) << "swap" << std::setw(12) << "col-major"
+              << std::setw(12) << "threads" << std::endl;
+
+    for (size_t dimensions = 1; dimensions <= 5; ++dimensions)
+    {
+        MeasureClip(dimensions);
+    }
+    for (size_t dimensions = 1; dimensions <= 5; ++dimensions)
+    {
+        MeasureBlocks(dimensions);
+    }
+
+    return 0;
+}